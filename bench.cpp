@@ -0,0 +1,1064 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "dbcs_width.h"
+#include "render_width.h"
+#include "redraw_diff.h"
+#include "cell_grid.h"
+#include "column_format.h"
+#include "column_index.h"
+#include "calibration.h"
+#include "wcswidth_cache.h"
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+
+//------------------------------------------------------------------------------
+// Measures elapsed time with the performance counter.
+class bench_timer
+{
+public:
+                    bench_timer() { QueryPerformanceFrequency(&m_freq); restart(); }
+    void            restart() { QueryPerformanceCounter(&m_began); }
+    double          seconds() const;
+private:
+    LARGE_INTEGER   m_freq;
+    LARGE_INTEGER   m_began;
+};
+
+//------------------------------------------------------------------------------
+double bench_timer::seconds() const
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return double(now.QuadPart - m_began.QuadPart) / double(m_freq.QuadPart);
+}
+
+//------------------------------------------------------------------------------
+static double megabytes_per_second(uint64 bytes, double seconds)
+{
+    return (seconds > 0) ? double(bytes) / (1024 * 1024) / seconds : 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Generates lines of text in a DBCS code page:  mostly valid double byte
+// characters, mixed with runs of ASCII text.
+static void make_dbcs_lines(UINT cp, uint32 total_len, std::vector<std::string>& lines)
+{
+    std::vector<uint16> pairs;
+    for (uint32 lead = 0x81; lead < 0x100; ++lead)
+    {
+        if (!IsDBCSLeadByteEx(cp, BYTE(lead)))
+            continue;
+        for (uint32 trail = 0x40; trail < 0x100; ++trail)
+        {
+            const char bytes[2] = { char(lead), char(trail) };
+            WCHAR wide[2];
+            if (MultiByteToWideChar(cp, MB_ERR_INVALID_CHARS, bytes, 2, wide, _countof(wide)) == 1)
+                pairs.push_back(uint16((lead << 8) | trail));
+        }
+    }
+
+    std::mt19937 rand(cp);
+    lines.clear();
+    uint32 len = 0;
+    while (len < total_len)
+    {
+        std::string line;
+        const uint32 line_len = 40 + rand() % 80;
+        while (line.length() < line_len)
+        {
+            if (pairs.empty() || rand() % 10 < 3)
+            {
+                const uint32 run = 1 + rand() % 8;
+                for (uint32 i = 0; i < run; ++i)
+                    line.push_back(char(0x20 + rand() % 0x5f));
+            }
+            else
+            {
+                const uint16 pair = pairs[rand() % pairs.size()];
+                line.push_back(char(pair >> 8));
+                line.push_back(char(pair & 0xff));
+            }
+        }
+        len += uint32(line.length());
+        lines.push_back(std::move(line));
+    }
+}
+
+//------------------------------------------------------------------------------
+static uint32 bench_dbcs(FILE* out)
+{
+    static const UINT c_codepages[] = { 932, 936, 949, 950 };
+    static const uint32 c_text_len = 4 * 1024 * 1024;
+
+    fprintf(out, "Direct DBCS width tables vs. convert-then-measure, %u MB of text per code page.\n\n", c_text_len / (1024 * 1024));
+    fprintf(out, "  %-6s %10s %12s %13s %9s %11s\n", "cp", "tables", "direct MB/s", "convert MB/s", "speedup", "mismatches");
+
+    uint32 total_mismatches = 0;
+    for (UINT cp : c_codepages)
+    {
+        std::vector<std::string> lines;
+        make_dbcs_lines(cp, c_text_len, lines);
+
+        uint64 bytes = 0;
+        for (const auto& line : lines)
+            bytes += line.length();
+
+        // The first call generates the tables.
+        bench_timer timer;
+        dbcs_wcswidth(cp, "", 0);
+        const double table_seconds = timer.seconds();
+
+        std::vector<uint32> direct(lines.size());
+        timer.restart();
+        for (size_t i = 0; i < lines.size(); ++i)
+            direct[i] = dbcs_wcswidth(cp, lines[i].c_str(), uint32(lines[i].length()));
+        const double direct_seconds = timer.seconds();
+
+        uint32 mismatches = 0;
+        timer.restart();
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            if (converted_wcswidth(cp, lines[i].c_str(), uint32(lines[i].length())) != direct[i])
+                ++mismatches;
+        }
+        const double convert_seconds = timer.seconds();
+
+        const double direct_rate = megabytes_per_second(bytes, direct_seconds);
+        const double convert_rate = megabytes_per_second(bytes, convert_seconds);
+        fprintf(out, "  %-6u %8.1fms %12.1f %13.1f %8.1fx %11u\n",
+                cp, table_seconds * 1000, direct_rate, convert_rate,
+                convert_rate > 0 ? direct_rate / convert_rate : 0, mismatches);
+        total_mismatches += mismatches;
+    }
+    return total_mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// The kind of loop that callers wrote before render_width() existed.
+static uint32 iter_render_width(const char* s, uint32 len, uint32 tab_width)
+{
+    uint32 column = 0;
+    wcwidth_iter iter(s, len);
+    while (const char32_t c = iter.next())
+    {
+        const int32 w = iter.character_wcwidth_signed();
+        if (w >= 0)
+            column += w;
+        else if (c == '\t')
+            column += tab_width - (column % tab_width);
+        else
+            column += 2;
+    }
+    return column;
+}
+
+//------------------------------------------------------------------------------
+static uint32 bench_render(FILE* out)
+{
+    static const char* const c_pieces[] =
+    {
+        "\t", "    ", "int32 ", "column", " = ", "iter.next();", "// comment ",
+        "caf\xc3\xa9 ", "\xe4\xb8\x80\xe4\xba\x8c ", "\xf0\x9f\x98\x80", "\x1b",
+    };
+    static const uint32 c_text_len = 16 * 1024 * 1024;
+
+    std::mt19937 rand(36);
+    std::vector<std::string> lines;
+    uint64 bytes = 0;
+    while (bytes < c_text_len)
+    {
+        std::string line;
+        const uint32 count = 4 + rand() % 16;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            // Mostly ASCII, like source code or log output.
+            const uint32 r = rand() % 32;
+            line += c_pieces[(r < 7) ? r : (r < 30) ? 2 + r % 5 : 7 + r % 4];
+        }
+        bytes += line.length();
+        lines.push_back(std::move(line));
+    }
+
+    render_options options;
+    options.tab_width = 8;
+    options.controls = render_control::caret;
+
+    bench_timer timer;
+    std::vector<uint32> widths(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+        widths[i] = render_width(lines[i].c_str(), uint32(lines[i].length()), options);
+    const double render_seconds = timer.seconds();
+
+    uint32 mismatches = 0;
+    timer.restart();
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        if (iter_render_width(lines[i].c_str(), uint32(lines[i].length()), options.tab_width) != widths[i])
+            ++mismatches;
+    }
+    const double iter_seconds = timer.seconds();
+
+    const double render_rate = megabytes_per_second(bytes, render_seconds);
+    const double iter_rate = megabytes_per_second(bytes, iter_seconds);
+    fprintf(out, "render_width() vs. a wcwidth_iter loop, %u MB of mostly ASCII lines with tabs.\n\n", c_text_len / (1024 * 1024));
+    fprintf(out, "  %-16s %10.1f MB/s\n", "render_width()", render_rate);
+    fprintf(out, "  %-16s %10.1f MB/s\n", "wcwidth_iter", iter_rate);
+    fprintf(out, "  %-16s %10.1fx\n", "speedup", iter_rate > 0 ? render_rate / iter_rate : 0);
+    fprintf(out, "  %-16s %10u\n", "mismatches", mismatches);
+    return mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Simulates typing and editing in the middle of an edit line, and compares
+// how many bytes are rewritten by repainting only the redraw span versus
+// repainting from the first differing byte to the end of the line.
+static uint32 bench_redraw(FILE* out)
+{
+    static const char* const c_pieces[] =
+    {
+        "a", "e", "s", " ", "\xc3\xa9", "\xe4\xb8\x80", "\xf0\x9f\x98\x80", "\xf0\x9f\x91\x8d\xf0\x9f\x8f\xbd",
+    };
+    static const uint32 c_edits = 200000;
+
+    std::mt19937 rand(37);
+    std::vector<uint32> line;
+    for (uint32 i = 0; i < 100; ++i)
+        line.push_back(rand() % _countof(c_pieces));
+
+    std::string old_text, new_text;
+    uint64 span_bytes = 0;
+    uint64 rest_bytes = 0;
+    double seconds = 0;
+    for (uint32 i = 0; i < c_edits; ++i)
+    {
+        old_text.clear();
+        for (uint32 p : line)
+            old_text += c_pieces[p];
+
+        // Replace, insert, or delete a character somewhere in the line.
+        const uint32 pos = rand() % uint32(line.size());
+        switch (rand() % 3)
+        {
+        case 0:     line[pos] = rand() % _countof(c_pieces); break;
+        case 1:     if (line.size() < 120) line.insert(line.begin() + pos, rand() % _countof(c_pieces)); break;
+        default:    if (line.size() > 80) line.erase(line.begin() + pos); break;
+        }
+
+        new_text.clear();
+        for (uint32 p : line)
+            new_text += c_pieces[p];
+
+        redraw_span span;
+        bench_timer timer;
+        const bool changed = find_redraw_span(old_text.c_str(), uint32(old_text.length()), new_text.c_str(), uint32(new_text.length()), span);
+        seconds += timer.seconds();
+        if (!changed)
+            continue;
+
+        uint32 first = 0;
+        while (first < old_text.length() && first < new_text.length() && old_text[first] == new_text[first])
+            ++first;
+
+        span_bytes += span.new_end - span.new_begin;
+        rest_bytes += new_text.length() - first;
+    }
+
+    fprintf(out, "find_redraw_span() on %u random edits to a line of about 100 characters.\n\n", c_edits);
+    fprintf(out, "  %-28s %10.0f ns\n", "time per call", seconds * 1e9 / c_edits);
+    fprintf(out, "  %-28s %10.1f\n", "bytes per redraw span", double(span_bytes) / c_edits);
+    fprintf(out, "  %-28s %10.1f\n", "bytes from first difference", double(rest_bytes) / c_edits);
+    return 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Writes lines of text into a 120x30 grid in batches, and generates the
+// update stream after each batch.
+static uint32 bench_grid(FILE* out)
+{
+    static const char* const c_ascii_pieces[] =
+    {
+        "int32 ", "column", " = ", "iter.next();", "    ", "// comment ", "0x1f600",
+    };
+    static const char* const c_mixed_pieces[] =
+    {
+        "int32 ", "column", " = ", "\xe4\xb8\x80\xe4\xba\x8c ", "caf\xc3\xa9 ", "\xf0\x9f\x98\x80",
+        "\xf0\x9f\x91\x8d\xf0\x9f\x8f\xbd", "e\xcc\x81", "\t",
+    };
+    static const uint32 c_text_len = 16 * 1024 * 1024;
+    static const uint32 c_lines_per_batch = 100;
+
+    fprintf(out, "cell_grid writes into a 120x30 grid, %u MB of text in batches of %u lines.\n\n", c_text_len / (1024 * 1024), c_lines_per_batch);
+    fprintf(out, "  %-8s %12s %14s %14s %16s\n", "text", "write MB/s", "Mcells/s", "update MB/s", "update bytes");
+
+    for (uint32 mixed = 0; mixed < 2; ++mixed)
+    {
+        const char* const* const pieces = mixed ? c_mixed_pieces : c_ascii_pieces;
+        const uint32 num_pieces = mixed ? _countof(c_mixed_pieces) : _countof(c_ascii_pieces);
+
+        std::mt19937 rand(38);
+        std::vector<std::string> lines;
+        uint64 bytes = 0;
+        while (bytes < c_text_len)
+        {
+            std::string line;
+            const uint32 count = 4 + rand() % 12;
+            for (uint32 i = 0; i < count; ++i)
+                line += pieces[rand() % num_pieces];
+            line += '\n';
+            bytes += line.length();
+            lines.push_back(std::move(line));
+        }
+
+        cell_grid grid(120, 30);
+        std::string updates;
+        uint64 cells = 0;
+        uint64 update_bytes = 0;
+        double write_seconds = 0;
+        double update_seconds = 0;
+        bench_timer timer;
+        for (size_t i = 0; i < lines.size(); i += c_lines_per_batch)
+        {
+            timer.restart();
+            const size_t batch_end = min(i + c_lines_per_batch, lines.size());
+            for (size_t j = i; j < batch_end; ++j)
+                grid.write(lines[j].c_str(), uint32(lines[j].length()));
+            write_seconds += timer.seconds();
+
+            timer.restart();
+            updates.clear();
+            grid.get_updates(updates);
+            update_seconds += timer.seconds();
+            update_bytes += updates.length();
+        }
+
+        // Count the cells written, for a rate that doesn't depend on how
+        // many bytes each cell's text takes.
+        for (const auto& line : lines)
+            cells += wcswidth(line.c_str(), uint32(line.length() - 1));
+
+        fprintf(out, "  %-8s %12.1f %14.1f %14.1f %16llu\n", mixed ? "mixed" : "ascii",
+                megabytes_per_second(bytes, write_seconds),
+                write_seconds > 0 ? double(cells) / 1e6 / write_seconds : 0,
+                megabytes_per_second(update_bytes, update_seconds),
+                (unsigned long long)update_bytes);
+    }
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// The usual way to pad a string to a number of columns:  format it, measure
+// it, and append spaces.
+static uint32 manual_pad_row(char* buffer, uint32 size, const char* name, uint32 value, const char* desc)
+{
+    std::string row;
+    char tmp[64];
+
+    sprintf(tmp, "%s", name);
+    row += tmp;
+    row.append(max<int32>(0, 16 - int32(wcswidth(tmp, uint32(strlen(tmp))))), ' ');
+    sprintf(tmp, " %6u ", value);
+    row += tmp;
+    row += desc;
+
+    const uint32 len = min<uint32>(uint32(row.length()), size - 1);
+    memcpy(buffer, row.c_str(), len);
+    buffer[len] = '\0';
+    return uint32(row.length());
+}
+
+//------------------------------------------------------------------------------
+static uint32 bench_format(FILE* out)
+{
+    static const char* const c_names[] =
+    {
+        "name", "column", "caf\xc3\xa9", "\xe4\xb8\x80\xe4\xba\x8c\xe4\xb8\x89",
+        "\xf0\x9f\x98\x80 smile", "x\xcc\x81y", "\xf0\x9f\x91\x8d\xf0\x9f\x8f\xbd ok",
+        "\xef\xbd\xb1\xef\xbd\xb2\xef\xbd\xb3",
+    };
+    static const char c_desc[] = "description";
+    static const uint32 c_rows = 1000000;
+
+    std::mt19937 rand(45);
+    std::vector<uint32> picks(c_rows);
+    for (auto& pick : picks)
+        pick = rand();
+
+    char buffer[128];
+    uint64 format_bytes = 0;
+    bench_timer timer;
+    for (uint32 i = 0; i < c_rows; ++i)
+    {
+        const char* name = c_names[picks[i] % _countof(c_names)];
+        format_bytes += column_snprintf(buffer, sizeof(buffer), "%-16s %6u %s", name, picks[i] % 1000000, c_desc);
+    }
+    const double format_seconds = timer.seconds();
+
+    uint64 manual_bytes = 0;
+    timer.restart();
+    for (uint32 i = 0; i < c_rows; ++i)
+    {
+        const char* name = c_names[picks[i] % _countof(c_names)];
+        manual_bytes += manual_pad_row(buffer, sizeof(buffer), name, picks[i] % 1000000, c_desc);
+    }
+    const double manual_seconds = timer.seconds();
+
+    uint32 mismatches = 0;
+    char expected[128];
+    for (uint32 i = 0; i < _countof(c_names); ++i)
+    {
+        manual_pad_row(expected, sizeof(expected), c_names[i], i, c_desc);
+        column_snprintf(buffer, sizeof(buffer), "%-16s %6u %s", c_names[i], i, c_desc);
+        mismatches += (strcmp(buffer, expected) != 0);
+    }
+    mismatches += (format_bytes != manual_bytes);
+
+    const double format_rate = format_seconds > 0 ? c_rows / 1e6 / format_seconds : 0;
+    const double manual_rate = manual_seconds > 0 ? c_rows / 1e6 / manual_seconds : 0;
+    fprintf(out, "column_snprintf() vs. formatting, measuring, and appending padding, %u rows.\n\n", c_rows);
+    fprintf(out, "  %-18s %10.2f M rows/s\n", "column_snprintf()", format_rate);
+    fprintf(out, "  %-18s %10.2f M rows/s\n", "manual padding", manual_rate);
+    fprintf(out, "  %-18s %10.1fx\n", "speedup", manual_rate > 0 ? format_rate / manual_rate : 0);
+    fprintf(out, "  %-18s %10u\n", "mismatches", mismatches);
+    return mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Measures prompt-style segments over and over, the way a prompt that's
+// redrawn many times per second would, with plain wcswidth() and through a
+// shared cache and the per-thread cache.  Then activates a profile with
+// different emoji rules, and checks that no cached width survives it.
+static uint32 bench_cache(FILE* out)
+{
+    static const char* const c_segments[] =
+    {
+        "C:\\Users\\chris\\repos\\wcwidth-verifier", " master ", "\xee\x82\xa0 main",
+        "\xe2\x9c\x94 ", "\xe2\x9c\x98 3", "+2 ~1 -0", "12:34:56", "\xce\xbb ", "\xe2\x9d\xaf ",
+        "\xf0\x9f\x90\x8d 3.12", "\xf0\x9f\x93\x81 src", "\xe2\x9d\xa4\xef\xb8\x8f ",
+        "\xe2\x8f\xb1\xef\xb8\x8f 1.2s", "\xf0\x9f\x87\xaf\xf0\x9f\x87\xb5", "\xe4\xb8\xad\xe6\x96\x87",
+        "caf\xc3\xa9", "x\xcc\x81", "[venv]",
+        "C:\\Program Files\\Microsoft Visual Studio\\2022\\Community\\VC\\Tools\\MSVC\\"
+        "14.38.33130\\bin\\Hostx64\\x64\\cl.exe /nologo /W4 /O2 /std:c++20",
+    };
+    static const uint32 c_measures = 4000000;
+
+    std::mt19937 rand(31);
+    std::vector<uint32> picks(c_measures);
+    for (auto& pick : picks)
+        pick = rand() % _countof(c_segments);
+
+    uint32 lens[_countof(c_segments)];
+    uint32 widths[_countof(c_segments)];
+    for (uint32 i = 0; i < _countof(c_segments); ++i)
+    {
+        lens[i] = uint32(strlen(c_segments[i]));
+        widths[i] = wcswidth(c_segments[i], lens[i]);
+    }
+
+    uint32 mismatches = 0;
+    bench_timer timer;
+    for (uint32 pick : picks)
+        mismatches += (wcswidth(c_segments[pick], lens[pick]) != widths[pick]);
+    const double plain_seconds = timer.seconds();
+
+    wcswidth_cache shared;
+    timer.restart();
+    for (uint32 pick : picks)
+        mismatches += (shared.wcswidth(c_segments[pick], lens[pick]) != widths[pick]);
+    const double shared_seconds = timer.seconds();
+
+    wcswidth_cache& thread = get_thread_wcswidth_cache();
+    thread.clear();
+    timer.restart();
+    for (uint32 pick : picks)
+        mismatches += (cached_wcswidth(c_segments[pick], lens[pick]) != widths[pick]);
+    const double thread_seconds = timer.seconds();
+
+    const wcswidth_cache_stats shared_stats = shared.stats();
+    const wcswidth_cache_stats thread_stats = thread.stats();
+
+    // Activating another profile bumps the wcwidth generation, so every
+    // lookup afterwards must be a miss (or bypass the cache).
+    const wcwidth_profile* const original = get_wcwidth_profile();
+    wcwidth_profile other;
+    get_builtin_wcwidth_profile(other, !original->color_emoji, false, false);
+    activate_wcwidth_profile(&other);
+    uint32 changed = 0;
+    for (uint32 i = 0; i < _countof(c_segments); ++i)
+    {
+        const uint32 expected = wcswidth(c_segments[i], lens[i]);
+        changed += (expected != widths[i]);
+        mismatches += (shared.wcswidth(c_segments[i], lens[i]) != expected);
+        mismatches += (cached_wcswidth(c_segments[i], lens[i]) != expected);
+    }
+    activate_wcwidth_profile(original);
+    mismatches += (shared.stats().hits != shared_stats.hits);
+    mismatches += (thread.stats().hits != thread_stats.hits);
+
+    const auto print_stats = [out](const char* name, const wcswidth_cache_stats& stats)
+    {
+        const uint64 lookups = stats.hits + stats.misses + stats.bypassed;
+        fprintf(out, "  %-18s %10llu hits, %llu misses, %llu bypassed (%.2f%% hits)\n", name,
+                (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.bypassed,
+                lookups ? stats.hits * 100.0 / lookups : 0);
+    };
+
+    const double plain_rate = plain_seconds > 0 ? c_measures / 1e6 / plain_seconds : 0;
+    const double shared_rate = shared_seconds > 0 ? c_measures / 1e6 / shared_seconds : 0;
+    const double thread_rate = thread_seconds > 0 ? c_measures / 1e6 / thread_seconds : 0;
+    fprintf(out, "wcswidth_cache vs. wcswidth(), %u measurements of %u prompt segments.\n\n", c_measures, uint32(_countof(c_segments)));
+    fprintf(out, "  %-18s %10.2f M calls/s\n", "wcswidth()", plain_rate);
+    fprintf(out, "  %-18s %10.2f M calls/s\n", "shared cache", shared_rate);
+    fprintf(out, "  %-18s %10.2f M calls/s\n", "thread cache", thread_rate);
+    fprintf(out, "  %-18s %10.1fx\n", "speedup", plain_rate > 0 ? thread_rate / plain_rate : 0);
+    print_stats("shared cache", shared_stats);
+    print_stats("thread cache", thread_stats);
+    fprintf(out, "  %-18s %10u\n", "changed by swap", changed);
+    fprintf(out, "  %-18s %10u\n", "mismatches", mismatches);
+    return mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Generates random text that's hard to split:  combining marks, variant
+// selectors, ZWJ, regional indicators, emoji, controls, and sometimes long runs
+// with no safe cluster boundary, stray bytes, or (if allow_nul) a byte that
+// decodes as NUL.
+static void make_cluster_text(std::mt19937& rand, uint32 len, bool allow_nul, std::string& text)
+{
+    static const char32_t c_pool[] =
+    {
+        'a', ' ', '\n', '\t', 0x7f, 0x85, 0xa9, 0x300, 0x301, 0x1160, 0x200b, 0x200d,
+        0x20e3, 0x263a, 0x2640, 0x2642, 0x2764, 0x3030, 0x4e00, 0xac00, 0xfe0e, 0xfe0f,
+        0x1f1e6, 0x1f1fa, 0x1f3f4, 0x1f3fb, 0x1f468, 0x1f469, 0x1f600, 0xe0020,
+    };
+    static const char32_t c_joiners[] = { 0x200b, 0x200d, 0xfe0f, 0x1f1e6, 0x1f3fb, 0x1f468 };
+
+    const uint32 kind = rand() % (allow_nul ? 4 : 3);
+    text.clear();
+    while (text.length() < len)
+    {
+        char utf8[8];
+        if (kind == 1 && rand() % 100 < 98)
+            text.append(utf8, to_utf8(c_joiners[rand() % _countof(c_joiners)], utf8));
+        else if (kind == 2 && rand() % 50 == 0)
+        {
+            // A stray lead byte can decode as NUL along with what follows.
+            text.push_back(char(0x81 + rand() % (allow_nul ? 0x7f : 0x3f)));
+        }
+        else
+            text.append(utf8, to_utf8(c_pool[rand() % _countof(c_pool)], utf8));
+    }
+    if (kind == 3)
+        text[rand() % text.length()] = char(0x80);
+}
+
+//------------------------------------------------------------------------------
+// Checks that splitting a string into chunks never changes its width, over
+// random text, chunk counts, and built-in profiles.  Then compares the speed
+// of wcswidth_parallel() and wcswidth() on a large string.
+static uint32 bench_parallel(FILE* out)
+{
+    static const uint32 c_cases = 2000;
+    static const uint32 c_large_len = 64 * 1024 * 1024;
+
+    wcwidth_profile profiles[8];
+    for (uint32 i = 0; i < _countof(profiles); ++i)
+        get_builtin_wcwidth_profile(profiles[i], !!(i & 4), !!(i & 2), !!(i & 1));
+
+    std::mt19937 rand(32);
+    std::string text;
+    uint32 mismatches = 0;
+    for (uint32 i = 0; i < c_cases; ++i)
+    {
+        const wcwidth_profile& profile = profiles[i % _countof(profiles)];
+        make_cluster_text(rand, 1 + rand() % 32768, true, text);
+        const uint32 len = uint32(text.length());
+        const uint32 expected = wcswidth(text.c_str(), len, &profile);
+        if (wcswidth_chunked(text.c_str(), len, 2 + rand() % 64, &profile) != expected)
+            ++mismatches;
+    }
+
+    std::string large;
+    large.reserve(c_large_len + 64);
+    while (large.length() < c_large_len)
+    {
+        make_cluster_text(rand, 4096, false, text);
+        large += text;
+    }
+
+    bench_timer timer;
+    const uint32 sequential = wcswidth(large.c_str(), uint32(large.length()));
+    const double sequential_seconds = timer.seconds();
+    timer.restart();
+    const uint32 parallel = wcswidth_parallel(large.c_str(), uint32(large.length()));
+    const double parallel_seconds = timer.seconds();
+    mismatches += (parallel != sequential);
+
+    const double sequential_rate = megabytes_per_second(large.length(), sequential_seconds);
+    const double parallel_rate = megabytes_per_second(large.length(), parallel_seconds);
+    fprintf(out, "wcswidth_chunked() vs. wcswidth() over %u random strings, then wcswidth_parallel()\n", c_cases);
+    fprintf(out, "vs. wcswidth() on %u MB, with %u threads.\n\n", c_large_len / (1024 * 1024), max<uint32>(std::thread::hardware_concurrency(), 1));
+    fprintf(out, "  %-18s %10.1f MB/s\n", "parallel", parallel_rate);
+    fprintf(out, "  %-18s %10.1f MB/s\n", "sequential", sequential_rate);
+    fprintf(out, "  %-18s %10.1fx\n", "speedup", sequential_rate > 0 ? parallel_rate / sequential_rate : 0);
+    fprintf(out, "  %-18s %10u\n", "mismatches", mismatches);
+    return mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Copies a built-in profile into a two-stage table like a loaded profile's,
+// except that regional indicators are also flagged as emoji, which a profile
+// measured from a terminal can do.
+static void make_table_profile(const wcwidth_profile& builtin, std::vector<uint16>& stage1, std::vector<uint16>& stage2, wcwidth_profile& profile)
+{
+    stage1.resize(0x110000 >> 8);
+    stage2.resize(0x110000);
+    for (uint32 ucs = 0; ucs < 0x110000; ++ucs)
+    {
+        const int32 w1 = builtin.width(ucs, 1);
+        uint32 e = (builtin.width(ucs, 0) != w1) ? wcwp_combining : (w1 < 0) ? 3 : min<int32>(w1, 2);
+        e |= builtin.flags(ucs, wcwp_all_flags & ~wcwp_combining);
+        if (e & wcwp_regional_indicator)
+            e |= wcwp_emoji;
+        stage2[ucs] = uint16(e);
+    }
+    for (uint32 i = 0; i < stage1.size(); ++i)
+        stage1[i] = uint16(i);
+
+    profile = builtin;
+    strcpy(profile.name, "table+ri");
+    profile.stage1 = stage1.data();
+    profile.stage2 = stage2.data();
+}
+
+//------------------------------------------------------------------------------
+// Checks wcwidth_iter::prev() against a forward scan over random text, in each
+// built-in profile and a table profile:  stepping back from the end, and
+// stepping back once from every byte offset, must find the same clusters and
+// widths as next().  Also checks that is_safe_cluster_boundary() only reports
+// where a cluster begins.
+static uint32 bench_prev(FILE* out)
+{
+    // Half of the strings only use these, so that sequences of joiners,
+    // variant selectors, and regional indicators after various bases are
+    // common.
+    static const char32_t c_dense[] =
+    {
+        'a', ' ', 0x300, 0x200d, 0x2764, 0x4e00, 0xfe0f, 0x1f1e6, 0x1f1fa, 0x1f3fb, 0x1f468,
+    };
+    static const uint32 c_cases = 4000;
+
+    struct cluster
+    {
+        const char* ptr;
+        uint32      len;
+        int32       width;
+        char32_t    c;
+    };
+
+    const auto same = [](const wcwidth_iter& iter, char32_t c, const cluster& expected)
+    {
+        return (c == expected.c && iter.character_pointer() == expected.ptr &&
+                iter.character_length() == expected.len &&
+                iter.character_wcwidth_signed() == expected.width);
+    };
+
+    wcwidth_profile profiles[9];
+    for (uint32 i = 0; i < 8; ++i)
+        get_builtin_wcwidth_profile(profiles[i], !!(i & 4), !!(i & 2), !!(i & 1));
+    std::vector<uint16> stage1;
+    std::vector<uint16> stage2;
+    make_table_profile(profiles[4], stage1, stage2, profiles[8]);
+
+    std::mt19937 rand(33);
+    std::string text;
+    std::vector<cluster> clusters;
+    std::vector<bool> starts;
+    uint64 checks = 0;
+    uint32 mismatches = 0;
+    double seconds = 0;
+    for (uint32 i = 0; i < c_cases; ++i)
+    {
+        const wcwidth_profile& profile = profiles[i % _countof(profiles)];
+        if (i & 1)
+        {
+            make_cluster_text(rand, 1 + rand() % 512, false, text);
+        }
+        else
+        {
+            const uint32 target = 1 + rand() % 512;
+            text.clear();
+            while (text.length() < target)
+            {
+                char utf8[8];
+                text.append(utf8, to_utf8(c_dense[rand() % _countof(c_dense)], utf8));
+            }
+        }
+        const char* const s = text.c_str();
+        const uint32 len = uint32(text.length());
+
+        clusters.clear();
+        starts.assign(len + 1, false);
+        wcwidth_iter iter(s, len, &profile);
+        while (const char32_t c = iter.next())
+        {
+            clusters.push_back({ iter.character_pointer(), iter.character_length(), iter.character_wcwidth_signed(), c });
+            starts[iter.character_pointer() - s] = true;
+        }
+
+        bench_timer timer;
+        wcwidth_iter back(s, len, &profile);
+        back.reset_pointer(s + len);
+        for (size_t k = clusters.size(); k--;)
+        {
+            const char32_t c = back.prev();
+            ++checks;
+            if (!same(back, c, clusters[k]))
+            {
+                ++mismatches;
+                break;
+            }
+        }
+        mismatches += (back.prev() != 0);
+
+        size_t before = 0;
+        for (uint32 offset = 0; offset <= len; ++offset)
+        {
+            while (before < clusters.size() && clusters[before].ptr < s + offset)
+                ++before;
+
+            wcwidth_iter at(s, len, &profile);
+            at.reset_pointer(s + offset);
+            const char32_t c = at.prev();
+            ++checks;
+            if (before ? !same(at, c, clusters[before - 1]) : c != 0)
+                ++mismatches;
+        }
+        seconds += timer.seconds();
+
+        for (uint32 offset = 0; offset < len; ++offset)
+        {
+            if (!starts[offset] && is_safe_cluster_boundary(s, s + offset, s + len, profile))
+                ++mismatches;
+        }
+    }
+
+    fprintf(out, "wcwidth_iter::prev() vs. next() over %u random strings, in each built-in profile and a table profile.\n\n", c_cases);
+    fprintf(out, "  %-18s %10llu\n", "prev() checks", (unsigned long long)checks);
+    fprintf(out, "  %-18s %10.0f ns\n", "time per prev()", checks ? seconds * 1e9 / checks : 0);
+    fprintf(out, "  %-18s %10u\n", "mismatches", mismatches);
+    return mismatches;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Swaps the active profile as fast as possible while reader threads measure
+// text with whichever profile is active.  Each swap also unloads the profile
+// it replaced, so a profile that's freed while a reader still uses it shows up
+// as a mismatch (or a crash).
+static uint32 bench_profiles(FILE* out)
+{
+    static const char c_text[] =
+        "caf\xc3\xa9 \xe2\x9d\xa4\xef\xb8\x8f \xf0\x9f\x87\xaf\xf0\x9f\x87\xb5 "
+        "\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x92\xbb \xe4\xb8\x80\xe4\xba\x8c";
+    static const uint32 c_swaps = 10000;
+
+    // One profile with color emoji and one without, so that readers can tell
+    // which one they got from the width.
+    char paths[2][MAX_PATH];
+    uint32 expected[2];
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        wcwidth_profile builtin;
+        get_builtin_wcwidth_profile(builtin, !!i, false, false);
+        if (!get_cache_path(i ? "wcwv-bench-color.wcwp" : "wcwv-bench-mono.wcwp", paths[i], sizeof(paths[i])) ||
+            !save_wcwidth_profile(paths[i], &builtin))
+        {
+            fprintf(out, "Unable to write the test profiles.\n");
+            return 1;
+        }
+        expected[i] = wcswidth(c_text, sizeof(c_text) - 1, &builtin);
+    }
+
+    const wcwidth_profile* active = load_wcwidth_profile(paths[0]);
+    if (!active)
+    {
+        fprintf(out, "Unable to load the test profiles.\n");
+        return 1;
+    }
+    activate_wcwidth_profile(active);
+
+    std::atomic<bool> stop = false;
+    std::atomic<uint64> reads = 0;
+    std::atomic<uint32> mismatches = 0;
+    const uint32 reader_count = max<uint32>(4, std::thread::hardware_concurrency());
+    std::vector<std::thread> readers;
+    for (uint32 i = 0; i < reader_count; ++i)
+    {
+        readers.emplace_back([&]() {
+            uint64 count = 0;
+            uint32 bad = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                wcwidth_reader_scope reader;
+                const wcwidth_profile* profile = get_wcwidth_profile();
+                if (wcswidth(c_text, sizeof(c_text) - 1, profile) != expected[profile->color_emoji])
+                    ++bad;
+                ++count;
+            }
+            reads += count;
+            mismatches += bad;
+        });
+    }
+
+    uint32 load_failures = 0;
+    bench_timer timer;
+    for (uint32 i = 1; i <= c_swaps; ++i)
+    {
+        const wcwidth_profile* next = load_wcwidth_profile(paths[i & 1]);
+        if (!next)
+        {
+            ++load_failures;
+            continue;
+        }
+        activate_wcwidth_profile(next);
+        unload_wcwidth_profile(active);
+        active = next;
+    }
+    const double seconds = timer.seconds();
+
+    stop = true;
+    for (auto& reader : readers)
+        reader.join();
+    unload_wcwidth_profile(active);
+    const uint32 retired = reclaim_wcwidth_profiles();
+    remove(paths[0]);
+    remove(paths[1]);
+
+    fprintf(out, "Swapping the active profile while %u threads measure with it, %u swaps.\n\n", reader_count, c_swaps);
+    fprintf(out, "  %-18s %10.1f K swaps/s\n", "swaps", seconds > 0 ? c_swaps / 1e3 / seconds : 0);
+    fprintf(out, "  %-18s %10.2f M reads/s\n", "reads", seconds > 0 ? reads / 1e6 / seconds : 0);
+    fprintf(out, "  %-18s %10u\n", "load failures", load_failures);
+    fprintf(out, "  %-18s %10u\n", "still retired", retired);
+    fprintf(out, "  %-18s %10u\n", "mismatches", uint32(mismatches));
+    return mismatches + load_failures;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Builds a column_index over random text that's appended in random pieces
+// (which split UTF-8 sequences and clusters), and checks its queries against
+// a single linear scan.  Then checks that a saved index loads, and that it's
+// rejected for a profile that differs only in the OS version.
+static uint32 bench_columns(FILE* out)
+{
+    static const uint32 c_text_len = 8 * 1024 * 1024;
+    static const uint32 c_queries = 200000;
+
+    wcwidth_profile profile;
+    get_builtin_wcwidth_profile(profile, true, false, false);
+
+    std::mt19937 rand(34);
+    std::string text;
+    std::string piece;
+    text.reserve(c_text_len + 64);
+    while (text.length() < c_text_len)
+    {
+        make_cluster_text(rand, 4096, false, piece);
+        text += piece;
+    }
+    const char* const data = text.c_str();
+    const uint64 len = text.length();
+
+    // The position of each cluster, by a single scan.
+    std::vector<column_position> clusters;
+    {
+        column_position pos;
+        wcwidth_iter iter(data, int32(len), &profile);
+        while (iter.next())
+        {
+            clusters.push_back(pos);
+            pos.offset = uint64(iter.get_pointer() - data);
+            if (*iter.character_pointer() == '\n')
+            {
+                ++pos.line;
+                pos.column = 0;
+            }
+            else
+            {
+                pos.column += iter.character_wcwidth_onectrl();
+            }
+        }
+        clusters.push_back(pos);
+    }
+    const auto cluster_at = [&](uint64 offset) -> const column_position&
+    {
+        auto it = std::upper_bound(clusters.begin(), clusters.end(), offset,
+                                   [](uint64 offset, const column_position& pos)
+                                   {
+                                       return offset < pos.offset;
+                                   });
+        return *(it - 1);
+    };
+    const auto same = [](const column_position& a, const column_position& b)
+    {
+        return a.offset == b.offset && a.line == b.line && a.column == b.column;
+    };
+
+    uint32 mismatches = 0;
+    bench_timer timer;
+    column_index index(4096, &profile);
+    for (uint64 indexed = 0; indexed < len;)
+    {
+        indexed = min<uint64>(len, indexed + 1 + rand() % 65536);
+        index.update(data, indexed);
+    }
+    const double build_seconds = timer.seconds();
+    mismatches += !same(index.find_offset(data, len), clusters.back());
+
+    // Tiny appends into a dense index often end in the middle of a sequence
+    // right where a checkpoint is due.
+    column_index dense(256, &profile);
+    const uint64 dense_len = min<uint64>(len, 1024 * 1024);
+    for (uint64 indexed = 0; indexed < dense_len;)
+    {
+        indexed = min<uint64>(dense_len, indexed + 1 + rand() % 8);
+        dense.update(data, indexed);
+    }
+    for (uint64 offset = 0; offset < dense_len; offset += 1 + rand() % 64)
+    {
+        if (!same(dense.find_offset(data, offset), cluster_at(offset)))
+            ++mismatches;
+    }
+
+    timer.restart();
+    for (uint32 i = 0; i < c_queries; ++i)
+    {
+        const uint64 offset = rand() % len;
+        if (!same(index.find_offset(data, offset), cluster_at(offset)))
+            ++mismatches;
+    }
+    const double offset_seconds = timer.seconds();
+
+    // Query the columns of clusters that have width, so that the expected
+    // answer is known without another scan (a zero width cluster shares its
+    // column with the next cluster).
+    timer.restart();
+    for (uint32 i = 0; i < c_queries; ++i)
+    {
+        size_t k = rand() % (clusters.size() - 1);
+        while (k + 1 < clusters.size() - 1 &&
+               (clusters[k + 1].line != clusters[k].line || clusters[k + 1].column == clusters[k].column))
+            ++k;
+        const column_position& expected = clusters[k];
+        column_position pos;
+        if (!index.find_column(data, expected.line, expected.column, pos) || !same(pos, expected))
+            ++mismatches;
+    }
+    const double column_seconds = timer.seconds();
+
+    char path[MAX_PATH];
+    uint32 load_failures = 0;
+    if (get_cache_path("wcwv-bench-columns.idx", path, sizeof(path)) && index.save(path, data))
+    {
+        column_index loaded(4096, &profile);
+        if (!loaded.load(path, data, len))
+            ++load_failures;
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            const uint64 offset = rand() % len;
+            if (!same(loaded.find_offset(data, offset), cluster_at(offset)))
+                ++mismatches;
+        }
+
+        wcwidth_profile other = profile;
+        other.builtin_win11 = !other.builtin_win11;
+        column_index stale(4096, &other);
+        if (stale.load(path, data, len))
+            ++mismatches;
+        remove(path);
+    }
+    else
+    {
+        ++load_failures;
+    }
+
+    fprintf(out, "column_index over %u MB of random text appended in random pieces, %u checkpoints.\n\n", c_text_len / (1024 * 1024), index.checkpoint_count());
+    fprintf(out, "  %-18s %10.1f MB/s\n", "build", megabytes_per_second(len, build_seconds));
+    fprintf(out, "  %-18s %10.2f us\n", "find_offset", offset_seconds * 1e6 / c_queries);
+    fprintf(out, "  %-18s %10.2f us\n", "find_column", column_seconds * 1e6 / c_queries);
+    fprintf(out, "  %-18s %10u\n", "load failures", load_failures);
+    fprintf(out, "  %-18s %10u\n", "mismatches", mismatches);
+    return mismatches + load_failures;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Each benchmark returns the number of mismatches and failures it found.
+struct benchmark
+{
+    const char*     name;
+    uint32          (*run)(FILE* out);
+    const char*     desc;
+};
+
+static const benchmark c_benchmarks[] =
+{
+    { "dbcs",       bench_dbcs,     "DBCS width tables vs. converting to UTF-8 and measuring." },
+    { "render",     bench_render,   "render_width() vs. a wcwidth_iter loop with tab expansion." },
+    { "redraw",     bench_redraw,   "find_redraw_span() vs. repainting from the first difference." },
+    { "grid",       bench_grid,     "Bulk text writes into a cell_grid, and update stream generation." },
+    { "format",     bench_format,   "column_snprintf() vs. measuring and appending padding by hand." },
+    { "cache",      bench_cache,    "wcswidth_cache vs. wcswidth() on prompt segments, and cache invalidation." },
+    { "parallel",   bench_parallel, "wcswidth_parallel() vs. wcswidth(), and randomized chunk splitting." },
+    { "prev",       bench_prev,     "wcwidth_iter::prev() vs. a forward scan, at every byte offset." },
+    { "profiles",   bench_profiles, "Swapping the active profile under concurrent readers (stress test)." },
+    { "columns",    bench_columns,  "column_index queries vs. a linear scan, and saving and loading it." },
+};
+
+//------------------------------------------------------------------------------
+bool run_benchmark(const char* name, FILE* out, uint32& failures)
+{
+    for (const auto& b : c_benchmarks)
+    {
+        if (strcmp(name, b.name) == 0)
+        {
+            failures = b.run(out);
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void list_benchmarks(FILE* out)
+{
+    for (const auto& b : c_benchmarks)
+        fprintf(out, "  %-12s %s\n", b.name, b.desc);
+}
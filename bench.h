@@ -0,0 +1,13 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Runs the named benchmark and prints the results to out.  Benchmarks also
+// check their results; failures receives the number of mismatches and other
+// failures.  Returns false if there's no benchmark by that name.
+bool run_benchmark(const char* name, FILE* out, uint32& failures);
+
+// Prints the names and descriptions of the benchmarks.
+void list_benchmarks(FILE* out);
@@ -0,0 +1,302 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_builtin.h"
+#include "calibration.h"
+
+#include <algorithm>
+
+static const char c_cache_file[] = "wcwv-calibration.txt";
+
+//------------------------------------------------------------------------------
+// Probes that tell modes apart.  Emoji added in each emoji version are added
+// from the tables.
+static const char* const c_probe_pool[] =
+{
+    "\xc2\xa1",                                 // 00A1 ambiguous
+    "\xe2\x91\xa0",                             // 2460 ambiguous
+    "\xe2\x94\x80",                             // 2500 ambiguous box drawing
+    "\xe4\xb8\x80",                             // 4E00 CJK ideograph
+    "\xe3\x80\x80",                             // 3000 ideographic space
+    "\xe1\x84\x80",                             // 1100 Hangul jamo
+    "\xea\xb0\x80",                             // AC00 Hangul syllable
+    "\xe2\x8c\xa9",                             // 2329 angle bracket
+    "\xef\xbd\xb1",                             // FF71 halfwidth katakana
+    "\xef\xbc\xa1",                             // FF21 fullwidth latin
+    "e\xcc\x81",                                // 0065 0301 combining mark
+    "\xcc\x81",                                 // 0301 lone combining mark
+    "\xe2\x80\x8b",                             // 200B zero width space
+    "\xf0\x90\x80\x80",                         // 10000 non-BMP narrow
+    "\xf0\xa0\x80\x80",                         // 20000 non-BMP ideograph
+    "\xf0\x9f\x98\x80",                         // 1F600 emoji
+    "\xe2\x8c\x9a",                             // 231A BMP emoji
+    "\xe2\x8f\xa9",                             // 23E9 BMP emoji
+    "\xc2\xa9",                                 // 00A9 unqualified
+    "\xc2\xa9\xef\xb8\x8f",                     // 00A9 FE0F
+    "\xe2\x9d\xa4",                             // 2764 unqualified
+    "\xe2\x9d\xa4\xef\xb8\x8f",                 // 2764 FE0F
+    "\xe2\x98\x80\xef\xb8\x8f",                 // 2600 FE0F
+    "x\xef\xb8\x8f",                            // 0078 FE0F
+    "#\xef\xb8\x8f\xe2\x83\xa3",                // keycap
+    "\xf0\x9f\x91\x8d\xf0\x9f\x8f\xbd",         // skin tone
+    "\xf0\x9f\x87\xba\xf0\x9f\x87\xb8",         // flag
+    "\xf0\x9f\x91\xa8\xe2\x80\x8d\xf0\x9f\x91\xa9", // ZWJ
+};
+
+//------------------------------------------------------------------------------
+void calibration::init()
+{
+    m_combinations.clear();
+    get_builtin_combinations(m_combinations);
+
+    std::vector<std::string> pool(c_probe_pool, c_probe_pool + _countof(c_probe_pool));
+    for (const auto& version : emoji_versions)
+    {
+        if (version.added)
+        {
+            char utf8[8];
+            pool.emplace_back(utf8, to_utf8(version.added[0].first, utf8));
+        }
+    }
+
+    const uint32 num_combinations = uint32(m_combinations.size());
+    const uint32 num_pool = uint32(pool.size());
+    std::vector<int8> widths(num_combinations * num_pool);
+    for (uint32 c = 0; c < num_combinations; ++c)
+    {
+        for (uint32 p = 0; p < num_pool; ++p)
+            widths[c * num_pool + p] = int8(wcswidth(pool[p].c_str(), uint32(pool[p].length()), &m_combinations[c].profile));
+    }
+
+    // Pairs of combinations that some probe in the pool tells apart.
+    std::vector<std::pair<uint32, uint32>> pairs;
+    for (uint32 a = 0; a < num_combinations; ++a)
+    {
+        for (uint32 b = a + 1; b < num_combinations; ++b)
+        {
+            if (memcmp(&widths[a * num_pool], &widths[b * num_pool], num_pool) != 0)
+                pairs.emplace_back(a, b);
+        }
+    }
+
+    // Greedily keep the probe that tells apart the most remaining pairs.
+    std::vector<uint32> chosen;
+    while (!pairs.empty())
+    {
+        uint32 best = 0;
+        uint32 best_count = 0;
+        for (uint32 p = 0; p < num_pool; ++p)
+        {
+            uint32 count = 0;
+            for (const auto& pair : pairs)
+                count += (widths[pair.first * num_pool + p] != widths[pair.second * num_pool + p]);
+            if (count > best_count)
+            {
+                best = p;
+                best_count = count;
+            }
+        }
+
+        chosen.push_back(best);
+        pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [&](const std::pair<uint32, uint32>& pair) {
+            return widths[pair.first * num_pool + best] != widths[pair.second * num_pool + best];
+        }), pairs.end());
+    }
+
+    m_probes.clear();
+    m_expected.clear();
+    m_signature = 0;
+    for (uint32 p : chosen)
+    {
+        m_probes.push_back(pool[p]);
+        for (const char* s = pool[p].c_str(); *s; ++s)
+            m_signature = m_signature * 31 + uint8(*s);
+    }
+    for (uint32 c = 0; c < num_combinations; ++c)
+    {
+        for (uint32 p : chosen)
+        {
+            m_expected.push_back(widths[c * num_pool + p]);
+            m_signature = m_signature * 31 + uint8(widths[c * num_pool + p]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+const builtin_combination* calibration::select(const std::vector<int32>& widths, const wcwidth_profile* preferred, uint32& matched) const
+{
+    assert(widths.size() == m_probes.size());
+
+    const builtin_combination* best = nullptr;
+    uint32 best_closeness = 0;
+    matched = 0;
+    for (uint32 c = 0; c < m_combinations.size(); ++c)
+    {
+        uint32 count = 0;
+        for (uint32 p = 0; p < probe_count(); ++p)
+            count += (widths[p] == m_expected[c * probe_count() + p]);
+
+        const wcwidth_profile& profile = m_combinations[c].profile;
+        const uint32 closeness = !preferred ? 0 :
+            (profile.color_emoji == preferred->color_emoji) +
+            (profile.builtin_only_ucs2 == preferred->builtin_only_ucs2) +
+            (profile.builtin_cjk == preferred->builtin_cjk) +
+            (profile.builtin_win10 == preferred->builtin_win10) +
+            (profile.builtin_win11 == preferred->builtin_win11) +
+            (profile.builtin_emoji_index == preferred->builtin_emoji_index);
+
+        if (!best || count > matched || (count == matched && closeness > best_closeness))
+        {
+            best = &m_combinations[c];
+            matched = count;
+            best_closeness = closeness;
+        }
+    }
+    return best;
+}
+
+//------------------------------------------------------------------------------
+const builtin_combination* calibration::find(const char* name) const
+{
+    for (const auto& combination : m_combinations)
+    {
+        if (strcmp(combination.name, name) == 0)
+            return &combination;
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+static void append_env(std::string& identity, const char* name, bool value=true)
+{
+    char buffer[128];
+    const DWORD len = GetEnvironmentVariableA(name, buffer, _countof(buffer));
+    if (!len || len >= _countof(buffer))
+        return;
+
+    if (!identity.empty())
+        identity += ';';
+    identity += name;
+    if (value)
+    {
+        identity += '=';
+        for (const char* s = buffer; *s; ++s)
+            identity += (*s == '\t' || *s == '\n' || *s == '\r') ? ' ' : *s;
+    }
+}
+
+//------------------------------------------------------------------------------
+void get_terminal_identity(std::string& identity)
+{
+    identity.clear();
+    append_env(identity, "TERM_PROGRAM");
+    append_env(identity, "TERM_PROGRAM_VERSION");
+    append_env(identity, "TERM");
+    append_env(identity, "ConEmuBuild");
+    append_env(identity, "WT_SESSION", false);
+    append_env(identity, "SSH_CONNECTION", false);
+
+    char cp[32];
+    sprintf(cp, "%scp=%u", identity.empty() ? "" : ";", GetConsoleOutputCP());
+    identity += cp;
+}
+
+//------------------------------------------------------------------------------
+bool get_cache_path(const char* name, char* path, uint32 size)
+{
+    const DWORD len = GetEnvironmentVariableA("LOCALAPPDATA", path, size);
+    const uint32 name_len = uint32(strlen(name));
+    if (!len || len + 1 + name_len + 1 > size)
+        return false;
+    path[len] = '\\';
+    memcpy(path + len + 1, name, name_len + 1);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Each line is "identity<TAB>signature<TAB>name".
+static bool parse_cache_line(char* line, const char*& identity, uint32& signature, const char*& name)
+{
+    line[strcspn(line, "\r\n")] = '\0';
+    char* tab1 = strchr(line, '\t');
+    char* tab2 = tab1 ? strchr(tab1 + 1, '\t') : nullptr;
+    if (!tab2)
+        return false;
+
+    *tab1 = *tab2 = '\0';
+    identity = line;
+    signature = strtoul(tab1 + 1, nullptr, 16);
+    name = tab2 + 1;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool load_cached_calibration(const char* identity, uint32 signature, std::string& name)
+{
+    char path[MAX_PATH];
+    if (!get_cache_path(c_cache_file, path, sizeof(path)))
+        return false;
+
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    bool found = false;
+    char line[512];
+    while (!found && fgets(line, sizeof(line), file))
+    {
+        const char* line_identity;
+        const char* line_name;
+        uint32 line_signature;
+        if (parse_cache_line(line, line_identity, line_signature, line_name) &&
+            line_signature == signature &&
+            strcmp(line_identity, identity) == 0)
+        {
+            name = line_name;
+            found = true;
+        }
+    }
+
+    fclose(file);
+    return found;
+}
+
+//------------------------------------------------------------------------------
+bool save_cached_calibration(const char* identity, uint32 signature, const char* name)
+{
+    char path[MAX_PATH];
+    if (!get_cache_path(c_cache_file, path, sizeof(path)))
+        return false;
+
+    // Keep the lines for other terminals.
+    std::string keep;
+    if (FILE* file = fopen(path, "r"))
+    {
+        char line[512];
+        while (fgets(line, sizeof(line), file))
+        {
+            char copy[512];
+            strcpy(copy, line);
+            const char* line_identity;
+            const char* line_name;
+            uint32 line_signature;
+            if (parse_cache_line(copy, line_identity, line_signature, line_name) &&
+                strcmp(line_identity, identity) != 0)
+                keep += line;
+        }
+        fclose(file);
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fputs(keep.c_str(), file);
+    fprintf(file, "%s\t%08x\t%s\n", identity, signature, name);
+
+    const bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "width_diff.h"
+
+#include <string>
+
+//------------------------------------------------------------------------------
+// Picks the built-in combination of modes that best matches how a terminal
+// renders text, from a handful of measurements.  initialize_wcwidth() can only
+// guess from the environment, the OS version, and the code page, which is
+// wrong for hosts it doesn't know about (such as ConEmu, or a terminal over
+// ssh).
+//
+// init() evaluates every combination over a pool of probe strings (ambiguous
+// width, CJK, Hangul, combining marks, unqualified emoji, VS16, ZWJ, flags,
+// emoji from each emoji version, non-BMP, and so on), and greedily keeps the
+// fewest probes that tell apart every pair of combinations the pool can tell
+// apart.  That's typically about ten probes, which can be measured in one
+// batch; --calibrate reports the actual count.
+class calibration
+{
+public:
+    void            init();
+    uint32          probe_count() const { return uint32(m_probes.size()); }
+    const std::string& probe(uint32 index) const { return m_probes[index]; }
+
+    // Changes whenever the probes or their expected widths change, so a cached
+    // choice from different tables isn't reused.
+    uint32          signature() const { return m_signature; }
+
+    // Returns the combination whose expected widths match the most measured
+    // widths (one per probe), and sets matched to how many matched.  Ties go to
+    // the combination closest to preferred, such as the detected modes.
+    const builtin_combination* select(const std::vector<int32>& widths, const wcwidth_profile* preferred, uint32& matched) const;
+
+    // Returns the combination with the name, or nullptr.
+    const builtin_combination* find(const char* name) const;
+
+private:
+    std::vector<builtin_combination> m_combinations;
+    std::vector<std::string> m_probes;
+    std::vector<int8> m_expected;           // Combination * probe_count() + probe.
+    uint32          m_signature = 0;
+};
+
+//------------------------------------------------------------------------------
+// Describes the terminal from environment variables (such as TERM_PROGRAM,
+// TERM, WT_SESSION, ConEmuBuild, and SSH_CONNECTION) and the output code
+// page, for caching the calibration per kind of terminal.
+void get_terminal_identity(std::string& identity);
+
+// Gets the path of the named file in %LOCALAPPDATA%, where cached state is
+// kept.  Returns false if there's no %LOCALAPPDATA% or the path is too long.
+bool get_cache_path(const char* name, char* path, uint32 size);
+
+// The cache is a text file in %LOCALAPPDATA% with one line per terminal
+// identity.  Both return false if there's no usable cache.
+bool load_cached_calibration(const char* identity, uint32 signature, std::string& name);
+bool save_cached_calibration(const char* identity, uint32 signature, const char* name);
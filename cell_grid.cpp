@@ -0,0 +1,424 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "cell_grid.h"
+
+static const uint32 c_tab_width = 8;
+
+//------------------------------------------------------------------------------
+cell_grid::cell_grid(uint32 width, uint32 height, const wcwidth_profile* profile)
+: m_width(max<uint32>(width, 1))
+, m_height(max<uint32>(height, 1))
+, m_profile(profile)
+{
+    m_chars.resize(m_width * m_height);
+    m_flags.resize(m_width * m_height);
+    m_dirty_begin.resize(m_height);
+    m_dirty_end.resize(m_height);
+    clear();
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::set_cursor(uint32 x, uint32 y)
+{
+    m_cursor_x = min(x, m_width - 1);
+    m_cursor_y = min(y, m_height - 1);
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::clear()
+{
+    memset(m_chars.data(), 0, m_chars.size() * sizeof(m_chars[0]));
+    memset(m_flags.data(), 0, m_flags.size() * sizeof(m_flags[0]));
+    m_clusters.clear();
+    m_pool.clear();
+    m_garbage = 0;
+    m_top = 0;
+    m_pending_scroll = 0;
+    m_cursor_x = 0;
+    m_cursor_y = 0;
+    mark_all_dirty();
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::write(const char* s, uint32 len)
+{
+    const char* const end = s + len;
+    wcwidth_iter iter(s, len, m_profile);
+
+    const char* p = s;
+    while (p < end && *p)
+    {
+        // Printable ASCII is one cell per byte, except the last byte before
+        // something that could join its cluster.
+        const char* run = p;
+        while (run < end && uint8(*run) >= 0x20 && uint8(*run) < 0x7f)
+            ++run;
+        if (run < end && uint8(*run) >= 0x80 && run > p)
+            --run;
+        if (run > p)
+        {
+            put_ascii(p, uint32(run - p));
+            p = run;
+            continue;
+        }
+
+        iter.reset_pointer(p);
+        const char32_t first = iter.next();
+        if (!first)
+            break;
+        p = iter.get_pointer();
+
+        const int32 w = iter.character_wcwidth_signed();
+        if (w < 0)
+            control(first);
+        else if (w == 0)
+            append(iter.character_pointer(), iter.character_length());
+        else
+            put(first, iter.character_pointer(), iter.character_length(), uint32(w));
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32 cell_grid::get_cell(uint32 x, uint32 y, std::string& out) const
+{
+    if (x >= m_width || y >= m_height)
+        return 0;
+
+    const uint32 i = index(x, y);
+    if (m_flags[i] & cell_trailing)
+        return 0;
+    append_text(i, out);
+    return (m_flags[i] & cell_leading) ? 2 : 1;
+}
+
+//------------------------------------------------------------------------------
+bool cell_grid::get_dirty_range(uint32 y, uint32& begin, uint32& end) const
+{
+    if (y >= m_height)
+        return false;
+
+    const uint32 r = row_index(y);
+    begin = m_dirty_begin[r];
+    end = m_dirty_end[r];
+    return begin < end;
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::mark_all_dirty()
+{
+    for (uint32 r = 0; r < m_height; ++r)
+    {
+        m_dirty_begin[r] = 0;
+        m_dirty_end[r] = m_width;
+    }
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::get_updates(std::string& out)
+{
+    char tmp[32];
+
+    // Scrolled rows were already redrawn by the terminal; scrolling can only
+    // leave dirty ranges that moved with their rows.
+    if (m_pending_scroll)
+    {
+        sprintf(tmp, "\x1b[%uS", min(m_pending_scroll, m_height));
+        out += tmp;
+        m_pending_scroll = 0;
+    }
+
+    for (uint32 y = 0; y < m_height; ++y)
+    {
+        const uint32 r = row_index(y);
+        uint32 begin = m_dirty_begin[r];
+        uint32 end = m_dirty_end[r];
+        if (begin >= end)
+            continue;
+
+        // Always repaint both halves of wide cells.
+        const uint32 row = r * m_width;
+        if (m_flags[row + begin] & cell_trailing)
+            --begin;
+        if (end < m_width && (m_flags[row + end] & cell_trailing))
+            ++end;
+
+        sprintf(tmp, "\x1b[%u;%uH", y + 1, begin + 1);
+        out += tmp;
+        for (uint32 x = begin; x < end; ++x)
+        {
+            const uint32 i = row + x;
+            if (m_flags[i] & cell_trailing)
+                continue;
+            if (!m_chars[i] && !(m_flags[i] & cell_cluster))
+                out += ' ';
+            else
+                append_text(i, out);
+        }
+
+        m_dirty_begin[r] = m_width;
+        m_dirty_end[r] = 0;
+    }
+
+    sprintf(tmp, "\x1b[%u;%uH", m_cursor_y + 1, min(m_cursor_x, m_width - 1) + 1);
+    out += tmp;
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::put(char32_t c, const char* text, uint32 len, uint32 width)
+{
+    if (width > m_width)
+        return;
+
+    if (m_cursor_x + width > m_width)
+    {
+        // A wide cluster that doesn't fit leaves the last cell blank.
+        if (m_cursor_x < m_width)
+        {
+            split_wide(m_cursor_x);
+            blank_cell(m_cursor_x);
+            mark_dirty(m_cursor_y, m_cursor_x, m_cursor_x + 1);
+        }
+        new_line();
+    }
+
+    const uint32 x = m_cursor_x;
+    split_wide(x);
+    if (width > 1)
+        split_wide(x + 1);
+
+    const uint32 i = index(x, m_cursor_y);
+    release_cell(i);
+    set_text(i, c, text, len);
+    m_flags[i] = (m_flags[i] & cell_cluster) | ((width > 1) ? cell_leading : 0);
+    if (width > 1)
+    {
+        release_cell(i + 1);
+        m_chars[i + 1] = 0;
+        m_flags[i + 1] = cell_trailing;
+    }
+
+    mark_dirty(m_cursor_y, x, x + width);
+    m_cursor_x += width;
+}
+
+//------------------------------------------------------------------------------
+// Same as calling put() for each byte, but fills each row's part of the run at
+// once; only the cells at the ends of the run can split a wide cluster.
+void cell_grid::put_ascii(const char* s, uint32 len)
+{
+    while (len)
+    {
+        if (m_cursor_x >= m_width)
+            new_line();
+
+        const uint32 x = m_cursor_x;
+        const uint32 n = min(len, m_width - x);
+        split_wide(x);
+        split_wide(x + n - 1);
+
+        const uint32 i = index(x, m_cursor_y);
+        for (uint32 k = 0; k < n; ++k)
+        {
+            release_cell(i + k);
+            m_chars[i + k] = uint8(s[k]);
+            m_flags[i + k] = 0;
+        }
+
+        mark_dirty(m_cursor_y, x, x + n);
+        m_cursor_x += n;
+        s += n;
+        len -= n;
+    }
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::append(const char* text, uint32 len)
+{
+    uint32 x = min(m_cursor_x, m_width);
+    if (!x)
+        return;
+
+    --x;
+    uint32 i = index(x, m_cursor_y);
+    if ((m_flags[i] & cell_trailing) && x)
+    {
+        --x;
+        --i;
+    }
+
+    std::string combined;
+    append_text(i, combined);
+    combined.append(text, len);
+
+    const uint8 halves = m_flags[i] & (cell_leading|cell_trailing);
+    release_cell(i);
+    set_text(i, 0, combined.c_str(), uint32(combined.length()));
+    m_flags[i] |= halves;
+
+    mark_dirty(m_cursor_y, x, x + 1);
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::control(char32_t c)
+{
+    switch (c)
+    {
+    case '\r':
+        m_cursor_x = 0;
+        break;
+    case '\n':
+        new_line();
+        break;
+    case '\t':
+        m_cursor_x = min((m_cursor_x / c_tab_width + 1) * c_tab_width, m_width - 1);
+        break;
+    case '\b':
+        m_cursor_x = min(m_cursor_x, m_width - 1);
+        if (m_cursor_x)
+            --m_cursor_x;
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::new_line()
+{
+    m_cursor_x = 0;
+    if (m_cursor_y + 1 < m_height)
+    {
+        ++m_cursor_y;
+        return;
+    }
+
+    // Scroll up by making the top physical row the new bottom row.
+    const uint32 r = m_top;
+    m_top = (m_top + 1) % m_height;
+    ++m_pending_scroll;
+
+    const uint32 row = r * m_width;
+    for (uint32 x = 0; x < m_width; ++x)
+        release_cell(row + x);
+    memset(m_chars.data() + row, 0, m_width * sizeof(m_chars[0]));
+    memset(m_flags.data() + row, 0, m_width * sizeof(m_flags[0]));
+
+    // The terminal clears the new row when it scrolls, so it's only dirty
+    // if the grid scrolls more than a screenful before the next update.
+    if (m_pending_scroll >= m_height)
+        mark_all_dirty();
+    else
+    {
+        m_dirty_begin[r] = m_width;
+        m_dirty_end[r] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::blank_cell(uint32 x)
+{
+    const uint32 i = index(x, m_cursor_y);
+    release_cell(i);
+    m_chars[i] = 0;
+    m_flags[i] = 0;
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::release_cell(uint32 i)
+{
+    if (m_flags[i] & cell_cluster)
+    {
+        m_flags[i] &= ~cell_cluster;
+        ++m_garbage;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Before cell x is overwritten, blanks the other half of a wide cluster that
+// cell x is part of.
+void cell_grid::split_wide(uint32 x)
+{
+    if (x >= m_width)
+        return;
+
+    const uint8 flags = m_flags[index(x, m_cursor_y)];
+    if ((flags & cell_trailing) && x > 0)
+    {
+        blank_cell(x - 1);
+        mark_dirty(m_cursor_y, x - 1, x);
+    }
+    else if ((flags & cell_leading) && x + 1 < m_width)
+    {
+        blank_cell(x + 1);
+        mark_dirty(m_cursor_y, x + 1, x + 2);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Stores c directly if text is just c (or there is no text); otherwise stores
+// the text in the cluster pool.
+void cell_grid::set_text(uint32 i, char32_t c, const char* text, uint32 len)
+{
+    char utf8[8];
+    if (!text || (c && to_utf8(c, utf8) == len && memcmp(utf8, text, len) == 0))
+    {
+        m_chars[i] = c;
+        m_flags[i] &= ~cell_cluster;
+        return;
+    }
+
+    if (m_garbage > 64 && m_garbage > uint32(m_clusters.size() / 2))
+        compact();
+
+    m_chars[i] = uint32(m_clusters.size());
+    m_flags[i] |= cell_cluster;
+    m_clusters.push_back({ uint32(m_pool.size()), len });
+    m_pool.insert(m_pool.end(), text, text + len);
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::append_text(uint32 i, std::string& out) const
+{
+    if (m_flags[i] & cell_cluster)
+    {
+        const cluster_text& cluster = m_clusters[m_chars[i]];
+        out.append(m_pool.data() + cluster.offset, cluster.len);
+    }
+    else if (m_chars[i])
+    {
+        char utf8[8];
+        const uint32 len = to_utf8(m_chars[i], utf8);
+        out.append(utf8, len);
+    }
+}
+
+//------------------------------------------------------------------------------
+void cell_grid::mark_dirty(uint32 y, uint32 begin, uint32 end)
+{
+    const uint32 r = row_index(y);
+    m_dirty_begin[r] = min(m_dirty_begin[r], begin);
+    m_dirty_end[r] = max(m_dirty_end[r], min(end, m_width));
+}
+
+//------------------------------------------------------------------------------
+// Rebuilds the cluster pool with only the clusters that cells still use.
+void cell_grid::compact()
+{
+    std::vector<cluster_text> clusters;
+    std::vector<char> pool;
+    for (uint32 i = 0; i < uint32(m_chars.size()); ++i)
+    {
+        if (!(m_flags[i] & cell_cluster))
+            continue;
+
+        const cluster_text& old = m_clusters[m_chars[i]];
+        m_chars[i] = uint32(clusters.size());
+        clusters.push_back({ uint32(pool.size()), old.len });
+        pool.insert(pool.end(), m_pool.data() + old.offset, m_pool.data() + old.offset + old.len);
+    }
+
+    m_clusters.swap(clusters);
+    m_pool.swap(pool);
+    m_garbage = 0;
+}
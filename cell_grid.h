@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+
+struct wcwidth_profile;
+
+//------------------------------------------------------------------------------
+// An off-screen model of a console screen buffer, so callers can keep track
+// of what's on the screen without querying the console.
+//
+// Text is split into clusters by wcwidth_iter.  A wide cluster occupies two
+// cells:  a leading half that holds the text, and a trailing half that holds
+// nothing.  Like conhost, a wide cluster that doesn't fit at the right edge
+// leaves the last cell blank and wraps to the next line, and writing over
+// either half of a wide cluster blanks the other half.  A zero width cluster
+// is appended to the cell before the cursor.
+//
+// CR, LF (which also returns to the first column, as in conhost), TAB (tab
+// stops every 8 columns), and BS move the cursor; other control characters
+// are ignored, and escape sequences are not interpreted.  Writing past the
+// bottom row scrolls the grid up.
+//
+// Cells are stored as parallel arrays (the first codepoint of each cell, and
+// flags), so bulk writes touch as little memory as possible.  Clusters with
+// more than one codepoint are kept in a separate pool.
+//
+// Each row remembers the range of columns that changed since the last call to
+// get_updates(), which turns them into a VT update stream:  one scroll
+// sequence for any scrolling, then for each changed row a cursor position
+// sequence and the text of the changed cells, and finally the cursor
+// position.  Any number of writes can be batched between updates.
+class cell_grid
+{
+public:
+                    cell_grid(uint32 width, uint32 height, const wcwidth_profile* profile=nullptr);
+    uint32          width() const { return m_width; }
+    uint32          height() const { return m_height; }
+    uint32          cursor_x() const { return m_cursor_x; }
+    uint32          cursor_y() const { return m_cursor_y; }
+    void            set_cursor(uint32 x, uint32 y);
+    void            clear();
+    void            write(const char* s, uint32 len);
+
+    // Returns the width of the cell (1 or 2, or 0 for the trailing half of a
+    // wide cell) and appends its text to out.  An empty cell has width 1 and
+    // no text.
+    uint32          get_cell(uint32 x, uint32 y, std::string& out) const;
+
+    // Returns false if no cells in the row changed since the last update.
+    bool            get_dirty_range(uint32 y, uint32& begin, uint32& end) const;
+    void            mark_all_dirty();
+
+    // Appends the update stream to out, and resets the dirty ranges.
+    void            get_updates(std::string& out);
+
+private:
+    enum : uint8
+    {
+        cell_leading    = 0x01,             // Leading half of a wide cell.
+        cell_trailing   = 0x02,             // Trailing half of a wide cell.
+        cell_cluster    = 0x04,             // m_chars holds an index into m_clusters.
+    };
+
+    struct cluster_text
+    {
+        uint32      offset;
+        uint32      len;
+    };
+
+    uint32          index(uint32 x, uint32 y) const { return row_index(y) * m_width + x; }
+    uint32          row_index(uint32 y) const { return (m_top + y) % m_height; }
+    void            put(char32_t c, const char* text, uint32 len, uint32 width);
+    void            put_ascii(const char* s, uint32 len);
+    void            append(const char* text, uint32 len);
+    void            control(char32_t c);
+    void            new_line();
+    void            blank_cell(uint32 x);
+    void            release_cell(uint32 i);
+    void            split_wide(uint32 x);
+    void            set_text(uint32 i, char32_t c, const char* text, uint32 len);
+    void            append_text(uint32 i, std::string& out) const;
+    void            mark_dirty(uint32 y, uint32 begin, uint32 end);
+    void            compact();
+
+    const uint32    m_width;
+    const uint32    m_height;
+    const wcwidth_profile* const m_profile;
+    std::vector<char32_t> m_chars;          // First codepoint; 0 is an empty cell.
+    std::vector<uint8> m_flags;
+    std::vector<uint32> m_dirty_begin;      // Indexed by physical row.
+    std::vector<uint32> m_dirty_end;
+    std::vector<cluster_text> m_clusters;
+    std::vector<char> m_pool;
+    uint32          m_garbage = 0;          // Clusters no longer used by any cell.
+    uint32          m_top = 0;              // Physical row of the top row.
+    uint32          m_pending_scroll = 0;
+    uint32          m_cursor_x = 0;         // Can be m_width, meaning a wrap is pending.
+    uint32          m_cursor_y = 0;
+};
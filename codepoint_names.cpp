@@ -0,0 +1,213 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "codepoint_names.h"
+
+#include <mutex>
+
+#include "assigned-codepoints.i"
+
+//------------------------------------------------------------------------------
+// The layout of codepoint-names.bin, which 'premake5 tables' generates along
+// with assigned-codepoints.i.  The offsets are relative to the start of the
+// names, and each name is NUL terminated.
+struct names_file_header
+{
+    char            magic[4];
+    uint32          version;
+    uint32          count;                  // Must match c_assigned.
+    uint32          checksum;               // Must match c_assigned_checksum.
+    uint32          offsets_offset;
+    uint32          names_offset;
+    uint32          names_size;
+};
+
+static const char c_names_magic[4] = { 'W', 'C', 'W', 'N' };
+static const uint32 c_names_version = 1;
+static const char c_names_file[] = "codepoint-names.bin";
+
+static std::once_flag s_names_once;
+static const uint32* s_name_offsets = nullptr;
+static const char* s_names = nullptr;
+static uint32 s_names_size = 0;
+
+//------------------------------------------------------------------------------
+static bool attach_names(const void* data, uint32 size)
+{
+    if (!data || size < sizeof(names_file_header))
+        return false;
+
+    const names_file_header* header = static_cast<const names_file_header*>(data);
+    const bool ok = (memcmp(header->magic, c_names_magic, sizeof(header->magic)) == 0 &&
+                     header->version == c_names_version &&
+                     header->count == _countof(c_assigned) &&
+                     header->checksum == c_assigned_checksum &&
+                     header->offsets_offset % sizeof(uint32) == 0 &&
+                     header->offsets_offset <= size &&
+                     (size - header->offsets_offset) / sizeof(uint32) >= header->count &&
+                     header->names_offset <= size &&
+                     size - header->names_offset >= header->names_size &&
+                     header->names_size > 0);
+    if (!ok)
+        return false;
+
+    const uint8* base = static_cast<const uint8*>(data);
+    s_names = reinterpret_cast<const char*>(base + header->names_offset);
+    if (s_names[header->names_size - 1] != '\0')
+    {
+        s_names = nullptr;
+        return false;
+    }
+
+    s_name_offsets = reinterpret_cast<const uint32*>(base + header->offsets_offset);
+    s_names_size = header->names_size;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool map_names_file()
+{
+    char path[MAX_PATH];
+    const DWORD len = GetModuleFileNameA(nullptr, path, _countof(path));
+    if (!len || len >= _countof(path))
+        return false;
+
+    char* name = path + len;
+    while (name > path && name[-1] != '\\' && name[-1] != '/')
+        --name;
+    if (size_t(name - path) + sizeof(c_names_file) > sizeof(path))
+        return false;
+    memcpy(name, c_names_file, sizeof(c_names_file));
+
+    HANDLE h = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h, &size) || size.QuadPart < LONGLONG(sizeof(names_file_header)) || size.QuadPart > 0x10000000)
+    {
+        CloseHandle(h);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(h);
+    if (!view)
+        return false;
+
+    // The view stays mapped for the rest of the process.
+    if (attach_names(view, uint32(size.QuadPart)))
+        return true;
+
+    UnmapViewOfFile(view);
+    return false;
+}
+
+//------------------------------------------------------------------------------
+static bool load_embedded_names()
+{
+#ifdef NO_EMBEDDED_NAMES
+    return false;
+#else
+    HRSRC res = FindResourceA(nullptr, "CODEPOINT_NAMES", RT_RCDATA);
+    HGLOBAL global = res ? LoadResource(nullptr, res) : nullptr;
+    const void* data = global ? LockResource(global) : nullptr;
+    return attach_names(data, data ? uint32(SizeofResource(nullptr, res)) : 0);
+#endif
+}
+
+//------------------------------------------------------------------------------
+static int32 find_assigned(char32_t ucs)
+{
+    int32 min = 0;
+    int32 max = _countof(c_assigned) - 1;
+    int32 mid;
+
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (ucs > c_assigned[mid])
+            min = mid + 1;
+        else if (ucs < c_assigned[mid])
+            max = mid - 1;
+        else
+            return mid;
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+static const codepoint_range* find_assigned_area(char32_t ucs)
+{
+    const struct codepoint_range* atable = c_assigned_areas;
+    int32 min = 0;
+    int32 max = _countof(c_assigned_areas) - 1;
+    int32 mid;
+
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (ucs > atable[mid].last)
+            min = mid + 1;
+        else if (ucs < atable[mid].first)
+            max = mid - 1;
+        else
+            return &atable[mid];
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool is_assigned(char32_t ucs)
+{
+    return find_assigned(ucs) >= 0 || find_assigned_area(ucs);
+}
+
+//------------------------------------------------------------------------------
+bool is_ideograph(char32_t ucs)
+{
+    int32 min = 0;
+    int32 max = _countof(c_named_ideographs) - 1;
+    int32 mid;
+
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (ucs > c_named_ideographs[mid].last)
+            min = mid + 1;
+        else if (ucs < c_named_ideographs[mid].first)
+            max = mid - 1;
+        else
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+const char* get_codepoint_name(char32_t ucs)
+{
+    const int32 index = find_assigned(ucs);
+    if (index < 0)
+    {
+        const codepoint_range* area = find_assigned_area(ucs);
+        return area ? area->desc : nullptr;
+    }
+
+    std::call_once(s_names_once, []() {
+        if (!map_names_file())
+            load_embedded_names();
+    });
+
+    if (!s_names)
+        return nullptr;
+
+    const uint32 offset = s_name_offsets[index];
+    return (offset < s_names_size) ? s_names + offset : nullptr;
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Which codepoints are assigned is compiled in, but their names are in
+// codepoint-names.bin, which is mapped the first time a name is needed.  The
+// file next to wcwv.exe is used when it's present and matches the compiled in
+// codepoints; otherwise the copy embedded as a resource is used, unless the
+// build omits it (premake5 --no-embedded-names).
+
+bool is_assigned(char32_t ucs);
+bool is_ideograph(char32_t ucs);
+
+// Returns the name of an assigned codepoint, the name of the area for a
+// codepoint in a large range such as CJK Ideograph, or nullptr if it isn't
+// assigned or the names are unavailable.
+const char* get_codepoint_name(char32_t ucs);
@@ -0,0 +1,460 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "column_format.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const char c_spaces[] = "                                ";
+static const char c_zeros[] = "00000000000000000000000000000000";
+
+// Caps the precision of a number so that snprintf() output always fits in the
+// number buffer:  the largest double has 309 integer digits.
+static const int32 c_max_number_precision = 100;
+
+//------------------------------------------------------------------------------
+// Collects the output in the caller's buffer, truncating it to fit.
+class buffer_sink
+{
+public:
+                    buffer_sink(char* buffer, uint32 size) : m_buffer(buffer), m_size(size) {}
+    void            write(const char* s, uint32 len);
+    uint32          finish();
+
+private:
+    char* const     m_buffer;
+    const uint32    m_size;
+    uint32          m_used = 0;
+    uint32          m_total = 0;
+    bool            m_full = false;
+};
+
+//------------------------------------------------------------------------------
+void buffer_sink::write(const char* s, uint32 len)
+{
+    m_total += len;
+    if (m_full)
+        return;
+
+    const uint32 room = m_size ? m_size - 1 - m_used : 0;
+    if (len > room)
+    {
+        // Don't split a UTF-8 sequence.
+        len = room;
+        while (len && (uint8(s[len]) & 0xc0) == 0x80)
+            --len;
+        m_full = true;
+    }
+
+    memcpy(m_buffer + m_used, s, len);
+    m_used += len;
+}
+
+//------------------------------------------------------------------------------
+uint32 buffer_sink::finish()
+{
+    if (m_size)
+        m_buffer[m_used] = '\0';
+    return m_total;
+}
+
+//------------------------------------------------------------------------------
+// Collects the output in a stack buffer, and writes it to a FILE whenever the
+// buffer fills up.
+class file_sink
+{
+public:
+                    file_sink(FILE* out) : m_out(out) {}
+    void            write(const char* s, uint32 len);
+    uint32          finish();
+
+private:
+    void            flush();
+
+    FILE* const     m_out;
+    uint32          m_used = 0;
+    uint32          m_written = 0;
+    char            m_buffer[512];
+};
+
+//------------------------------------------------------------------------------
+void file_sink::write(const char* s, uint32 len)
+{
+    while (len)
+    {
+        if (m_used == sizeof(m_buffer))
+            flush();
+        const uint32 n = min<uint32>(len, sizeof(m_buffer) - m_used);
+        memcpy(m_buffer + m_used, s, n);
+        m_used += n;
+        s += n;
+        len -= n;
+    }
+}
+
+//------------------------------------------------------------------------------
+void file_sink::flush()
+{
+    m_written += uint32(fwrite(m_buffer, 1, m_used, m_out));
+    m_used = 0;
+}
+
+//------------------------------------------------------------------------------
+uint32 file_sink::finish()
+{
+    flush();
+    return m_written;
+}
+
+//------------------------------------------------------------------------------
+template <class Sink>
+static void write_padding(Sink& sink, uint32 columns, const char* fill=c_spaces)
+{
+    while (columns)
+    {
+        const uint32 n = min<uint32>(columns, sizeof(c_spaces) - 1);
+        sink.write(fill, n);
+        columns -= n;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Writes text padded to width columns, after truncating it to precision
+// columns (when precision is not -1).
+template <class Sink>
+static void write_text(Sink& sink, const char* s, uint32 len, int32 width, int32 precision, bool left)
+{
+    const uint32 columns = column_measure(s, len, precision);
+    const uint32 pad = (width > 0 && uint32(width) > columns) ? uint32(width) - columns : 0;
+
+    if (!left)
+        write_padding(sink, pad);
+    sink.write(s, len);
+    if (left)
+        write_padding(sink, pad);
+}
+
+//------------------------------------------------------------------------------
+// Saturates at INT32_MAX instead of overflowing.
+static int32 parse_number(const char*& fmt)
+{
+    int32 n = 0;
+    while (*fmt >= '0' && *fmt <= '9')
+    {
+        const int32 digit = *(fmt++) - '0';
+        n = (n > (INT32_MAX - digit) / 10) ? INT32_MAX : n * 10 + digit;
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+static char* append_number(char* p, int32 n)
+{
+    char digits[12];
+    uint32 count = 0;
+    do
+    {
+        digits[count++] = char('0' + n % 10);
+        n /= 10;
+    }
+    while (n);
+    while (count)
+        *(p++) = digits[--count];
+    return p;
+}
+
+//------------------------------------------------------------------------------
+template <class Sink>
+static void format_columns(Sink& sink, const char* fmt, va_list args)
+{
+    while (*fmt)
+    {
+        const char* pct = strchr(fmt, '%');
+        if (!pct)
+        {
+            sink.write(fmt, uint32(strlen(fmt)));
+            break;
+        }
+
+        sink.write(fmt, uint32(pct - fmt));
+        const char* const spec_begin = pct;
+        fmt = pct + 1;
+
+        // Flags.
+        char flags[8];
+        uint32 num_flags = 0;
+        bool left = false;
+        while (*fmt && strchr("-+ 0#", *fmt))
+        {
+            left |= (*fmt == '-');
+            if (num_flags < sizeof(flags) - 1)
+                flags[num_flags++] = *fmt;
+            ++fmt;
+        }
+        flags[num_flags] = '\0';
+
+        // Width and precision.
+        int32 width = 0;
+        if (*fmt == '*')
+        {
+            width = va_arg(args, int32);
+            if (width < 0)
+            {
+                left = true;
+                width = (width == INT32_MIN) ? INT32_MAX : -width;
+            }
+            ++fmt;
+        }
+        else
+        {
+            width = parse_number(fmt);
+        }
+
+        int32 precision = -1;
+        if (*fmt == '.')
+        {
+            ++fmt;
+            if (*fmt == '*')
+            {
+                precision = va_arg(args, int32);
+                if (precision < 0)
+                    precision = -1;
+                ++fmt;
+            }
+            else
+            {
+                precision = parse_number(fmt);
+            }
+        }
+
+        // Length modifiers.
+        char length[3] = {};
+        if (*fmt == 'h' || *fmt == 'l')
+        {
+            length[0] = *(fmt++);
+            if (*fmt == length[0])
+                length[1] = *(fmt++);
+        }
+        else if (*fmt && strchr("zjtL", *fmt))
+        {
+            length[0] = *(fmt++);
+        }
+
+        const char conv = *fmt;
+        if (!conv)
+        {
+            // Incomplete conversion at the end; write it as is.
+            sink.write(spec_begin, uint32(fmt - spec_begin));
+            break;
+        }
+        ++fmt;
+
+        switch (conv)
+        {
+        case '%':
+            sink.write("%", 1);
+            continue;
+
+        case 's':
+            {
+                const char* s = va_arg(args, const char*);
+                if (!s)
+                    s = "(null)";
+                write_text(sink, s, uint32(strlen(s)), width, precision, left);
+            }
+            continue;
+
+        case 'c':
+            {
+                char utf8[8];
+                const uint32 len = to_utf8(char32_t(va_arg(args, int32)), utf8);
+                write_text(sink, utf8, len, width, -1, left);
+            }
+            continue;
+        }
+
+        // Numbers are ASCII, so they're formatted by snprintf() without the
+        // width, and padded here; that way a large width needs no buffer.
+        // The precision is capped so that the number always fits.
+        char spec[1 + sizeof(flags) + 1 + 11 + sizeof(length) + 2];
+        char* p = spec;
+        *(p++) = '%';
+        for (const char* f = flags; *f; ++f)
+        {
+            if (*f != '-' && *f != '0')
+                *(p++) = *f;
+        }
+        if (precision >= 0)
+        {
+            *(p++) = '.';
+            p = append_number(p, min<int32>(precision, c_max_number_precision));
+        }
+        for (const char* l = length; *l; ++l)
+            *(p++) = *l;
+        *(p++) = conv;
+        *p = '\0';
+
+        char number[c_max_number_precision + 320];
+        int32 len = -1;
+        bool integer = true;
+        switch (conv)
+        {
+        case 'd':
+        case 'i':
+            if (length[0] == 'l' && length[1] == 'l')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, long long));
+            else if (length[0] == 'l')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, long));
+            else if (length[0] == 'z' || length[0] == 't')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, ptrdiff_t));
+            else if (length[0] == 'j')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, intmax_t));
+            else if (length[0] != 'L')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, int));
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            if (length[0] == 'l' && length[1] == 'l')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, unsigned long long));
+            else if (length[0] == 'l')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, unsigned long));
+            else if (length[0] == 'z' || length[0] == 't')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, size_t));
+            else if (length[0] == 'j')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, uintmax_t));
+            else if (length[0] != 'L')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, unsigned int));
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            integer = false;
+            if (length[0] == 'L')
+                len = snprintf(number, sizeof(number), spec, va_arg(args, long double));
+            else if (!length[0] || (length[0] == 'l' && !length[1]))
+                len = snprintf(number, sizeof(number), spec, va_arg(args, double));
+            break;
+        case 'p':
+            if (!length[0])
+                len = snprintf(number, sizeof(number), spec, va_arg(args, void*));
+            break;
+        }
+
+        if (len < 0)
+        {
+            // An unknown conversion or length modifier.  Its argument can't
+            // be skipped without knowing its type, so the rest of the
+            // arguments can't be found either; write the rest of the format
+            // string as is.
+            assert(false);
+            sink.write(spec_begin, uint32(strlen(spec_begin)));
+            break;
+        }
+
+        len = min<int32>(len, sizeof(number) - 1);
+
+        // The 0 flag pads with zeros after the sign and the 0x prefix, except
+        // when an integer has a precision, or for inf and nan.
+        uint32 prefix = 0;
+        if (number[prefix] == '-' || number[prefix] == '+' || number[prefix] == ' ')
+            ++prefix;
+        if ((conv == 'x' || conv == 'X') && number[prefix] == '0' && number[prefix + 1] == conv)
+            prefix += 2;
+        const bool zeros = (strchr(flags, '0') && !left && conv != 'p' &&
+                            (integer ? precision < 0 : number[prefix] >= '0' && number[prefix] <= '9'));
+
+        const uint32 pad = (width > 0 && uint32(width) > uint32(len)) ? uint32(width) - uint32(len) : 0;
+        if (zeros)
+        {
+            sink.write(number, prefix);
+            write_padding(sink, pad, c_zeros);
+            sink.write(number + prefix, uint32(len) - prefix);
+        }
+        else
+        {
+            if (!left)
+                write_padding(sink, pad);
+            sink.write(number, uint32(len));
+            if (left)
+                write_padding(sink, pad);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32 column_measure(const char* s, uint32& len, int32 max_columns)
+{
+    // Printable ASCII is one column per byte.  A character after the run can
+    // combine with the last byte of the run, so the run only decides the
+    // result by itself when it reaches the end, or when it's longer than
+    // max_columns.
+    uint32 ascii = 0;
+    while (ascii < len && uint8(s[ascii]) >= 0x20 && uint8(s[ascii]) < 0x7f)
+        ++ascii;
+    if (max_columns >= 0 && ascii > uint32(max_columns))
+    {
+        len = uint32(max_columns);
+        return len;
+    }
+    if (ascii == len)
+        return len;
+
+    const uint32 start = ascii ? ascii - 1 : 0;
+    uint32 columns = start;
+    wcwidth_iter iter(s + start, int32(len - start));
+    while (iter.next())
+    {
+        const uint32 w = iter.character_wcwidth_onectrl();
+        if (max_columns >= 0 && columns + w > uint32(max_columns))
+        {
+            len = uint32(iter.character_pointer() - s);
+            break;
+        }
+        columns += w;
+    }
+    return columns;
+}
+
+//------------------------------------------------------------------------------
+uint32 column_vsnprintf(char* buffer, uint32 size, const char* fmt, va_list args)
+{
+    buffer_sink sink(buffer, size);
+    format_columns(sink, fmt, args);
+    return sink.finish();
+}
+
+//------------------------------------------------------------------------------
+uint32 column_snprintf(char* buffer, uint32 size, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const uint32 len = column_vsnprintf(buffer, size, fmt, args);
+    va_end(args);
+    return len;
+}
+
+//------------------------------------------------------------------------------
+uint32 column_vfprintf(FILE* out, const char* fmt, va_list args)
+{
+    file_sink sink(out);
+    format_columns(sink, fmt, args);
+    return sink.finish();
+}
+
+//------------------------------------------------------------------------------
+uint32 column_fprintf(FILE* out, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    const uint32 len = column_vfprintf(out, fmt, args);
+    va_end(args);
+    return len;
+}
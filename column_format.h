@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <stdarg.h>
+
+//------------------------------------------------------------------------------
+// printf-style formatting where the width and precision of a conversion are
+// display columns instead of bytes:  "%-12s" pads a string to 12 columns, and
+// "%.8s" truncates it to at most 8 columns without splitting a character or
+// an emoji sequence.  Columns are measured the same as wcswidth(), with the
+// active profile.
+//
+// Conversions are %s, %c (a codepoint, encoded as UTF-8), %d %i %u %x %X %o,
+// %e %f %g, %p, and %%, with the flags - + space 0 #, * for the width or
+// precision, and the length modifiers hh h l ll z j t L.  Numbers are ASCII,
+// so they're formatted by snprintf(), with the precision capped at 100.  Any
+// other conversion asserts, and the rest of the format string is written as
+// is, since its argument can't be skipped.
+//
+// Nothing is allocated:  the output goes to the caller's buffer, or through
+// a small stack buffer to a FILE.
+
+// Like snprintf():  the output is truncated to fit, without splitting a UTF-8
+// sequence, and is always NUL terminated when size > 0.  Returns how many
+// bytes the whole output needs, not counting the NUL terminator.
+uint32 column_snprintf(char* buffer, uint32 size, const char* fmt, ...);
+uint32 column_vsnprintf(char* buffer, uint32 size, const char* fmt, va_list args);
+
+// Returns how many bytes were written.
+uint32 column_fprintf(FILE* out, const char* fmt, ...);
+uint32 column_vfprintf(FILE* out, const char* fmt, va_list args);
+
+// Returns how many columns s occupies (the same as wcswidth()), and when
+// max_columns is not -1, stops before the first character that would exceed
+// max_columns and sets len to the number of bytes that fit.
+uint32 column_measure(const char* s, uint32& len, int32 max_columns=-1);
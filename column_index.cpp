@@ -0,0 +1,304 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "column_index.h"
+
+#include <algorithm>
+
+// wcwidth_iter takes an int32 length, so long scans are done in windows.  A
+// window ends at a safe cluster boundary if there's one in the last
+// c_max_window_resync bytes of it, which there always is in practice.
+static const uint64 c_max_window = 0x40000000;
+static const uint32 c_max_window_resync = 4096;
+static const uint32 c_tail_hash_len = 4096;
+
+//------------------------------------------------------------------------------
+// Everything about a profile that affects widths.  The name alone isn't
+// enough:  built-in profiles also depend on the OS version, and loaded
+// profiles can have any name.
+struct index_profile_key
+{
+    char            name[32];
+    uint8           color_emoji;
+    int8            combining_mark_width;
+    int8            ambiguous_width;
+    uint8           only_ucs2;
+    uint8           cjk;
+    uint8           win10;
+    uint8           win11;
+    uint8           emoji_index;
+    uint64          tables_hash;            // Hash of a loaded profile's file.
+};
+
+static_assert(sizeof(index_profile_key) == 48, "index_profile_key must not have padding");
+
+struct index_file_header
+{
+    char            magic[4];
+    uint32          version;
+    index_profile_key profile;
+    uint64          indexed_len;
+    uint64          tail_hash;
+    uint64          count;
+    column_position end;
+};
+
+static const char c_index_magic[4] = { 'W', 'C', 'W', 'X' };
+static const uint32 c_index_version = 2;
+
+//------------------------------------------------------------------------------
+static uint64 hash_bytes(const void* data, uint64 len)
+{
+    const uint8* const bytes = static_cast<const uint8*>(data);
+    uint64 h = 0xcbf29ce484222325ull;
+    for (uint64 i = 0; i < len; ++i)
+        h = (h ^ bytes[i]) * 0x100000001b3ull;
+    return h;
+}
+
+//------------------------------------------------------------------------------
+static uint64 hash_tail(const char* data, uint64 len)
+{
+    const uint64 begin = (len > c_tail_hash_len) ? len - c_tail_hash_len : 0;
+    return hash_bytes(data + begin, len - begin);
+}
+
+//------------------------------------------------------------------------------
+static void get_profile_key(const wcwidth_profile& profile, index_profile_key& key)
+{
+    memset(&key, 0, sizeof(key));
+    strncpy(key.name, profile.name, sizeof(key.name) - 1);
+    key.color_emoji = profile.color_emoji;
+    key.combining_mark_width = profile.combining_mark_width;
+    key.ambiguous_width = profile.ambiguous_width;
+    key.only_ucs2 = profile.builtin_only_ucs2;
+    key.cjk = profile.builtin_cjk;
+    key.win10 = profile.builtin_win10;
+    key.win11 = profile.builtin_win11;
+    key.emoji_index = profile.builtin_emoji_index;
+    if (profile.view)
+        key.tables_hash = hash_bytes(profile.view, profile.view_size);
+}
+
+//------------------------------------------------------------------------------
+column_index::column_index(uint32 interval, const wcwidth_profile* profile)
+: m_interval(max<uint32>(interval, 256))
+, m_profile(profile)
+{
+    clear();
+}
+
+//------------------------------------------------------------------------------
+void column_index::clear()
+{
+    m_checkpoints.clear();
+    m_checkpoints.push_back(column_position());
+    m_end = column_position();
+    m_generation = get_wcwidth_generation();
+}
+
+//------------------------------------------------------------------------------
+const wcwidth_profile* column_index::profile() const
+{
+    return m_profile ? m_profile : get_wcwidth_profile();
+}
+
+//------------------------------------------------------------------------------
+// Calls visit(before, end, width, newline) for each cluster from pos until
+// len, where before is the position of the cluster and end is the offset
+// after it.  If visit returns false, the scan stops and pos is the position
+// of that cluster; otherwise pos ends up at len.
+template <class T>
+void column_index::scan(const char* data, uint64 len, column_position& pos, const T& visit) const
+{
+    const wcwidth_profile* const p = profile();
+    while (pos.offset < len)
+    {
+        uint64 window_end = pos.offset + min<uint64>(len - pos.offset, c_max_window);
+        if (window_end < len)
+        {
+            // End the window where a cluster must begin, so that it doesn't
+            // split one.
+            const uint64 limit = max<uint64>(window_end - c_max_window_resync, pos.offset + 1);
+            for (uint64 split = window_end; split > limit; --split)
+            {
+                if (is_safe_cluster_boundary(data, data + split, data + len, *p))
+                {
+                    window_end = split;
+                    break;
+                }
+            }
+        }
+
+        wcwidth_iter iter(data + pos.offset, int32(window_end - pos.offset), p);
+        while (iter.next())
+        {
+            const uint64 end = uint64(iter.get_pointer() - data);
+            const bool newline = (*iter.character_pointer() == '\n');
+            const uint32 width = newline ? 0 : iter.character_wcwidth_onectrl();
+            if (!visit(pos, end, width, newline))
+                return;
+
+            pos.offset = end;
+            if (newline)
+            {
+                ++pos.line;
+                pos.column = 0;
+            }
+            else
+            {
+                pos.column += width;
+            }
+        }
+
+        // If the iterator stopped before the end of the window, it found a
+        // decoded NUL (or an incomplete sequence at the end); skip one byte.
+        if (pos.offset < window_end)
+        {
+            if (!visit(pos, pos.offset + 1, 0, false))
+                return;
+            ++pos.offset;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void column_index::update(const char* data, uint64 len)
+{
+    if (!m_profile && m_generation != get_wcwidth_generation())
+        clear();
+    if (len < m_end.offset)
+        clear();
+
+    const wcwidth_profile* const p = profile();
+    const char* const data_end = data + len;
+
+    // The clusters at the end of the previous update might continue into
+    // the new data, so rescan from the last checkpoint.
+    column_position pos = m_checkpoints.back();
+    uint64 next_checkpoint = pos.offset + m_interval;
+
+    scan(data, len, pos, [&](const column_position& before, uint64, uint32, bool)
+    {
+        if (before.offset >= next_checkpoint && is_safe_cluster_boundary(data, data + before.offset, data_end, *p))
+        {
+            m_checkpoints.push_back(before);
+            next_checkpoint = before.offset + m_interval;
+        }
+        return true;
+    });
+
+    m_end = pos;
+}
+
+//------------------------------------------------------------------------------
+column_position column_index::find_offset(const char* data, uint64 offset) const
+{
+    if (offset >= m_end.offset)
+        return m_end;
+
+    auto it = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), offset,
+                               [](uint64 offset, const column_position& checkpoint)
+                               {
+                                   return offset < checkpoint.offset;
+                               });
+
+    column_position pos = *(it - 1);
+    scan(data, m_end.offset, pos, [&](const column_position&, uint64 end, uint32, bool)
+    {
+        return end <= offset;
+    });
+    return pos;
+}
+
+//------------------------------------------------------------------------------
+bool column_index::find_column(const char* data, uint64 line, uint64 column, column_position& pos) const
+{
+    if (line > m_end.line)
+        return false;
+
+    auto it = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), column_position { 0, line, column },
+                               [](const column_position& target, const column_position& checkpoint)
+                               {
+                                   if (target.line != checkpoint.line)
+                                       return target.line < checkpoint.line;
+                                   return target.column < checkpoint.column;
+                               });
+
+    pos = *(it - 1);
+    scan(data, m_end.offset, pos, [&](const column_position& before, uint64, uint32 width, bool newline)
+    {
+        if (before.line < line)
+            return true;
+        return !newline && before.column + width <= column;
+    });
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool column_index::save(const char* path, const char* data) const
+{
+    index_file_header header = {};
+    memcpy(header.magic, c_index_magic, sizeof(header.magic));
+    header.version = c_index_version;
+    get_profile_key(*profile(), header.profile);
+    header.indexed_len = m_end.offset;
+    header.tail_hash = hash_tail(data, m_end.offset);
+    header.count = m_checkpoints.size();
+    header.end = m_end;
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(m_checkpoints.data(), sizeof(m_checkpoints[0]), m_checkpoints.size(), file);
+
+    const bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool column_index::load(const char* path, const char* data, uint64 len)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    // The index is stale if anything about the profile that affects widths
+    // has changed since it was saved.
+    index_profile_key key;
+    get_profile_key(*profile(), key);
+
+    index_file_header header;
+    bool ok = (fread(&header, sizeof(header), 1, file) == 1 &&
+               memcmp(header.magic, c_index_magic, sizeof(header.magic)) == 0 &&
+               header.version == c_index_version &&
+               memcmp(&header.profile, &key, sizeof(key)) == 0 &&
+               header.indexed_len <= len &&
+               header.end.offset == header.indexed_len &&
+               header.count > 0 && header.count <= header.indexed_len / 256 + 1 &&
+               header.tail_hash == hash_tail(data, header.indexed_len));
+
+    std::vector<column_position> checkpoints;
+    if (ok)
+    {
+        checkpoints.resize(size_t(header.count));
+        ok = (fread(checkpoints.data(), sizeof(checkpoints[0]), checkpoints.size(), file) == checkpoints.size() &&
+              checkpoints.front().offset == 0 &&
+              checkpoints.back().offset <= header.indexed_len);
+    }
+    fclose(file);
+
+    if (!ok)
+        return false;
+
+    m_checkpoints = std::move(checkpoints);
+    m_end = header.end;
+    m_generation = get_wcwidth_generation();
+    return true;
+}
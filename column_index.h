@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// A position in a buffer:  the byte offset of a cluster, the logical line it's
+// on (lines end at '\n'), and the column where it starts (the sum of the
+// widths of the preceding clusters on the line, counted like wcswidth()).
+struct column_position
+{
+    uint64          offset = 0;
+    uint64          line = 0;
+    uint64          column = 0;
+};
+
+//------------------------------------------------------------------------------
+// Maps byte offsets to line/column and back in very large buffers, without
+// rescanning from the beginning.
+//
+// The index stores a checkpoint roughly every interval bytes.  Checkpoints are
+// only placed where a cluster must begin no matter what precedes it (see
+// is_safe_cluster_boundary()), so a scan can resume from a checkpoint without
+// any other iterator state.  Queries binary search the checkpoints and then
+// rescan at most about interval bytes.
+//
+// The index doesn't own the buffer; the caller passes it to update() and to
+// queries.  The indexed part of the buffer must not change, but more data
+// can be appended; update() rescans only from the last checkpoint, since a
+// cluster at the old end could continue into the new data.
+//
+// A decoded NUL (a NUL byte, or a stray byte that decodes as NUL) would end a
+// wcwidth_iter scan, so the index counts it as a zero width byte and
+// continues.
+class column_index
+{
+public:
+    explicit        column_index(uint32 interval=4096, const wcwidth_profile* profile=nullptr);
+    void            clear();
+    void            update(const char* data, uint64 len);
+    uint64          indexed_length() const { return m_end.offset; }
+    uint64          line_count() const { return m_end.line + 1; }
+    uint32          checkpoint_count() const { return uint32(m_checkpoints.size()); }
+
+    // Returns the position of the cluster that contains offset.  Offsets past
+    // the indexed length return the position at the end.
+    column_position find_offset(const char* data, uint64 offset) const;
+
+    // Finds the cluster on line that covers column.  When column is past the
+    // end of the line, this returns the position of the line's '\n' (or the
+    // end of the buffer).  Returns false if the line doesn't exist.
+    bool            find_column(const char* data, uint64 line, uint64 column, column_position& pos) const;
+
+    // Saves the index to a file.  load() fails if the file doesn't match
+    // data (it checks the indexed length and a hash of the indexed tail), or
+    // was built with a profile that has a different name, modes, OS version,
+    // emoji version, or tables; the caller can then rebuild.  After
+    // loading, update() indexes any data appended since the index was saved.
+    bool            save(const char* path, const char* data) const;
+    bool            load(const char* path, const char* data, uint64 len);
+
+private:
+    const wcwidth_profile* profile() const;
+    template <class T>
+    void            scan(const char* data, uint64 len, column_position& pos, const T& visit) const;
+
+    const uint32    m_interval;
+    const wcwidth_profile* const m_profile;
+    uint32          m_generation = 0;
+    std::vector<column_position> m_checkpoints;
+    column_position m_end;
+};
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "context_matrix.h"
+
+// How many marks are shown in each group of columns.
+static const uint32 c_columns_per_group = 64;
+
+//------------------------------------------------------------------------------
+void context_matrix::init(const std::vector<char32_t>& bases, const std::vector<char32_t>& marks, const wcwidth_profile* profile)
+{
+    m_bases = bases;
+    m_marks = marks;
+
+    const uint32 count = base_count() * mark_count();
+    m_expected.resize(count);
+    m_actual.assign(count, -1);
+
+    std::string text;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        text.clear();
+        append_text(i, text);
+        m_expected[i] = int8(wcswidth(text.c_str(), uint32(text.length()), profile));
+    }
+}
+
+//------------------------------------------------------------------------------
+void context_matrix::append_text(uint32 index, std::string& out) const
+{
+    char utf8[8];
+    out.append(utf8, to_utf8(base(index), utf8));
+    out.append(utf8, to_utf8(mark(index), utf8));
+}
+
+//------------------------------------------------------------------------------
+uint32 context_matrix::mismatch_count() const
+{
+    uint32 count = 0;
+    for (uint32 i = 0; i < pair_count(); ++i)
+        count += (m_actual[i] >= 0 && m_actual[i] != m_expected[i]);
+    return count;
+}
+
+//------------------------------------------------------------------------------
+void context_matrix::print_table(FILE* out, bool all_rows) const
+{
+    static const char c_hex[] = "0123456789ABCDEF";
+
+    const uint32 marks = mark_count();
+    for (uint32 group = 0; group < marks; group += c_columns_per_group)
+    {
+        const uint32 end = min(group + c_columns_per_group, marks);
+
+        // Find the rows to print before printing the header.
+        std::vector<uint32> rows;
+        for (uint32 b = 0; b < base_count(); ++b)
+        {
+            bool mismatch = false;
+            for (uint32 m = group; m < end && !mismatch; ++m)
+            {
+                const uint32 i = b * marks + m;
+                mismatch = (m_actual[i] >= 0 && m_actual[i] != m_expected[i]);
+            }
+            if (all_rows || mismatch)
+                rows.push_back(b);
+        }
+        if (rows.empty())
+            continue;
+
+        fprintf(out, "\n        Marks %04X .. %04X\n        ", uint32(m_marks[group]), uint32(m_marks[end - 1]));
+        for (uint32 m = group; m < end; ++m)
+            fputc(c_hex[m_marks[m] & 0xf], out);
+        fputs("\n", out);
+
+        for (uint32 b : rows)
+        {
+            fprintf(out, "  %04X  ", uint32(m_bases[b]));
+            for (uint32 m = group; m < end; ++m)
+            {
+                const uint32 i = b * marks + m;
+                if (m_actual[i] < 0)
+                    fputc(' ', out);
+                else if (m_actual[i] == m_expected[i])
+                    fputc('.', out);
+                else
+                    fputc(c_hex[min<int32>(m_actual[i], 15)], out);
+            }
+            fputs("\n", out);
+        }
+    }
+}
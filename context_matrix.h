@@ -0,0 +1,45 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+
+struct wcwidth_profile;
+
+//------------------------------------------------------------------------------
+// The results of measuring every pair of a set of base codepoints and a set of
+// mark (or other context) codepoints, such as how each combining mark affects
+// the width of each base character.
+//
+// Pairs are numbered row by row:  pair index = base index * mark_count() +
+// mark index.  The expected width of each pair is wcswidth() of the base
+// followed by the mark.
+class context_matrix
+{
+public:
+    void            init(const std::vector<char32_t>& bases, const std::vector<char32_t>& marks, const wcwidth_profile* profile=nullptr);
+    uint32          base_count() const { return uint32(m_bases.size()); }
+    uint32          mark_count() const { return uint32(m_marks.size()); }
+    uint32          pair_count() const { return uint32(m_expected.size()); }
+    char32_t        base(uint32 index) const { return m_bases[index / mark_count()]; }
+    char32_t        mark(uint32 index) const { return m_marks[index % mark_count()]; }
+    void            append_text(uint32 index, std::string& out) const;
+    int32           expected(uint32 index) const { return m_expected[index]; }
+    int32           actual(uint32 index) const { return m_actual[index]; }
+    void            set_actual(uint32 index, int32 width) { m_actual[index] = int8(width); }
+    uint32          mismatch_count() const;
+
+    // Prints the results as a table with one row per base and one column per
+    // mark:  '.' where the measured width matches the expected width, or the
+    // measured width where it doesn't.  The columns are split into groups of
+    // 64 marks, each with a header showing the last hex digit of each mark.
+    // Unless all_rows is true, only rows with mismatches are printed.
+    void            print_table(FILE* out, bool all_rows) const;
+
+private:
+    std::vector<char32_t> m_bases;
+    std::vector<char32_t> m_marks;
+    std::vector<int8> m_expected;
+    std::vector<int8> m_actual;             // -1 until measured.
+};
@@ -0,0 +1,272 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "dbcs_width.h"
+
+#include <mutex>
+
+// Tables are kept for this many code page and profile combinations; older
+// ones are released once no iterator is using them.
+static const uint32 c_max_tables = 8;
+
+// Marks a byte pair where the lead byte is a character by itself, and the
+// trail byte begins the next character.
+static const int8 c_unpaired = -128;
+
+//------------------------------------------------------------------------------
+// Lead bytes are always 0x81 or above in the supported code pages, so the
+// byte pair table is indexed by the low 7 bits of the lead byte and the trail
+// byte.  Widths are signed, where -1 means a control character.  Converters
+// differ in whether an invalid trail byte is consumed along with the lead
+// byte; the tables record what the code page's converter actually does.
+struct dbcs_width_table
+{
+    UINT            cp;
+    wcwidth_profile profile;                // Copy of the profile the widths came from.
+    bool            lead[256];
+    int8            single[256];            // Also used for a lead byte at the end of the text.
+    int8            pair[128 * 256];
+};
+
+static std::mutex s_tables_mutex;
+static std::vector<std::shared_ptr<const dbcs_width_table>> s_tables;
+static thread_local std::shared_ptr<const dbcs_width_table> s_last_table;
+
+//------------------------------------------------------------------------------
+bool is_dbcs_width_codepage(UINT cp)
+{
+    return is_CJK_codepage(cp);
+}
+
+//------------------------------------------------------------------------------
+// Converts the bytes the same way converted_wcswidth() does, and measures the
+// result.  When the bytes convert to a single cluster, this returns its signed
+// width; otherwise (such as an invalid byte pair that converts to a default
+// character plus the trail byte) it returns the total width.
+static int32 measure_bytes(UINT cp, const char* bytes, int32 len, const wcwidth_profile& profile)
+{
+    WCHAR wide[8];
+    const int32 wide_len = MultiByteToWideChar(cp, 0, bytes, len, wide, _countof(wide));
+    if (wide_len <= 0)
+        return 1;
+
+    char utf8[32];
+    const int32 utf8_len = WideCharToMultiByte(CP_UTF8, 0, wide, wide_len, utf8, sizeof(utf8), nullptr, nullptr);
+    if (utf8_len <= 0)
+        return 1;
+
+    wcwidth_iter iter(utf8, utf8_len, &profile);
+    if (!iter.next())
+        return 0;
+
+    const int32 first = iter.character_wcwidth_signed();
+    if (!iter.more())
+        return first;
+
+    uint32 width = iter.character_wcwidth_onectrl();
+    while (iter.next())
+        width += iter.character_wcwidth_onectrl();
+    return int32(width);
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the converter rejects the byte pair and converts the lead
+// byte and the trail byte separately.
+static bool is_unpaired(UINT cp, const char* bytes)
+{
+    WCHAR wide[8];
+    if (MultiByteToWideChar(cp, MB_ERR_INVALID_CHARS, bytes, 2, wide, _countof(wide)) > 0)
+        return false;
+    return MultiByteToWideChar(cp, 0, bytes, 2, wide, _countof(wide)) > 1;
+}
+
+//------------------------------------------------------------------------------
+static std::shared_ptr<const dbcs_width_table> build_table(UINT cp, const wcwidth_profile& profile)
+{
+    std::shared_ptr<dbcs_width_table> table = std::make_shared<dbcs_width_table>();
+    table->cp = cp;
+    table->profile = profile;
+
+    for (uint32 b = 0; b < 256; ++b)
+    {
+        const char c = char(b);
+        table->lead[b] = (b >= 0x80 && IsDBCSLeadByteEx(cp, BYTE(b)));
+        table->single[b] = b ? int8(measure_bytes(cp, &c, 1, profile)) : 0;
+    }
+
+    memset(table->pair, 1, sizeof(table->pair));
+    for (uint32 lead = 0x80; lead < 256; ++lead)
+    {
+        if (!table->lead[lead])
+            continue;
+
+        // A NUL byte ends the text instead of being a trail byte, so the
+        // entry for trail byte 0 is never used.
+        int8* const row = table->pair + ((lead & 0x7f) << 8);
+        for (uint32 trail = 1; trail < 256; ++trail)
+        {
+            const char bytes[2] = { char(lead), char(trail) };
+            row[trail] = is_unpaired(cp, bytes) ? c_unpaired : int8(measure_bytes(cp, bytes, 2, profile));
+        }
+    }
+
+    return table;
+}
+
+//------------------------------------------------------------------------------
+// Compares the fields that identify a profile's widths; a loaded profile's
+// tables are identified by where they're mapped.
+static bool table_matches(const dbcs_width_table& table, UINT cp, const wcwidth_profile& profile)
+{
+    const wcwidth_profile& p = table.profile;
+    return (table.cp == cp &&
+            strcmp(p.name, profile.name) == 0 &&
+            p.color_emoji == profile.color_emoji &&
+            p.combining_mark_width == profile.combining_mark_width &&
+            p.ambiguous_width == profile.ambiguous_width &&
+            p.builtin_only_ucs2 == profile.builtin_only_ucs2 &&
+            p.builtin_cjk == profile.builtin_cjk &&
+            p.builtin_win10 == profile.builtin_win10 &&
+            p.builtin_win11 == profile.builtin_win11 &&
+            p.builtin_emoji_index == profile.builtin_emoji_index &&
+            p.stage1 == profile.stage1 &&
+            p.stage2 == profile.stage2 &&
+            p.view == profile.view &&
+            p.view_size == profile.view_size);
+}
+
+//------------------------------------------------------------------------------
+// The tables are immutable once built, so they're shared between threads.
+// Each thread remembers the last table it used, which avoids the lock when
+// measuring many strings in the same code page.
+static std::shared_ptr<const dbcs_width_table> get_table(UINT cp, const wcwidth_profile& profile)
+{
+    if (s_last_table && table_matches(*s_last_table, cp, profile))
+        return s_last_table;
+
+    std::lock_guard<std::mutex> lock(s_tables_mutex);
+
+    for (const auto& table : s_tables)
+    {
+        if (table_matches(*table, cp, profile))
+        {
+            s_last_table = table;
+            return table;
+        }
+    }
+
+    if (s_tables.size() >= c_max_tables)
+        s_tables.erase(s_tables.begin());
+    s_tables.push_back(build_table(cp, profile));
+    s_last_table = s_tables.back();
+    return s_last_table;
+}
+
+//------------------------------------------------------------------------------
+dbcs_width_iter::dbcs_width_iter(UINT cp, const char* s, int32 len, const wcwidth_profile* profile)
+: m_ptr(s)
+, m_end(s + ((len < 0) ? strlen(s) : len))
+, m_chr_ptr(s)
+, m_chr_end(s)
+{
+    if (is_dbcs_width_codepage(cp))
+    {
+        wcwidth_reader_scope reader;
+        m_table = get_table(cp, profile ? *profile : *get_wcwidth_profile());
+    }
+    else
+    {
+        m_end = m_ptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool dbcs_width_iter::next()
+{
+    m_chr_ptr = m_ptr;
+
+    if (m_ptr >= m_end || !*m_ptr)
+    {
+        m_chr_end = m_ptr;
+        m_chr_wcwidth = 0;
+        return false;
+    }
+
+    const uint8 c = uint8(*(m_ptr++));
+    int32 w = c_unpaired;
+    if (m_table->lead[c] && m_ptr < m_end && *m_ptr)
+    {
+        w = m_table->pair[((c & 0x7f) << 8) | uint8(*m_ptr)];
+        if (w != c_unpaired)
+            ++m_ptr;
+    }
+    m_chr_wcwidth = (w != c_unpaired) ? w : m_table->single[c];
+
+    m_chr_end = m_ptr;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+uint32 dbcs_wcswidth(UINT cp, const char* s, uint32 len, const wcwidth_profile* profile)
+{
+    if (!is_dbcs_width_codepage(cp))
+        return converted_wcswidth(cp, s, len, profile);
+
+    std::shared_ptr<const dbcs_width_table> table;
+    {
+        wcwidth_reader_scope reader;
+        table = get_table(cp, profile ? *profile : *get_wcwidth_profile());
+    }
+
+    // Same as dbcs_width_iter, but without the per-character bookkeeping.
+    const bool* const lead = table->lead;
+    const int8* const single = table->single;
+    const int8* const pair = table->pair;
+
+    uint32 count = 0;
+    const char* const end = s + len;
+    while (s < end && *s)
+    {
+        const uint8 c = uint8(*(s++));
+        int32 w = c_unpaired;
+        if (lead[c] && s < end && *s)
+        {
+            w = pair[((c & 0x7f) << 8) | uint8(*s)];
+            if (w != c_unpaired)
+                ++s;
+        }
+        if (w == c_unpaired)
+            w = single[c];
+        count += (w < 0) ? 1 : w;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+uint32 converted_wcswidth(UINT cp, const char* s, uint32 len, const wcwidth_profile* profile)
+{
+    // A NUL byte ends the text; it's never a trail byte in a DBCS code page.
+    const char* nul = static_cast<const char*>(memchr(s, 0, len));
+    if (nul)
+        len = uint32(nul - s);
+    if (!len)
+        return 0;
+
+    const int32 wide_len = MultiByteToWideChar(cp, 0, s, int32(len), nullptr, 0);
+    if (wide_len <= 0)
+        return 0;
+    std::vector<WCHAR> wide(wide_len);
+    MultiByteToWideChar(cp, 0, s, int32(len), wide.data(), wide_len);
+
+    const int32 utf8_len = WideCharToMultiByte(CP_UTF8, 0, wide.data(), wide_len, nullptr, 0, nullptr, nullptr);
+    if (utf8_len <= 0)
+        return 0;
+    std::vector<char> utf8(utf8_len);
+    WideCharToMultiByte(CP_UTF8, 0, wide.data(), wide_len, utf8.data(), utf8_len, nullptr, nullptr);
+
+    return wcswidth(utf8.data(), uint32(utf8_len), profile);
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <memory>
+
+struct wcwidth_profile;
+struct dbcs_width_table;
+
+//------------------------------------------------------------------------------
+// Returns true if the code page is one of the DBCS code pages that support
+// direct width computation (932, 936, 949, and 950).
+bool is_dbcs_width_codepage(UINT cp);
+
+//------------------------------------------------------------------------------
+// Iterates over the characters in text encoded in a DBCS code page, and
+// reports their widths without converting the text to Unicode.
+//
+// The widths come from tables for the code page:  which bytes are lead bytes,
+// the width of each single byte, and the width of each lead/trail byte pair.
+// The tables are generated the first time a code page is used with a given
+// profile, by converting every byte and byte pair with MultiByteToWideChar
+// and measuring the result with the profile.  After that, a character costs
+// one or two table lookups; most byte pairs simply have width 2.
+//
+// Each character is measured by itself.  DBCS code pages have no emoji
+// sequences, and zero width characters add nothing either way, so the total
+// matches wcswidth() of the text converted to UTF-8.
+//
+// A NUL byte ends the text, and a lead byte at the end of the text is a
+// character by itself.  If the code page isn't supported, next() always
+// returns false and valid() returns false.
+class dbcs_width_iter
+{
+public:
+                    dbcs_width_iter(UINT cp, const char* s, int32 len=-1, const wcwidth_profile* profile=nullptr);
+    bool            next();
+    const char*     character_pointer() const { return m_chr_ptr; }
+    uint32          character_length() const { return uint32(m_chr_end - m_chr_ptr); }
+    int32           character_wcwidth_signed() const { return m_chr_wcwidth; }
+    uint32          character_wcwidth_zeroctrl() const { return (m_chr_wcwidth < 0) ? 0 : m_chr_wcwidth; }
+    uint32          character_wcwidth_onectrl() const { return (m_chr_wcwidth < 0) ? 1 : m_chr_wcwidth; }
+    uint32          character_wcwidth_twoctrl() const { return (m_chr_wcwidth < 0) ? 2 : m_chr_wcwidth; }
+    const char*     get_pointer() const { return m_ptr; }
+    bool            more() const { return m_ptr < m_end && *m_ptr; }
+    bool            valid() const { return !!m_table; }
+
+private:
+    std::shared_ptr<const dbcs_width_table> m_table;
+    const char*     m_ptr;
+    const char*     m_end;
+    const char*     m_chr_ptr;
+    const char*     m_chr_end;
+    int32           m_chr_wcwidth = 0;
+};
+
+//------------------------------------------------------------------------------
+// Same result as converted_wcswidth(), but uses the DBCS width tables when the
+// code page is supported.  When profile is nullptr, the active profile is
+// used.
+uint32 dbcs_wcswidth(UINT cp, const char* s, uint32 len, const wcwidth_profile* profile=nullptr);
+
+// Converts the text from the code page to UTF-8 and returns its wcswidth().
+// This works for any code page, and is the reference for dbcs_wcswidth().
+uint32 converted_wcswidth(UINT cp, const char* s, uint32 len, const wcwidth_profile* profile=nullptr);
@@ -0,0 +1,241 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "dsr_pipeline.h"
+
+// How long to wait for more replies before giving up on the terminal.
+static const DWORD c_reply_timeout = 2000;
+
+enum : uint8 { parse_ground, parse_escape, parse_csi };
+
+//------------------------------------------------------------------------------
+dsr_pipeline::dsr_pipeline(HANDLE hout, HANDLE hin, uint32 window)
+: m_hout(hout)
+, m_hin(hin)
+, m_window(max<uint32>(window, 1))
+{
+}
+
+//------------------------------------------------------------------------------
+dsr_pipeline::~dsr_pipeline()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+// The output has to process VT sequences and UTF-8 text, and the input has to
+// deliver the replies as VT sequences without waiting for Enter or echoing
+// them.
+bool dsr_pipeline::open()
+{
+    if (m_open)
+        return true;
+
+    if (!GetConsoleMode(m_hout, &m_out_mode) || !GetConsoleMode(m_hin, &m_in_mode))
+        return false;
+
+    const DWORD out_mode = m_out_mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    const DWORD in_mode = (m_in_mode & ~(ENABLE_LINE_INPUT|ENABLE_ECHO_INPUT|ENABLE_PROCESSED_INPUT)) | ENABLE_VIRTUAL_TERMINAL_INPUT;
+    if (!SetConsoleMode(m_hout, out_mode))
+        return false;
+    if (!SetConsoleMode(m_hin, in_mode))
+    {
+        SetConsoleMode(m_hout, m_out_mode);
+        return false;
+    }
+
+    m_out_cp = GetConsoleOutputCP();
+    SetConsoleOutputCP(CP_UTF8);
+
+    FlushConsoleInputBuffer(m_hin);
+    m_state = parse_ground;
+    m_open = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void dsr_pipeline::close()
+{
+    if (!m_open)
+        return;
+
+    // Discard any replies that arrived after a failed run().
+    FlushConsoleInputBuffer(m_hin);
+    SetConsoleMode(m_hin, m_in_mode);
+    SetConsoleMode(m_hout, m_out_mode);
+    SetConsoleOutputCP(m_out_cp);
+    m_open = false;
+}
+
+//------------------------------------------------------------------------------
+void dsr_pipeline::add_text(const char* s, uint32 len)
+{
+    m_queued.append(s, len);
+}
+
+//------------------------------------------------------------------------------
+void dsr_pipeline::add_query()
+{
+    m_queued.append("\x1b[6n");
+    m_query_ends.push_back(uint32(m_queued.length()));
+}
+
+//------------------------------------------------------------------------------
+bool dsr_pipeline::run(std::vector<COORD>& positions)
+{
+    positions.clear();
+    if (!m_open)
+    {
+        clear();
+        return false;
+    }
+
+    const uint32 count = query_count();
+    positions.reserve(count);
+
+    // Each time replies arrive, the window slides forward and everything up
+    // to the last query inside the window is sent in one write.
+    uint32 sent = 0;
+    uint32 sent_queries = 0;
+    while (positions.size() < count)
+    {
+        const uint32 limit = min<uint32>(count, uint32(positions.size()) + m_window);
+        if (sent_queries < limit)
+        {
+            const uint32 end = m_query_ends[limit - 1];
+            if (!write(m_queued.c_str() + sent, end - sent))
+                break;
+            sent = end;
+            sent_queries = limit;
+        }
+
+        if (!read_replies(positions, sent_queries))
+            break;
+    }
+
+    const bool ok = (positions.size() == count);
+    if (ok && sent < m_queued.length())
+        write(m_queued.c_str() + sent, uint32(m_queued.length()) - sent);
+
+    clear();
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool dsr_pipeline::write(const char* s, uint32 len)
+{
+    while (len)
+    {
+        DWORD written = 0;
+        if (!WriteFile(m_hout, s, len, &written, nullptr) || !written)
+            return false;
+        s += written;
+        len -= written;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Waits for input, and parses the replies in all of the input records that
+// are available.  Returns false if no key input arrives before the timeout.
+//
+// The replies are read as input records instead of with ReadFile(), because
+// ReadFile() blocks on records that have no text (such as focus, mouse, or
+// buffer size events), and because it translates keys the user presses into
+// VT sequences:  a modified F3 key becomes CSI 1;nR, which is the same as a
+// Cursor Position Report for row 1.  In the records, the terminal's replies
+// are characters, while a key like F3 only has a virtual key code, so only
+// the characters of key down events are parsed.
+bool dsr_pipeline::read_replies(std::vector<COORD>& positions, uint32 expected)
+{
+    const DWORD began = GetTickCount();
+    while (true)
+    {
+        INPUT_RECORD records[256];
+        DWORD count = 0;
+        if (!PeekConsoleInputW(m_hin, records, _countof(records), &count))
+            return false;
+
+        if (!count)
+        {
+            const DWORD elapsed = GetTickCount() - began;
+            if (elapsed >= c_reply_timeout)
+                return false;
+            WaitForSingleObject(m_hin, c_reply_timeout - elapsed);
+            continue;
+        }
+
+        if (!ReadConsoleInputW(m_hin, records, count, &count))
+            return false;
+
+        bool any_keys = false;
+        for (DWORD i = 0; i < count; ++i)
+        {
+            if (records[i].EventType != KEY_EVENT)
+                continue;
+            const KEY_EVENT_RECORD& key = records[i].Event.KeyEvent;
+            if (!key.bKeyDown || !key.uChar.UnicodeChar)
+                continue;
+
+            // Replies are ASCII; anything else ends a reply in progress.
+            const WCHAR c = key.uChar.UnicodeChar;
+            for (WORD repeat = max<WORD>(key.wRepeatCount, 1); repeat--;)
+                parse((c < 0x80) ? char(c) : '\0', positions, expected);
+            any_keys = true;
+        }
+
+        if (any_keys)
+            return true;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Anything other than a Cursor Position Report (such as keys the user typed)
+// is ignored, and so are reports beyond the number of queries sent.
+void dsr_pipeline::parse(char c, std::vector<COORD>& positions, uint32 expected)
+{
+    switch (m_state)
+    {
+    case parse_ground:
+        if (c == '\x1b')
+            m_state = parse_escape;
+        break;
+
+    case parse_escape:
+        if (c == '[')
+        {
+            m_params[0] = m_params[1] = 0;
+            m_param = 0;
+            m_state = parse_csi;
+        }
+        else if (c != '\x1b')
+        {
+            m_state = parse_ground;
+        }
+        break;
+
+    case parse_csi:
+        if (c >= '0' && c <= '9')
+        {
+            m_params[m_param] = min<uint32>(m_params[m_param] * 10 + (c - '0'), 0x7fff);
+            break;
+        }
+        if (c == ';' && m_param == 0)
+        {
+            m_param = 1;
+            break;
+        }
+        if (c == 'R' && m_param == 1 && m_params[0] && m_params[1] && positions.size() < expected)
+            positions.push_back({ SHORT(m_params[1] - 1), SHORT(m_params[0] - 1) });
+        m_state = (c == '\x1b') ? parse_escape : parse_ground;
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void dsr_pipeline::clear()
+{
+    m_queued.clear();
+    m_query_ends.clear();
+}
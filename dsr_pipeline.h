@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+
+//------------------------------------------------------------------------------
+// Measures cursor positions in a terminal by sending Device Status Report
+// queries (CSI 6n) and reading the Cursor Position Report replies (CSI row;col
+// R) from the input handle.  This works in any terminal that supports VT
+// sequences, including when wcwv runs inside a pty (such as over ssh), where
+// GetConsoleScreenBufferInfo() only sees the pseudo console.
+//
+// Waiting for each reply before sending the next query makes the measurements
+// bound by the round trip latency.  Instead, text and queries are queued with
+// add_text() and add_query(), and run() sends them back to back while reading
+// the replies as they arrive; replies come back in the same order as the
+// queries, so they're matched to the queries by counting.
+//
+// The window limits how many queries can be outstanding at once.  That keeps
+// the replies from overflowing the terminal's input queue; a window of 1 is
+// the same as waiting for each reply.
+class dsr_pipeline
+{
+public:
+                    dsr_pipeline(HANDLE hout, HANDLE hin, uint32 window=64);
+                    ~dsr_pipeline();
+    bool            open();
+    void            close();
+    uint32          window() const { return m_window; }
+    void            set_window(uint32 window) { m_window = max<uint32>(window, 1); }
+    void            add_text(const char* s, uint32 len);
+    void            add_query();
+    uint32          query_count() const { return uint32(m_query_ends.size()); }
+
+    // Sends everything that was queued, and fills positions with the cursor
+    // position (0-based) reported for each query.  Returns false if writing
+    // fails or the terminal stops replying.  Either way, the queue is empty
+    // afterwards.
+    bool            run(std::vector<COORD>& positions);
+
+private:
+    bool            write(const char* s, uint32 len);
+    bool            read_replies(std::vector<COORD>& positions, uint32 expected);
+    void            parse(char c, std::vector<COORD>& positions, uint32 expected);
+    void            clear();
+
+    const HANDLE    m_hout;
+    const HANDLE    m_hin;
+    uint32          m_window;
+    DWORD           m_out_mode = 0;
+    DWORD           m_in_mode = 0;
+    UINT            m_out_cp = 0;
+    bool            m_open = false;
+    std::string     m_queued;
+    std::vector<uint32> m_query_ends;       // Offset in m_queued after each query.
+
+    // Reply parser.
+    uint8           m_state = 0;
+    uint32          m_params[2] = {};
+    uint32          m_param = 0;
+};
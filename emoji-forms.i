@@ -4451,3 +4451,753 @@ static const emoji_form_sequence emoji_forms[] = {
 { 0x1FAF8, "\xf0\x9f\xab\xb8\xf0\x9f\x8f\xbf", "E15.0 RIGHTWARDS PUSHING HAND: DARK SKIN TONE" },
 
 };
+
+static const int32 emoji_forms_ucs_disp[] = {
+
+2, 0, 3, -1, 0, 5, 5, 3, -3, 0, 0, -14, -15, 0, -18, 1,
+-21, 0, 4, 0, 0, 0, 1, 0, 1, 0, 0, 3, 1, 0, 2, 2,
+-29, -33, 3, 0, 0, 0, 0, -34, 0, 0, -40, -43, 0, -49, 0, 0,
+-52, -55, -57, -62, -63, 0, -64, 1, -69, 0, -73, 0, 1, 1, 0, 0,
+0, -74, -76, 0, 3, 0, 4, 0, 0, -78, 1, 0, 0, 0, -82, -86,
+3, 1, 2, -88, 2, 0, 6, -89, 0, 0, 0, 0, 1, 0, 0, 1,
+-90, -102, 1, -106, -109, -114, -116, 0, 0, 0, 0, 0, 0, 0, -117, -118,
+0, -119, -121, -123, 0, -124, -126, 3, 1, 0, 0, 0, -128, 0, 2, 0,
+0, -134, 1, 0, -135, 1, -136, -138, 1, 0, -140, 0, -141, 0, 0, -142,
+0, 2, -144, 0, -145, 0, 0, -146, -147, -151, -152, -153, 0, 0, 1, 0,
+1, 0, 0, -155, 3, -157, -160, -162, -167, -168, 2, 0, 0, 1, -169, 0,
+0, -170, 0, 0, 2, 0, 1, 2, 0, 2, -175, -176, -177, -179, -180, 0,
+2, 0, -183, 1, -191, -197, 2, 0, -200, 3, 1, -204, -207, 1, 0, 8,
+0, 3, 1, -208, 0, -209, 1, 0, 2, 3, 0, 2, 2, -212, 1, -214,
+0, -216, 1, 0, -221, 1, -222, -223, -225, -226, -227, 4, 0, -228, 8, 2,
+-229, 2, 0, -232, 0, 0, 1, 0, -236, 0, 0, 1, 0, 1, -237, 0,
+0, -238, 4, 2, 4, 1, 0, 1, 0, -239, -242, 0, 0, -245, 0, -246,
+-247, 2, 0, 1, -248, 0, 3, -251, 0, 0, -256, 0, -260, 2, -261, -262,
+-264, 0, -269, 1, 0, -274, -276, -277, 0, 4, 3, 0, 0, 2, 0, -281,
+-284, 0, 0, -285, 0, 3, -286, -291, 3, 1, -294, 0, -296, -300, 0, 0,
+-301, 0, -313, -318, 0, 1, -321, -327, -330, 1, 0, 1, -331, 0, 0, -335,
+0, 1, 2, 0, 0, 2, 0, 1, 1, -336, 0, -337, -339, 1, -341, -342,
+-346, 2, 0, -349, 0, -351, 0, 0, 0, 0, 1, 1, -355, -357, -359, 0,
+0, 2, 0, -362, -365, 0, -367, 1, 2, -368, -369, -370, -373, 1, 0, 0,
+-375, -376, 1, 0, 0, 0, 4, 3, 0, 1, 0, 5, 2, 1, 0, -377,
+-381, 0, 0, -387, 0, 0, 0, 0, -388, 1, 0, -389, -391, -397, 0, 1,
+-399, 0, 0, -402, -405, 1, 0, -406, -409, 5, 0, -410, 1, -413, 0, 1,
+0, 1, -417, -419, 7, -424, 0, 0, -428, 4, 0, 3, 0, -429, -434, -438,
+1, -439, 0, 0, -440, 3, 0, 1, 3, 0, -449, 0, 3, 5, 0, 0,
+0, 1, 0, -450, 1, -457, -459, 3, -461, -465, 0, 1, -468, 1, 0, 0,
+1, 0, 0, -470, -471, 0, -472, -475, -476, 2, -478, -479, 3, 1, 0, -483,
+-487, -488, 0, 1, 0, 6, -489, -493, -495, 1, -496, 0, 1, -502, 0, -504,
+-507, 0, 1, 0, 0, -508, -512, -515, 2, 1, -517, -519, 1, -521, 1, -528,
+0, -529, 0, 0, -530, 2, 0, -532, -535, -544, -547, 0, 0, -548, -553, -557,
+0, 0, 1, 0, 1, 2, 0, -559, 9, -561, 5, 0, 2, -567, 1, 0,
+8, -568, 0, 0, -569, 0, 0, 0, -571, 0, -574, -577, 0, 2, 3, 0,
+-580, -583, -589, 0, 1, -595, 0, 0, 0, 0, -608, 0, -610, -616, -617, -620,
+-633, 2, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, -635, -638, -640, -641,
+2, -642, -644, 3, 0, 0, -648, 0, -650, 0, 0, -652, 3, 0, 0, 9,
+11, -654, 1, -655, -656, 1, -658, 0, 6, 1, 0, 0, 0, 0, 1, -660,
+0, -663, -664, 0, 4, 1, 0, -666, 4, 0, 0, -667, -670, 0, -672, 0,
+-673, -674, -675, -680, -687, -688, 0, -690, -693, 0, -696, -702, 0, -704, -706, 0,
+2, -715, -716, 2, 4, 0, 1, 9, 0, 1, 0, 0, -719, 0, 0, 0,
+1, 0, 0, 2, -722, 0, 3, -727, -728, 0, -729, -731, 1, 8, 0, -732,
+1, 0, -733, 0, 0, -736, 1, 14, 0, -737, -738, -739, 1, -741, -744, -747,
+-749, 0, -750, 6, 0, 0, 3, 0, 3, -751, 0, 1, -752, 0, -753, -754,
+0, 0, -755, 0, 2, -757, 0, 1, 5, 0, -760, -763, 1, 0, -765, 4,
+0, -769, 0, -770, 3, -772, 0, -773, 1, 0, -774, 1, 0, -775, 1, 0,
+0, -778, -780, -781, 1, 0, -783, 1, -784, -785, -786, 0, 1, -790, -791, 0,
+4, -802, 0, 2, 0, 0, -803, -806, -807, 0, 1, 0, -812, 2, -815, -817,
+1, -819, -822, 5, 3, 0, -826, 8, 0, 1, 0, 0, 1, -827, 0, -828,
+9, -829, -830, 7, 0, 3, -833, 0, 1, -834, 0, 2, -840, -842, 0, 1,
+0, -844, -847, 0, 2, 1, 0, -850, -853, 6, 0, 4, 7, 0, 0, -854,
+0, -855, 0, 0, -859, 5, -866, 3, 2, 2, 0, 3, 0, -869, 0, -872,
+0, -874, -876, 0, 0, -882, -883, 1, -884, 0, -887, -892, 0, -893, -894, 0,
+7, -895, 0, 5, -896, 0, 0, 2, 0, 2, -898, 1, -903, 9, -907, 1,
+2, 0, 0, -910, 0, -912, 0, 1, -916, -918, -925, 0, -927, 4, 0, -930,
+0, -939, 0, 1, 0, -943, 0, -944, 2, 1, 7, 3, 19, 2, 0, 3,
+0, -947, -949, 0, 0, -952, 0, 0, -954, -955, 2, 4, 0, 0, 1, -962,
+0, -963, 0, 0, 0, 4, 0, 3, 0, 0, -964, 6, 0, -967, -970, -979,
+0, 1, -980, 0, 16, -984, 0, 3, 0, 0, -987, 2, 0, 8, 4, 0,
+-988, 3, 0, 1, 0, 0, 3, 6, 0, 0, 6, -989, 0, 6, 0, 0,
+-995, 10, -997, -998, -999, 0, -1005, 4, 0, 1, -1009, 0, -1011, 0, -1013, -1016,
+0, -1017, 0, 3, 0, -1019, 1, -1020, -1025, -1027, -1029, -1031, 0, -1032, 0, 8,
+2, 0, 2, -1035, -1036, 3, -1037, 2, -1038, 1, 0, -1039, 5, 0, 1, 4,
+0, -1040, 1, -1041, 0, -1042, 1, 4, -1044, 0, 0, 7, -1045, 0, -1049, -1053,
+0, -1055, 8, 0, 0, 13, 0, -1057, -1062, 0, -1063, 1, -1068, -1078, 4, 0,
+-1083, 0, -1085, -1086, -1093, 0, 1, 6, 0, 0, 7, -1094, 0, 0, 0, -1098,
+0, -1100, 0, 0, 3, -1101, 2, 12, 0, -1104, -1105, -1117, 11, -1119, -1120, 0,
+2, 0, -1122, 1, 0, 0, 9, 0, -1133, 0, 8, 0, 4, 0, 0, 9,
+-1135, 0, -1141, -1142, -1144, -1148, 2, -1154, 0, -1155, 0, -1156, 3, 0, -1157, -1158,
+-1160, -1161, 1, 9, 0, -1162, 9, 0, 0, -1163, 0, -1165, 0, 0, -1166, -1170,
+0, 1, -1175, -1176, 0, -1178, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+-1185, -1187, 5, 0, 4, -1188, -1190, 0, 0, -1191, 1, 7, 0, -1192, -1194, 0,
+1, 4, -1197, 7, -1202, -1204, -1208, 0, -1210, 0, 2, 0, 0, 0, -1213, 0,
+-1215, 0, -1217, 0, 4, 0, -1218, 1, 0, 11, 1, 0, 0, -1221, 0, -1222,
+-1223, 0, 0, -1226, 0, -1230, -1232, 0, -1234, 3, 0, 0, -1236, 0, -1239, 0,
+0, 0, 1, 0, 0, 10, 5, 0, 2, -1242, 0, 0, 2, -1244, 0, -1245,
+0, -1247, 1, 0, -1252, -1254, -1256, 0, 1, 2, 0, 0, 4, 0, 3, 0,
+0, -1257, -1259, 0, -1260, 1, -1262, -1263, 1, 0, 3, -1266, 0, 7, -1268, 0,
+0, 2, -1270, 0, 1, 0, -1272, -1277, 0, 10, -1278, 0, -1279, -1280, 5, 0,
+4, 1, -1285, -1286, 0, 0, 5, 8, -1288, -1289, 2, -1296, -1299, 1, 0, -1303,
+3, -1305, -1306, 3, 0, -1309, 1, -1311, 0, -1313, -1314, 0, -1317, 13, -1318, 2,
+-1320, 0, 4, -1325, 0, 1, -1326, 0, -1330, -1332, 0, 0, 1, 0, 1, 1,
+0, 15, -1336, -1343, 0, 7, 12, 0, -1348, -1349, 0, 2, 0, 0, 1, -1351,
+0, 10, 18, 0, -1361, 4, 0, 1, -1362, 0, -1369, -1370, 0, -1373, 9, 0,
+0, 3, -1379, -1380, -1381, 0, -1383, 6, -1384, 0, -1386,
+
+};
+
+static const uint16 emoji_forms_ucs_index[] = {
+
+841, 2149, 3474, 839, 2214, 3343, 425, 411, 87, 2235, 2975, 374, 155, 818, 1781, 3021,
+78, 4259, 882, 3450, 3061, 379, 4038, 2917, 900, 4261, 2116, 178, 2999, 62, 2317, 1930,
+555, 2935, 4360, 2236, 2156, 3389, 2192, 4299, 2125, 2203, 774, 492, 369, 2951, 2395, 2204,
+816, 305, 2212, 3546, 201, 3449, 4285, 2437, 421, 125, 468, 878, 314, 101, 2286, 3442,
+3113, 352, 4322, 1976, 45, 2114, 836, 316, 810, 518, 2279, 145, 86, 4296, 578, 2172,
+153, 2285, 40, 3405, 22, 4304, 3076, 466, 2290, 2335, 388, 2988, 3404, 1762, 3435, 4240,
+875, 2822, 4257, 1009, 3930, 832, 2321, 2539, 998, 2332, 4238, 2201, 3118, 3446, 2139, 2227,
+887, 2936, 4309, 439, 819, 4279, 2986, 2774, 521, 2318, 431, 464, 3367, 2528, 563, 2507,
+2206, 2492, 475, 2754, 3459, 788, 3452, 12, 2268, 2813, 778, 4247, 3019, 320, 2280, 3366,
+2162, 1882, 3374, 4289, 805, 36, 2965, 669, 2534, 898, 2186, 338, 864, 2814, 99, 282,
+1811, 2752, 442, 960, 304, 4423, 901, 804, 481, 1023, 3378, 4267, 363, 2314, 569, 161,
+1960, 4300, 505, 410, 2293, 3423, 4371, 2487, 362, 2756, 150, 547, 2187, 3109, 295, 2924,
+179, 3424, 854, 60, 2150, 2469, 3275, 2191, 461, 3458, 2818, 4362, 371, 380, 3385, 840,
+3445, 4275, 3357, 122, 119, 2126, 2475, 4302, 3418, 2272, 3415, 280, 2173, 378, 2209, 2249,
+123, 3142, 809, 574, 117, 343, 3545, 2197, 2748, 807, 2324, 845, 510, 454, 3456, 2987,
+2260, 916, 3011, 355, 540, 4251, 2221, 2513, 3347, 2509, 3370, 834, 3437, 4243, 2474, 344,
+3544, 2544, 4242, 286, 2263, 2976, 4365, 2826, 936, 204, 909, 872, 2827, 1969, 493, 2761,
+2550, 0, 2764, 520, 906, 2760, 2435, 340, 4008, 2409, 4237, 74, 373, 2482, 2199, 387,
+3074, 2542, 3310, 2545, 4367, 398, 2857, 436, 4315, 4301, 873, 18, 248, 1007, 452, 2537,
+860, 3020, 361, 1008, 2494, 2304, 1966, 3000, 2766, 978, 3555, 2960, 2337, 185, 780, 4266,
+487, 580, 1016, 4298, 4332, 4312, 128, 2164, 271, 589, 2305, 16, 2253, 849, 49, 315,
+2319, 141, 396, 4128, 2262, 26, 1004, 303, 76, 56, 2969, 368, 4364, 435, 3110, 3244,
+564, 458, 2273, 4273, 504, 4229, 409, 1003, 326, 2990, 394, 870, 72, 173, 2467, 592,
+498, 2297, 2144, 3428, 534, 2331, 2767, 2266, 2820, 247, 2952, 2233, 407, 3344, 2291, 3031,
+889, 111, 3358, 2190, 2226, 3535, 496, 524, 2949, 444, 2522, 3436, 401, 2347, 2503, 32,
+3274, 2543, 2441, 3460, 301, 3001, 2146, 2523, 2512, 3557, 4359, 2082, 318, 806, 2816, 2045,
+842, 782, 3130, 2230, 856, 2933, 2991, 551, 2142, 507, 4239, 2153, 2195, 10, 568, 2136,
+4293, 2133, 2309, 3453, 886, 24, 812, 577, 586, 3422, 4321, 907, 192, 629, 2945, 4250,
+2218, 3454, 784, 250, 4262, 2258, 4354, 2971, 513, 868, 2993, 3010, 384, 2824, 423, 176,
+4249, 4264, 2486, 4232, 2298, 2138, 543, 2200, 3430, 3550, 3280, 4368, 2493, 3114, 313, 38,
+121, 2294, 2223, 2274, 3377, 2759, 3392, 191, 3542, 2477, 2758, 2224, 258, 2281, 588, 874,
+419, 800, 2524, 3386, 2240, 929, 2540, 930, 4252, 3025, 853, 582, 576, 2276, 3361, 2168,
+2117, 3447, 14, 2261, 3003, 2307, 2205, 506, 331, 477, 3395, 2320, 1763, 2484, 2333, 82,
+2009, 773, 2389, 80, 2329, 208, 2228, 2750, 4351, 2953, 2300, 3043, 2996, 2465, 486, 389,
+2242, 533, 2229, 2926, 455, 2674, 659, 474, 3439, 4323, 3024, 2255, 879, 2455, 2979, 4379,
+2485, 1011, 357, 2179, 871, 3505, 591, 1013, 2502, 4098, 3178, 514, 2921, 2922, 4228, 4317,
+2549, 3391, 2143, 565, 3214, 2231, 471, 3342, 406, 4291, 3388, 4353, 2259, 28, 877, 58,
+2521, 2151, 2295, 149, 4258, 3434, 4260, 858, 3417, 2463, 1975, 3650, 516, 895, 2538, 3379,
+3432, 2985, 3427, 4303, 500, 798, 1967, 559, 2490, 3382, 4329, 837, 472, 143, 483, 2746,
+523, 2046, 3409, 2225, 302, 4294, 2148, 2184, 495, 482, 831, 827, 129, 2514, 3351, 4253,
+4411, 438, 814, 2403, 2181, 888, 3443, 3073, 490, 2345, 4319, 2476, 3412, 4320, 2327, 2445,
+2277, 2270, 3078, 2316, 999, 324, 570, 2340, 3055, 131, 2459, 2343, 808, 3348, 2505, 2443,
+599, 4288, 194, 2777, 417, 383, 3411, 180, 572, 4366, 170, 2780, 356, 2178, 542, 450,
+404, 480, 3536, 2182, 2479, 2769, 2313, 278, 579, 2194, 3552, 1769, 531, 2515, 508, 4370,
+3340, 372, 385, 3440, 2471, 2755, 2271, 2269, 790, 66, 536, 6, 3023, 1336, 3549, 88,
+2311, 3112, 4272, 494, 4311, 105, 448, 2947, 3390, 2775, 2483, 2222, 2166, 3402, 2267, 2202,
+2768, 851, 2997, 30, 203, 3441, 386, 4, 199, 829, 2548, 35, 429, 20, 876, 585,
+4313, 457, 2119, 4284, 2170, 462, 2480, 2207, 8, 2213, 776, 2176, 3406, 2919, 2216, 4435,
+3384, 4405, 3455, 857, 3461, 3559, 4256, 4292, 4234, 1012, 2296, 54, 4318, 126, 200, 3022,
+332, 2175, 2747, 2338, 3394, 2232, 3369, 460, 109, 4218, 3363, 2982, 390, 293, 2495, 3353,
+3401, 3352, 172, 243, 2308, 3429, 861, 2254, 3410, 346, 1002, 2984, 2287, 525, 167, 2449,
+796, 2210, 910, 4297, 2174, 97, 2334, 2776, 333, 1017, 206, 557, 3553, 2237, 163, 4324,
+2530, 3116, 3124, 2211, 660, 590, 2134, 2956, 3349, 867, 4274, 2989, 890, 2198, 2749, 2527,
+4361, 2815, 2498, 3360, 541, 2303, 3448, 370, 948, 3457, 802, 2778, 4068, 403, 1912, 3554,
+1978, 2497, 479, 2773, 2995, 4314, 157, 3362, 3111, 2957, 44, 52, 413, 3414, 3373, 152,
+4310, 3184, 342, 503, 393, 64, 539, 2180, 883, 3425, 884, 447, 359, 2257, 330, 4271,
+300, 4276, 197, 484, 2489, 4282, 115, 2517, 4158, 1876, 412, 4306, 1846, 2250, 2177, 4373,
+4248, 1005, 4358, 813, 2397, 2439, 2740, 562, 2167, 124, 850, 2196, 501, 587, 2341, 3359,
+2819, 182, 365, 441, 794, 3383, 456, 3419, 593, 997, 375, 284, 966, 3548, 3002, 2323,
+571, 2413, 2994, 3444, 135, 4355, 2954, 4352, 2518, 699, 366, 3420, 451, 2762, 4254, 3136,
+2115, 415, 2923, 2973, 4316, 4283, 107, 252, 2763, 512, 2817, 459, 2918, 2325, 392, 4295,
+2432, 922, 2511, 2551, 2141, 4357, 2185, 2491, 2958, 2757, 668, 2955, 3350, 2420, 467, 2405,
+2315, 3972, 1014, 519, 2183, 833, 2516, 3345, 2823, 288, 2215, 132, 522, 2393, 4369, 817,
+2496, 2473, 2234, 2220, 846, 336, 2113, 4344, 885, 377, 3543, 465, 811, 84, 2753, 560,
+113, 3462, 865, 815, 400, 894, 3551, 1010, 2821, 4286, 187, 34, 489, 2147, 2188, 2239,
+852, 3438, 443, 3421, 891, 68, 2812, 3619, 3942, 2932, 4290, 3371, 1000, 4280, 4241, 2278,
+532, 509, 2256, 769, 2288, 1979, 4356, 3475, 2265, 427, 2771, 3049, 2772, 4244, 1968, 2887,
+469, 2328, 3355, 2770, 2339, 2152, 1775, 786, 2301, 2779, 2193, 127, 3077, 2992, 2959, 297,
+4328, 470, 307, 583, 4308, 405, 866, 2529, 2967, 2217, 869, 896, 2, 2411, 1006, 2934,
+437, 4330, 3387, 1816, 855, 264, 2447, 3416, 463, 2283, 3403, 3556, 2501, 3547, 2052, 2541,
+3075, 4223, 2961, 3375, 892, 334, 497, 4363, 2145, 538, 2248, 50, 4235, 2171, 3354, 3381,
+360, 147, 1977, 990, 581, 414, 511, 2275, 2925, 843, 3433, 169, 972, 350, 2937, 844,
+3649, 2247, 2781, 2811, 42, 575, 2998, 2506, 771, 4263, 290, 2644, 4325, 667, 2581, 792,
+499, 2531, 4372, 2135, 2140, 2241, 545, 382, 863, 485, 90, 2165, 3365, 4338, 4268, 47,
+103, 954, 573, 2289, 835, 2453, 4350, 181, 3372, 2426, 195, 139, 133, 2825, 319, 2643,
+2546, 2391, 4269, 453, 2155, 299, 928, 4245, 2132, 3017, 4231, 2118, 3364, 29, 2451, 537,
+777, 488, 2252, 515, 2532, 4429, 358, 904, 3341, 553, 328, 354, 4417, 584, 3451, 2264,
+2510, 4246, 2526, 2680, 4230, 897, 3936, 734, 2433, 391, 3431, 2499, 2500, 291, 2238, 2710,
+3589, 2611, 3117, 2457, 2137, 549, 402, 2547, 159, 1029, 449, 4255, 37, 3037, 2983, 881,
+245, 893, 491, 535, 775, 2504, 4327, 2243, 2306, 3380, 3468, 2326, 2039, 4287, 2154, 561,
+2219, 4307, 244, 4305, 408, 348, 803, 165, 3413, 847, 2751, 2299, 2407, 3148, 3009, 859,
+70, 899, 4188, 2519, 3346, 4278, 3558, 433, 440, 4233, 399, 137, 4277, 2642, 381, 3356,
+1015, 4265, 345, 2478, 2112, 661, 2292, 3115, 4326, 2244, 395, 566, 3368, 3393, 174, 4331,
+322, 189, 130, 3376, 2208, 2354, 3018, 478, 942, 476, 502, 2508, 544, 2282, 996, 2520,
+2963, 4236, 3408, 1924, 905, 2981, 4270, 3407, 397, 2302, 3426, 473, 2461, 3067, 2641, 2246,
+2189, 2481, 567, 2920, 2336, 2322, 3079, 184, 2169, 364, 4281, 984, 838, 2251, 1918, 2488,
+2330, 3978, 446, 2939, 2765, 2163, 2977, 1001, 4441, 71, 2284,
+
+};
+
+static const int32 emoji_forms_seq_disp[] = {
+
+0, -1, -2, 1, -4, -7, 0, -10, 0, 2, 0, -12, 3, 0, -13, -20,
+0, 4, -24, 3, 1, 2, 1, -26, 0, 0, 0, 0, 0, -27, 0, 2,
+0, 1, 0, 0, -28, 0, -31, -34, -37, 0, 0, 0, 0, -38, -39, -41,
+-45, 0, -46, -47, 0, 0, 0, -52, -54, -55, -68, 0, -70, 0, 0, -71,
+-73, 0, 0, -74, -76, -79, 2, -80, -81, -83, 0, 0, 1, 0, 1, 0,
+3, -86, -89, -92, -105, 0, 1, -108, 0, 0, 0, 0, 0, 0, -111, 0,
+-112, 1, 1, 2, 1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 4,
+-113, 2, 0, 0, -116, -125, -126, -128, -131, -134, -140, 1, 1, -147, -148, 1,
+1, -153, -154, 0, 0, 2, -155, -157, 1, 1, 1, 1, -167, -170, -173, 4,
+4, 1, 2, 2, -174, 2, -177, -182, -185, -190, 1, -195, 2, -196, -197, 1,
+2, 1, -199, -200, -205, -206, -210, -212, -213, -215, -216, -224, -225, -226, 1, -227,
+1, 2, 2, 1, 1, 1, -232, -233, 1, -236, -237, -242, -243, -244, 1, -248,
+1, 1, 2, -249, -250, 0, 0, -252, -255, 1, 2, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 1, 0, -256, -259, -273, 0, 0, -274, -279, 0, 0,
+0, 0, 0, 0, -280, 0, -284, 0, 0, 0, 0, -285, -287, 0, -288, 3,
+-292, -293, 1, -294, -296, 0, -297, 0, 0, -300, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, -303, -307, -308, 0, -309, -312, 0, -315, 0, 0,
+2, 0, -325, -337, 1, -340, 2, 1, 2, 1, -344, -346, 1, 1, 1, -349,
+-353, 0, -355, 0, -356, 0, 0, 0, 0, -357, 1, 0, 0, 0, -358, 0,
+1, 0, 0, 0, 0, -359, 0, 1, -364, -366, 0, 0, 0, 0, 0, 0,
+-369, 0, 0, 0, -370, -373, -374, -375, 1, 0, 0, -376, -378, 1, -379, 3,
+-380, -381, -382, 1, -383, 1, 1, -388, -389, 1, 0, 0, -393, 0, 3, 0,
+0, 1, 1, -397, 1, -399, -400, 4, 1, 2, -408, -413, -414, -418, -421, 1,
+-422, 1, 1, 2, 1, 1, -428, -429, 2, 3, 1, 3, 2, 2, 1, -430,
+-431, 10, 1, -439, -452, 1, -458, 2, 1, 4, 1, 2, -470, 1, 1, 2,
+-473, -474, -476, -478, -482, 1, 1, -483, 1, -485, 1, -489, 1, -490, -491, 4,
+-492, -494, -504, -505, 1, -507, 0, 0, -508, -509, -510, -512, 0, 0, 0, 0,
+0, -513, 0, 0, 0, 0, 0, 0, -516, 0, 0, -521, 0, -527, 0, 0,
+0, -528, 0, 0, 0, 0, -530, 0, -531, 0, 0, -532, 0, -534, 1, 1,
+1, -535, -536, -541, -542, -543, 0, 3, 0, 0, 0, 0, 5, 0, -547, -551,
+0, 0, 0, 0, 0, -552, 0, 0, 0, 0, 0, 0, 0, 0, -554, -560,
+0, -561, 0, 0, 0, 0, -563, 0, 0, -565, 0, 1, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, -566, -567, -569, -570,
+-575, -577, -578, 0, -579, 0, 0, -580, 0, -582, 1, -583, -584, 0, 0, 0,
+-585, -586, 0, 0, 0, -591, 2, -595, -596, 0, 0, 0, 0, 1, 0, -598,
+0, -602, 2, 1, 1, 2, 0, 1, 1, -603, -605, 0, 0, 3, 0, 0,
+-606, 0, 0, -615, 0, 3, -617, 4, -619, 0, 0, -624, -625, -626, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, -628, -631, -634, 0, -635, 0, 0,
+1, 0, -638, 0, 0, 0, 0, 0, -639, -640, 6, 2, 3, 0, 0, 0,
+0, 6, 0, 0, 0, -642, 0, -643, 0, 0, -644, -645, -647, 0, -648, 0,
+-649, 1, -650, 1, 0, 0, -651, 0, 0, 0, 0, -652, 0, 0, 0, 0,
+-653, 0, 0, 1, 0, -656, 0, -657, 6, -661, -662, -663, 0, 1, -666, 0,
+0, 2, 0, 1, 0, -671, 0, -672, 0, 2, 1, 0, 2, 0, -674, 0,
+-676, -678, 2, 1, 0, 0, 0, 0, -682, 0, -685, 0, 0, 0, -686, 1,
+-687, 0, 0, 0, -688, -689, 1, -712, -713, 0, 0, 0, 0, 0, 0, -718,
+0, 5, -723, 0, 0, 1, 0, 0, 0, 0, -724, -725, -730, 2, 1, 1,
+-740, -744, 0, -747, -749, 0, 0, 0, -750, 0, 0, 0, 1, 0, -751, 0,
+-753, 1, 0, -755, 0, 0, 0, -768, -776, 5, 0, 3, -777, -780, -781, 1,
+0, -782, -790, 0, -791, 0, -795, -797, -799, -800, -801, -803, 4, -804, 1, -805,
+6, 1, -809, 1, 1, 1, 4, -811, -812, 1, 5, 1, 1, 1, 1, 3,
+-817, -818, 1, 1, 1, 2, 2, -824, 1, -828, 2, 1, 1, -831, 1, -832,
+-833, 2, 1, -835, 5, 4, 2, 4, 3, -836, -839, -840, 1, 1, -844, -845,
+1, 1, -846, -847, 1, 5, 1, -848, -849, 2, 1, 1, -850, -851, -852, 1,
+-858, -860, 1, 3, 3, 1, 3, 1, -861, -862, -863, -864, 3, 2, 1, 1,
+6, 0, 0, 1, -866, 8, 1, 2, 2, -869, -871, 2, 1, -872, 2, -873,
+4, 1, 1, 1, 2, -875, 1, 3, 1, 2, 1, 2, 1, 1, 2, 1,
+2, 3, 2, 2, -876, 3, 0, 0, -878, 0, -879, -882, 0, -886, 0, 0,
+-895, 0, 0, 0, 0, 0, 0, 0, -897, 0, -898, 0, 0, 0, 0, 0,
+0, -900, -904, -910, -911, 0, -917, 0, 0, 0, -918, 0, 0, -919, -924, 2,
+-926, 1, 2, 4, 2, 1, 2, -928, 5, -929, -930, -932, 0, -936, 0, 0,
+1, 4, 5, 2, -942, 0, 0, 0, -945, 0, 0, 0, 2, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+3, -946, 1, 3, 1, 4, 0, 0, 0, 0, -948, 0, 0, -956, 0, 1,
+0, -958, 2, 2, -972, 0, 0, 0, 0, 0, 0, 1, -973, 0, 0, 0,
+1, -977, 1, -978, 3, 0, -980, -986, 0, 14, 0, -987, 0, 0, 0, 0,
+0, 0, 0, 0, -992, 6, 1, 1, 1, 1, 1, 2, 1, 3, -996, 2,
+-998, 2, 0, 0, 0, -999, -1002, -1004, -1005, 3, 1, 4, 0, 0, 0, 0,
+0, 0, 0, -1008, -1009, -1012, -1013, 0, -1015, -1021, 0, 0, 0, -1030, 2, 1,
+0, -1033, -1039, -1041, 1, 1, 0, -1042, -1043, 0, 0, 2, -1045, 2, 0, -1047,
+4, -1048, -1051, -1053, 1, -1056, 1, 3, -1065, -1071, -1075, 0, 0, -1076, 0, -1077,
+0, 0, 1, -1078, 4, -1081, -1083, 0, 0, 0, 0, 0, 0, 0, -1086, 0,
+0, 0, 0, -1087, 0, 0, 0, 0, -1089, -1090, -1091, -1092, 0, 0, -1094, 0,
+-1096, -1098, 8, 4, 1, 1, 2, 2, 1, 1, 0, 0, -1099, -1101, -1103, -1106,
+-1107, -1109, 3, -1110, 3, -1111, -1112, -1115, 0, 0, 0, 0, 0, -1116, -1117, 4,
+4, 3, -1121, 0, 1, 0, 2, 0, -1123, -1130, 3, -1138, 3, -1145, 0, -1147,
+0, 0, 0, -1150, 0, 1, 0, -1151, -1153, -1159, -1162, -1163, -1164, 0, 2, -1165,
+1, -1169, 0, -1170, 0, -1172, -1174, -1177, 1, 2, -1178, 1, 1, -1179, -1181, -1183,
+-1184, 0, 1, -1185, -1186, 0, 0, -1187, -1189, -1190, -1195, 0, 1, 1, 1, 1,
+1, 2, 2, 0, 0, -1196, 0, -1197, 1, 0, 0, 0, -1198, 0, 0, 0,
+0, 0, 0, 1, 0, 0, -1199, 0, -1202, 0, 0, -1205, 0, 0, -1210, -1213,
+-1214, 1, 1, 0, 2, 0, 0, 0, 0, 0, 0, 0, -1215, 0, 0, 0,
+0, -1216, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, -1218, -1222, 1, 0, -1232, 0, -1233, -1238, -1239, -1240, 1, 1, 3,
+0, -1241, 0, -1246, 2, 1, 2, -1249, 5, 6, -1253, 1, 1, 3, 1, 1,
+-1254, -1259, -1260, 1, 1, 2, 1, 1, -1261, 2, 2, 1, 2, 1, 1, 1,
+-1263, -1264, -1265, -1268, -1269, -1274, -1279, 4, -1280, 3, -1282, 0, 0, 4, 1, 1,
+1, 1, -1287, -1290, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, -1292, 0,
+0, -1295, 0, 0, -1297, 0, 0, 0, 0, 0, 0, 0, 0, -1298, -1299, 0,
+0, 0, -1305, 0, 1, 0, 0, 0, 0, 0, 11, 5, -1307, 1, 0, 0,
+0, -1315, 0, -1323, 0, 0, 0, 0, 0, 0, -1324, -1325, -1328, 0, -1340, 0,
+3, 0, 2, -1342, 0, -1343, 0, 1, 2, 5, -1344, -1347, -1350, -1352, -1354, -1358,
+1, -1360, -1361, 3, 1, 1, 1, -1363, -1364, -1368, -1369, -1370, -1374, 2, -1376, -1378,
+-1379, 2, -1382, -1383, 2, 3, 1, 1, 1, -1385, 1, 1, -1387, -1388, -1392, -1393,
+3, 3, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 1, 1, 1, 1,
+1, 4, 1, -1394, 3, 1, -1395, -1396, 1, 1, -1397, -1399, -1407, -1408, 2, -1409,
+-1410, -1412, -1414, -1428, 2, 6, 1, -1429, 5, -1430, -1431, -1432, 4, -1433, 1, -1437,
+1, 0, 0, -1438, -1440, -1445, -1447, -1448, 1, -1449, 1, -1451, 1, -1453, 1, 1,
+2, 1, 1, 1, 4, 2, 3, 1, 1, 1, 1, 1, 1, -1454, -1456, 2,
+-1459, 1, 1, -1460, 2, 2, 1, 1, 3, 5, -1463, -1465, -1470, 2, 0, -1471,
+0, -1474, 0, 0, -1477, 0, 0, 0, -1479, -1480, -1482, -1484, -1487, 1, -1488, 1,
+-1489, 1, -1499, -1500, -1501, 2, 1, 2, -1502, -1503, 5, -1504, 1, 1, 1, -1505,
+0, -1509, -1512, -1513, 1, -1523, 0, -1525, -1526, -1528, -1530, -1531, 0, 0, 0, 3,
+-1532, 3, 3, -1533, 3, -1535, 0, 2, -1537, 0, 3, -1548, -1551, -1553, 0, 0,
+-1554, 0, 0, -1564, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, -1565, 2, 0, -1566, -1571, 1, 2, 0, 0, -1573, 0, 0, -1574,
+-1579, -1580, 0, -1581, 0, 0, 0, 0, 0, 0, 0, -1582, -1583, -1584, 0, 3,
+-1585, 0, 0, 0, 2, 2, -1586, 2, 7, 1, 1, 0, -1587, 0, -1588, 0,
+-1589, 0, 0, 2, -1592, -1593, -1594, -1598, 0, 0, -1599, -1601, 2, 1, 2, 3,
+1, -1603, -1606, 2, 0, -1607, -1608, -1610, -1611, 1, -1612, 1, 3, 0, -1613, -1614,
+-1616, 2, 1, -1622, 11, 5, 6, -1624, -1625, 0, -1626, -1627, -1628, 0, 0, -1629,
+-1636, 0, -1637, 0, -1639, 0, -1641, 0, 0, -1645, 0, 1, 3, 6, 0, 0,
+-1646, 0, 0, -1647, 0, 0, -1648, -1649, -1651, -1653, 0, -1655, 7, -1662, -1668, 0,
+-1669, 0, 0, 0, 0, 4, -1671, 0, -1677, 0, 0, -1681, 0, 0, 0, 0,
+0, -1683, 3, 2, -1685, -1686, 0, 4, 0, 0, 0, 0, -1687, 0, 1, 2,
+-1691, -1693, 0, 0, 1, 1, -1694, -1699, 3, -1700, 0, -1701, 0, 2, 0, -1703,
+-1713, -1714, -1717, 0, 0, 0, -1719, 0, 0, 0, 0, -1722, -1725, 0, 0, 0,
+-1728, 0, 0, 0, -1729, 0, 0, -1730, 0, -1731, 3, -1732, 1, -1733, 0, 4,
+1, -1734, 1, -1737, 0, 0, 0, -1739, -1740, 0, -1741, 0, 0, 0, 0, -1742,
+0, 0, 0, 0, 0, 0, 0, 1, -1744, -1749, 1, -1752, -1754, 0, -1755, -1756,
+1, 3, 3, 0, 0, 0, 0, -1760, -1761, -1762, -1763, -1764, 0, 0, 0, 0,
+-1765, 0, 0, -1768, -1772, -1774, 8, -1780, -1781, 0, 0, 0, 0, 0, 0, 0,
+1, 1, -1783, -1801, -1803, 4, -1804, 1, 0, 0, -1805, -1807, 0, 0, 0, 0,
+-1809, -1811, 2, 0, 1, 0, 2, 0, 0, 0, -1812, -1815, 2, 1, 0, 1,
+-1817, 1, -1826, 0, -1827, 0, -1832, -1833, -1835, -1836, 0, -1839, 0, 0, 0, 0,
+0, -1842, -1844, 0, 0, -1846, 0, 0, 0, 0, 0, -1850, 4, -1853, -1856, -1861,
+-1862, -1865, -1868, 1, -1870, -1874, 2, -1875, -1878, -1879, -1880, -1883, 1, 1, -1884, -1885,
+-1886, 4, -1888, 1, 4, 8, 1, 4, 1, -1893, -1894, 2, -1896, -1904, 3, -1907,
+-1908, 3, -1910, -1912, -1913, -1915, -1916, 4, 7, 1, 3, -1917, 1, -1918, 1, -1919,
+2, 2, 2, 1, 1, -1922, -1924, -1925, -1927, 3, -1930, -1933, -1936, 1, -1938, 0,
+0, -1941, 10, 0, 0, 2, 0, -1945, 0, -1952, 0, 3, -1953, 4, -1955, -1960,
+-1961, -1962, -1963, 1, 7, 5, 3, -1965, -1966, -1967, 2, 2, -1969, 4, 1, -1972,
+-1975, -1984, 1, -1986, -1987, -1988, 2, -1991, -1992, -1993, -1994, -1995, 2, -1996, -1997, -2000,
+-2003, -2007, -2010, -2011, -2013, -2014, -2017, -2020, 1, -2021, -2023, -2024, -2030, -2031, -2032, 1,
+1, -2033, 1, 2, 6, 3, 1, -2035, 2, 2, 2, -2038, -2039, 5, 3, -2041,
+-2044, -2045, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -2052, 0,
+-2054, 0, 0, 0, 0, -2058, 0, 0, 0, 0, 0, 0, 0, 0, -2059, 0,
+-2062, -2063, 3, -2064, 0, 3, 0, 0, 0, 0, -2065, 3, 0, 1, -2067, -2069,
+2, -2070, 0, 0, 0, -2071, 0, -2075, 0, 0, 0, -2084, 0, 0, 0, 0,
+0, 0, 0, -2085, 0, -2087, 1, 1, -2088, -2089, 0, -2091, 3, -2095, -2098, 3,
+-2099, -2105, 3, 1, -2111, -2112, 2, -2116, -2117, -2127, 5, -2134, 3, -2138, 4, -2144,
+-2151, -2155, 2, -2159, -2169, -2171, -2182, -2183, -2184, -2187, -2188, 5, 2, 3, 1, 1,
+2, 7, 1, 0, 0, -2193, -2195, -2202, -2203, 9, 1, 11, 1, 1, 1, 1,
+-2204, 1, -2206, 2, -2217, -2218, -2219, -2220, 1, 3, 11, 0, 0, -2221, -2227, -2228,
+-2229, 0, 0, 0, 0, 0, 0, 0, -2230, 0, 0, 0, 0, -2231, 0, 0,
+-2234, 0, -2236, 1, 0, -2237, 0, -2242, 0, -2248, 0, -2249, 0, 4, 1, -2257,
+-2259, 0, -2260, -2262, 0, 0, 0, 3, 0, 0, -2265, -2268, 0, 0, -2269, -2273,
+0, 0, 0, 0, 0, 0, -2275, -2278, -2281, 0, -2291, -2293, -2295, -2300, -2304, -2305,
+2, 0, 1, 9, 5, 13, 0, -2312, -2313, 0, 6, 1, 6, 1, 8, -2314,
+4, 0, -2316, 0, -2317, -2323, 2, 3, 3, -2324, 0, 0, 0, 5, 2, -2325,
+-2328, -2329, -2334, -2336, 15, -2337, 1, -2338, 0, -2339, 2, 0, -2340, 0, -2342, -2346,
+-2347, -2354, -2361, -2363, 0, -2364, 1, 0, -2367, 1, -2369, -2370, 1, 0, 0, 0,
+-2372, 6, 6, -2377, -2384, -2391, 0, 0, 0, 0, -2392, -2397, -2398, -2399, 0, -2401,
+-2402, 0, 0, -2403, 1, 3, 1, 2, 3, 3, 0, 0, 0, -2407, 0, -2408,
+0, 0, 0, 0, 0, 0, 0, 2, 0, -2409, 0, -2411, 0, 1, 0, 0,
+0, 0, -2414, 0, -2424, 2, -2425, 1, -2435, 0, 0, 0, 0, -2437, 0, 0,
+-2439, 0, -2442, -2448, -2449, -2454, 0, -2457, 0, -2458, 0, 0, 0, -2459, 0, 0,
+1, 0, 3, 0, -2461, 0, 0, 0, 0, 0, -2469, 0, -2474, 0, 0, -2477,
+0, 0, 0, 0, 3, -2478, 0, -2479, -2480, -2481, 0, -2486, -2489, -2491, -2494, 3,
+0, -2496, -2499, 0, 0, 0, 0, 0, 0, -2504, 0, 0, -2506, -2511, -2512, 1,
+-2516, 1, -2518, -2524, 0, 0, -2525, 0, 0, 0, 0, 0, -2526, -2528, 1, -2535,
+-2536, 0, 0, -2537, 1, -2539, 3, -2540, -2541, 0, -2543, -2544, -2545, 0, 0, 0,
+0, -2546, 0, 0, 0, -2547, 0, -2549, 1, 10, 7, 3, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, -2558, -2560, -2563, -2566, 0, 0, -2567, 0, -2568, -2569,
+0, 0, 0, 0, 0, 0, 2, 0, 5, -2574, 2, 2, -2575, 5, -2578, -2586,
+7, 1, 1, 0, 0, -2589, 0, -2592, 0, -2594, -2595, -2598, 0, -2599, 0, 0,
+0, 0, -2603, 0, -2604, 0, 0, 0, 0, 0, 0, -2605, 0, -2614, 0, 0,
+0, -2616, 0, 1, -2620, -2621, -2624, -2628, 0, 0, 0, 4, -2629, 5, 5, -2648,
+-2653, 0, -2657, 0, -2659, 3, -2660, -2665, 0, 2, -2668, 0, 0, -2670, -2673, -2674,
+-2677, -2682, 2, 2, 5, 0, 0, -2688, -2689, -2690, -2693, 0, -2697, 1, -2698, -2699,
+0, -2700, -2709, -2710, -2711, -2712, -2718, -2721, 0, 7, -2722, -2723, -2724, -2729, 6, 2,
+5, -2731, -2732, -2734, 3, 12, 5, 2, 1, 1, 1, 1, 1, -2744, -2749, -2751,
+2, -2753, -2755, 1, 9, 4, 1, 1, 4, 2, -2756, -2759, -2761, 4, 1, 1,
+2, 1, -2762, -2763, -2766, 1, -2772, 7, 1, 8, -2773, 1, 0, -2775, -2777, 0,
+-2778, 0, 0, 3, 0, -2782, 0, 6, 0, 3, 0, 1, -2783, 1, 2, 4,
+-2787, 2, -2790, 2, 5, -2792, -2796, 0, 0, 0, 0, 0, -2797, -2798, 0, 0,
+-2800, -2802, -2803, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 7, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -2806, 0, 0, 2, -2808, 2,
+0, 0, 0, 0, -2810, -2811, -2814, 1, -2815, 1, 0, -2822, 4, 0, -2823, 1,
+0, 2, -2828, 0, 1, -2829, -2836, -2839, 3, -2847, 0, -2851, -2852, 2, 1, -2854,
+-2856, -2858, -2859, 0, -2860, 1, 0, -2863, 0, -2865, 2, -2866, 0, 0, 0, 0,
+-2868, -2875, -2891, -2896, 2, -2897, 0, -2900, -2902, -2904, -2906, 1, 0, 1, -2907, -2908,
+0, -2909, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+0, -2910, -2912, -2917, -2918, 0, 0, -2919, -2923, -2926, 0, 0, 0, 0, 0, 1,
+0, 2, 0, 0, 0, 0, 0, 0, 0, -2930, 8, 3, 1, 0, 0, -2932,
+-2933, 2, -2935, 0, 0, 0, -2936, 0, -2937, 0, 0, -2938, 0, 0, 8, -2942,
+-2943, -2947, 2, -2948, 16, -2949, -2950, -2952, 5, 0, 0, -2953, -2954, 0, 1, 0,
+-2955, 0, -2956, 0, -2957, 0, 0, 0, 7, -2958, -2959, 2, -2964, -2966, -2971, 5,
+4, -2972, -2973, 0, 0, 6, -2979, -2980, -2982, -2983, 3, 0, 0, 0, 0, 0,
+-2984, 0, -2990, -2991, -2992, -2993, 0, 3, 0, -2995, 0, 0, 6, 0, 0, 0,
+0, 0, -2996, 0, 0, 0, 0, 0, 0, -2998, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, -3001, 0, 6, -3002, -3004, 3, 0, 3, 1, -3006, 4, -3009,
+-3014, 0, 0, 0, 0, 0, 0, -3015, 0, -3016, 0, -3021, 2, -3022, 5, 0,
+0, 0, 0, -3023, 0, 0, 0, 0, -3024, 15, -3030, 0, 0, 0, 0, 0,
+0, 0, 0, 0, -3035, 0, -3036, 0, -3037, 6, 0, -3040, -3041, 0, 0, -3042,
+-3043, -3047, -3051, -3053, 4, -3056, 0, 0, 0, 0, 0, 0, -3058, -3061, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, -3062, 0,
+-3065, -3067, 0, 7, -3071, -3072, 0, 0, 0, 0, 0, 0, -3075, 0, -3081, -3083,
+0, 0, -3084, -3085, -3089, 7, 7, 2, -3100, -3111, 5, 0, -3117, 0, 0, 0,
+5, 5, 2, -3120, -3123, 6, 1, -3125, -3127, -3131, 1, -3140, 12, -3146, 1, 6,
+1, 1, 7, -3150, -3160, 6, 1, 1, -3161, 2, -3165, -3166, 1, -3169, 4, 0,
+4, 1, 1, 4, 3, 8, 1, 1, 1, 2, 2, -3175, 4, 1, 8, 1,
+6, 3, 1, 1, 6, 3, 1, 8, 1, 1, 4, 6, 1, 7, 3, 5,
+-3177, -3182, -3184, -3185, 1, -3187, 1, -3192, 0, 10, -3196, -3197, 1, -3198, -3199, 6,
+-3206, -3208, -3210, -3212, -3214, -3216, -3217, -3218, -3224, 0, -3225, -3226, 4, 1, 1, 1,
+1, -3227, 1, 1, -3229, 4, 5, 5, 1, -3230, 9, -3231, -3232, -3244, 2, 2,
+1, 1, 1, 1, 2, 1, 3, 1, 1, -3247, -3249, -3250, 6, -3251, 1, 2,
+-3252, 2, 2, -3255, 3, -3257, -3258, -3260, -3264, -3265, 13, 2, -3266, -3267, -3268, -3273,
+-3277, -3284, -3285, 2, 4, 6, 2, 2, -3286, -3288, 1, -3289, -3290, 5, 0, 0,
+0, -3291, -3292, 0, -3297, 5, -3302, 0, 0, -3304, -3305, -3306, -3311, -3312, -3318, -3319,
+0, 4, 0, -3323, -3324, -3325, -3326, -3327, 0, -3331, -3332, 1, 1, 0, 0, 1,
+4, 1, -3335, 2, 2, 3, 0, 0, 0, 0, 0, -3336, 0, -3337, 0, 0,
+0, 0, -3338, -3341, 7, 1, 1, -3344, -3345, -3347, 0, -3350, 0, 0, 0, 0,
+0, 1, -3352, -3354, -3356, 27, 0, 5, 0, 0, 0, 0, 0, 0, -3361, 2,
+0, 0, 0, 0, 5, 1, 2, 2, -3362, 1, 0, -3364, -3366, -3369, 1, -3370,
+22, 0, 0, 0, 0, 2, 0, 1, 0, 0, 0, 7, -3372, 3, -3374, -3375,
+3, -3377, -3378, -3382, 0, -3383, 5, -3385, -3386, 2, 2, 0, -3394, -3402, -3405, -3408,
+-3409, -3413, 1, 11, -3415, 0, -3420, 1, 0, 0, 3, 3, -3421, 15, 0, 0,
+2, -3423, 2, -3424, 2, -3425, 4, -3427, -3431, 1, -3434, -3438, 0, 0, 4, -3439,
+7, -3440, 8, -3441, -3444, 0, -3445, -3446, 0, -3448, 0, 10, -3450, -3451, -3457, -3458,
+3, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 4, -3459, 11, 1, -3461,
+-3470, -3476, 0, -3480, -3481, 0, 2, -3483, -3485, 6, -3486, 9, 0, 0, -3487, 0,
+5, -3489, 0, 0, 0, -3492, -3498, -3499, 1, -3503, -3504, 0, 4, 0, 0, 0,
+0, -3505, 1, 0, 0, 0, -3508, -3509, 0, -3511, 0, 2, 20, 6, 0, -3523,
+0, -3528, -3530, -3533, 1, 4, 1, 3, -3534, -3540, 1, 0, -3542, 7, 2, 3,
+-3545, 0, -3546, 0, 0, -3547, 0, -3548, -3551, 3, -3552, -3553, 0, 0, -3554, -3555,
+-3556, -3557, -3559, -3562, -3563, -3564, 0, 0, -3566, 0, -3569, 2, 2, 1, 1, -3573,
+3, 10, 2, 0, 0, 0, 0, -3574, -3576, 3, -3580, 4, 0, -3583, 23, 0,
+-3587, 0, 0, 0, 6, 2, -3595, 0, 0, -3598, -3600, 6, -3603, -3604, -3605, 0,
+0, 0, 0, 0, 0, 0, -3607, -3608, 0, -3609, 0, 0, 0, 0, 0, -3610,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -3613, -3618, -3620, 0,
+-3621, 0, 0, 0, -3631, -3634, 5, -3635, 0, 0, -3636, 0, 0, -3642, 0, 0,
+-3643, -3645, 0, -3650, 0, -3651, 0, 0, 0, 0, 0, 0, 3, -3652, -3653, 0,
+-3656, 0, -3659, 0, 0, 0, 0, 0, 0, -3661, 0, 0, 0, 0, 0, 0,
+7, 0, -3663, 0, 0, 0, 0, 5, 0, -3664, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, -3665, -3666, 2, -3668, 3, -3673, -3674, -3675, 0, 0, 0, -3677,
+0, 1, -3678, -3679, 0, 0, 0, 0, 0, -3680, -3682, -3688, -3689, 0, -3691, -3692,
+0, -3693, 8, 6, 6, -3696, -3699, -3701, 2, -3702, 3, 0, 0, 0, 0, 0,
+-3705, 0, -3706, 0, 0, 0, 0, 0, -3707, 0, -3709, 0, 0, 0, 0, -3710,
+-3713, 9, 18, -3715, -3717, -3719, 9, 0, 0, 1, 0, -3722, 0, 5, 4, -3724,
+-3726, 0, -3730, 0, 0, 0, -3732, 0, -3736, 0, 1, -3737, 2, -3746, -3747, -3755,
+5, -3760, 1, -3766, -3770, -3783, -3784, -3785, 0, 0, 0, 0, 0, 0, 0, 0,
+0, -3786, 0, 0, -3787, 0, -3789, -3792, 0, 0, 0, 0, 0, 0, -3794, -3796,
+-3803, 2, -3813, 7, 2, 2, -3817, 4, 7, 2, -3819, -3821, 0, -3823, 0, -3824,
+0, 0, 0, 3, -3826, 5, 5, 5, -3829, 1, -3834, -3835, 1, -3841, -3843, 4,
+-3846, -3854, 1, 2, -3859, -3861, -3865, 2, 2, 12, 2, 1, 2, 2, 1, 1,
+2, 1, -3870, -3872, -3875, -3877, 2, 24, 2, -3879, -3880, 10, -3881, 0, 2, 2,
+1, 1, 3, -3885, 8, 1, 9, 2, 9, -3891, -3895, -3896, -3897, -3901, -3904, 1,
+-3910, 3, -3911, -3913, -3914, -3915, -3917, -3918, -3921, 2, -3922, 15, 1, 7, -3924, 4,
+9, 5, 2, 12, 5, 1, 2, 12, 2, 10, 1, 2, 1, 2, 4, 9,
+2, -3925, 0, -3928, 9, -3930, -3931, -3932, 5, -3935, 2, 2, 1, 4, 2, 2,
+5, -3948, -3963, 0, 0, 0, 0, -3966, 0, -3967, -3968, -3971, 0, -3972, 7, -3981,
+-3985, 0, 1, 14, 1, -3988, -3989, 0, -3992, -3994, 0, 0, 0, -3997, 0, 0,
+0, 0, 0, 0, 0, 7, -4007, -4012, 0, -4025, 0, 4, -4037, 2, 10, 0,
+0, 1, -4038, 1, -4041, -4042, 2, -4045, -4046, 0, -4050, 0, 0, 0, -4051, 19,
+0, -4054, 1, 0, 1, 0, -4055, 0, 7, 0, 0, 3, -4058, -4060, -4061, 0,
+0, 0, 0, 0, 0, -4069, 0, 0, 0, -4072, -4074, 1, -4078, -4081, 0, -4086,
+0, 0, -4088, -4089, 0, -4091, 0, -4095, -4096, 0, 0, 0, 0, -4098, 0, -4101,
+-4102, 0, -4105, 0, 19, 0, 0, 0, -4111, 0, 0, 0, 0, 0, -4115, 0,
+0, 0, 3, -4117, 14, -4120, -4121, 0, 0, 0, 0, -4124, 0, -4126, 0, -4132,
+0, 0, 0, -4133, 0, -4136, 0, 0, 0, 0, -4138, 0, 0, -4140, 0, 0,
+-4141, 1, 1, 4, 1, -4144, 2, -4145, 2, 10, 1, -4149, -4150, 1, 2, 10,
+-4151, -4152, -4161, -4163, -4165, -4167, -4169, -4170, 3, -4171, -4172, -4173, 1, 1, 1, 2,
+2, -4174, -4175, -4176, -4178, -4180, 6, 26, 1, 2, 8, -4181, -4186, -4188, -4193, -4194,
+-4197, -4200, 2, 4, -4201, -4208, -4211, 12, 2, 1, -4213, 21, 3, 1, 2, 1,
+5, -4214, -4217, -4223, 6, -4232, 0, 11, 8, 1, -4234, 14, 0, 0, -4239, 0,
+5, 0, -4240, 0, 6, 8, 3, -4241, -4243, 0, -4251, 3, -4252, -4254, 0, 0,
+-4267, -4269, 0, 0, 0, 2, 7, 5, 10, 4, -4271, 16, 0, 0, 0, 0,
+0, -4272, 4, 12, -4274, -4275, -4279, -4284, 1, 0, -4289, 0, 4, -4290, 1, -4294,
+-4296, -4306, 3, 0, -4310, 0, 0, 3, 0, 0, 0, 0, 0, -4311, 4, 0,
+0, 0, 0, 0, 0, 0, -4313, 0, 0, 0, 0, -4315, 0, 0, 0, 0,
+19, -4319, -4324, -4325, -4327, -4329, -4331, 0, 0, 0, 0, 0, -4332, 0, 0, 0,
+0, 0, 0, -4335, 1, 0, 1, 1, -4336, -4337, -4338, 0, 6, -4339, -4340, -4341,
+0, 0, -4343, -4352, -4354, -4357, -4358, 0, -4359, 0, -4360, -4364, 1, -4368, 1, 0,
+0, -4369, -4370, 5, 6, 3, 2, -4373, 1, -4375, 6, 10, 5, 3, 2, -4376,
+-4377, -4378, 1, 4, 3, 2, -4379, 7, 1, 3, -4380, -4381, -4385, -4386, -4391, -4392,
+-4394, 5, -4395, -4396, 8, 11, -4398, 10, -4399, -4400, -4404, -4405, -4409, -4412, 9, -4417,
+-4419, -4420, 12, 15, 0, 0, 4, 3, 7, 2, -4421, -4422, -4423, -4424, 0, 3,
+-4427, 2, -4429, 0, -4433, 0, -4434, 0, -4435, -4439, 7, -4441, -4443, 1, -4446,
+
+};
+
+static const uint16 emoji_forms_seq_index[] = {
+
+1727, 1725, 2460, 1729, 4218, 2369, 1209, 2796, 3824, 2735, 2309, 1211, 1909, 1537, 2199, 2878,
+1492, 2428, 3647, 2120, 306, 3559, 346, 2121, 854, 4016, 2572, 3708, 2524, 2216, 1937, 4114,
+307, 3807, 1033, 2602, 1949, 3065, 3066, 2575, 3063, 1845, 2243, 1289, 3064, 3062, 3525, 3247,
+3246, 3249, 1350, 3773, 3241, 4, 3819, 2236, 2237, 245, 3168, 2232, 2233, 3637, 4178, 2589,
+2229, 3222, 2223, 3813, 2225, 3785, 2899, 2220, 182, 3669, 2215, 3675, 3424, 2218, 3663, 3895,
+3893, 3617, 3891, 3415, 3416, 2377, 2272, 2081, 1872, 2206, 3805, 2363, 3600, 1973, 4172, 3435,
+2382, 1003, 1024, 2192, 165, 3281, 1897, 2301, 3155, 3425, 3426, 4056, 1110, 1840, 1889, 1901,
+3243, 1728, 3450, 4204, 1905, 1048, 3769, 978, 915, 909, 2108, 916, 3775, 1275, 1831, 1273,
+3536, 3334, 1279, 2600, 1975, 1277, 4206, 1220, 1396, 4436, 3624, 350, 3622, 1795, 1404, 1241,
+1870, 150, 1737, 1739, 2949, 113, 3221, 3324, 1322, 2449, 2541, 1013, 2538, 1136, 1982, 1017,
+2638, 1983, 3892, 3890, 3896, 3894, 2543, 698, 34, 2529, 1503, 1497, 2530, 2532, 1408, 4120,
+2521, 3569, 2995, 1149, 2993, 2518, 1509, 3587, 2519, 3253, 3032, 3473, 2621, 2525, 1525, 2998,
+2361, 1977, 2522, 2512, 2513, 368, 2517, 2514, 375, 4207, 1561, 1559, 2515, 2504, 1105, 720,
+736, 2505, 2920, 2502, 2503, 737, 2508, 2509, 2156, 1272, 2154, 1405, 1274, 1280, 1278, 2506,
+2507, 2496, 2494, 3185, 2819, 2820, 3608, 2489, 2486, 3638, 3186, 2492, 2493, 2812, 693, 2814,
+369, 2490, 2491, 2480, 2774, 2691, 2570, 2478, 2482, 2483, 1135, 3516, 3252, 1456, 2895, 2103,
+4155, 2755, 726, 74, 2758, 2734, 2615, 2761, 3292, 2387, 3325, 643, 1826, 2751, 2752, 3875,
+3958, 4198, 3906, 3238, 2340, 512, 4184, 3269, 3657, 1077, 1407, 3257, 3912, 1932, 3910, 3908,
+499, 4192, 3787, 2613, 2614, 2616, 493, 231, 2565, 4118, 2310, 219, 487, 2880, 3967, 4111,
+483, 1587, 72, 3955, 336, 1085, 477, 1125, 475, 3792, 1803, 3026, 538, 3772, 469, 470,
+3898, 4362, 523, 4360, 4123, 3151, 2708, 3153, 3152, 3643, 4353, 4352, 1359, 4358, 4357, 3836,
+10, 2629, 3835, 1495, 4351, 4350, 1584, 2047, 303, 4341, 4330, 2561, 3093, 2077, 4344, 4338,
+4094, 2200, 1489, 2365, 2389, 1082, 3965, 3701, 4411, 2645, 4379, 4150, 2648, 1115, 2217, 1380,
+3002, 3793, 3230, 4372, 3001, 3000, 2999, 4091, 623, 1453, 2992, 2990, 2997, 2996, 2994, 2234,
+347, 596, 3607, 3106, 2568, 3914, 209, 1541, 4035, 2911, 427, 4410, 1886, 3815, 2179, 2180,
+3542, 3543, 3544, 3478, 3477, 1713, 2903, 2176, 1719, 1721, 1715, 1717, 2177, 2178, 3277, 1942,
+3453, 2171, 4196, 1118, 2172, 2174, 3451, 3452, 3144, 3145, 3447, 2164, 2165, 2152, 2153, 3143,
+2723, 1957, 3439, 3440, 3433, 184, 2148, 3436, 3429, 3430, 3431, 3865, 24, 1807, 3427, 3428,
+3421, 3422, 3423, 2149, 3417, 3418, 3419, 3420, 3700, 2143, 1707, 1059, 3409, 3410, 218, 945,
+1355, 947, 163, 3162, 4011, 2141, 4013, 51, 2137, 2125, 3855, 2126, 77, 2132, 73, 282,
+1194, 2133, 2118, 782, 2112, 1157, 681, 2122, 2114, 2045, 2046, 2082, 1044, 1978, 1050, 3293,
+798, 3532, 3735, 3520, 1744, 3095, 1748, 1979, 2009, 1742, 4333, 4336, 4337, 4334, 2696, 4335,
+4214, 778, 2722, 1954, 1958, 1267, 1261, 1263, 2623, 1259, 2146, 3090, 1789, 2937, 3992, 3966,
+2644, 4007, 3995, 2901, 2740, 1300, 1292, 1624, 1057, 2591, 1056, 3729, 1626, 1620, 1622, 3973,
+545, 3998, 2731, 366, 9, 995, 2977, 913, 1183, 824, 2411, 4428, 2806, 1421, 1467, 4085,
+4097, 4195, 16, 1828, 620, 2668, 3276, 3627, 5, 3848, 914, 902, 1808, 3298, 3849, 4034,
+3846, 3847, 3845, 1758, 697, 1756, 1952, 2594, 3511, 1961, 1303, 3309, 1948, 3471, 1965, 754,
+43, 768, 1963, 1962, 1074, 2036, 210, 689, 1348, 1158, 1511, 1146, 1510, 2027, 286, 2889,
+2019, 2891, 2892, 249, 3195, 252, 2940, 3626, 2941, 1894, 2943, 4347, 4395, 4396, 4394, 1324,
+2603, 3501, 2536, 2092, 3491, 741, 3718, 283, 4426, 2871, 761, 3059, 3060, 2872, 3510, 3509,
+3907, 1437, 2471, 1419, 2015, 4009, 1291, 1269, 1299, 1295, 1372, 3288, 2724, 2405, 826, 624,
+1301, 3267, 20, 326, 1305, 1307, 1309, 2721, 3242, 3730, 1134, 1122, 2610, 3668, 2808, 2693,
+3825, 4033, 4392, 1821, 2341, 1820, 3024, 3341, 3018, 2037, 1079, 3860, 2001, 3100, 3088, 3935,
+3934, 3802, 272, 3506, 3406, 4062, 1472, 3981, 3909, 3913, 3911, 655, 178, 1671, 3367, 179,
+421, 3380, 287, 3290, 4152, 3384, 1446, 3932, 3931, 3703, 3379, 3287, 3184, 143, 1751, 1375,
+1747, 1745, 4124, 2127, 3189, 3260, 3391, 3388, 2293, 3188, 4420, 4419, 4422, 2362, 1432, 2049,
+4418, 2051, 1557, 2129, 2401, 1563, 1565, 2128, 2384, 3716, 324, 2298, 3761, 3767, 722, 2302,
+708, 2873, 3233, 1439, 3273, 2781, 2780, 2779, 444, 2248, 759, 344, 2876, 2654, 3639, 3646,
+2549, 3050, 1329, 224, 2827, 2276, 3980, 4412, 4416, 1969, 3883, 4413, 4414, 381, 4385, 4386,
+4387, 4388, 1326, 1849, 569, 380, 3803, 3868, 1199, 3680, 3105, 979, 4247, 417, 4246, 4245,
+4244, 1642, 4251, 4249, 4255, 580, 746, 1638, 4252, 2777, 4231, 4230, 577, 3504, 1227, 433,
+4238, 4237, 1086, 3483, 825, 2443, 1477, 3936, 2032, 2580, 2020, 3650, 926, 3280, 3972, 4128,
+4098, 2636, 4223, 3547, 3628, 794, 3546, 3553, 2418, 2419, 3725, 3550, 3557, 3554, 3619, 451,
+452, 448, 445, 446, 1127, 2364, 4434, 3005, 3006, 443, 3008, 440, 435, 430, 432, 426,
+2432, 416, 884, 885, 408, 248, 409, 404, 402, 3568, 396, 383, 744, 3518, 3530, 3926,
+3924, 4203, 1020, 3751, 1022, 4215, 2339, 2066, 2333, 2336, 2335, 3098, 3733, 2342, 2459, 2404,
+300, 299, 1476, 298, 1618, 2392, 2390, 296, 2344, 2346, 2379, 511, 4096, 3814, 3820, 2396,
+2394, 1637, 2397, 4211, 1834, 551, 3676, 1600, 1485, 870, 2064, 3670, 1520, 3664, 4415, 1604,
+3829, 3826, 3182, 3827, 1481, 2324, 4171, 617, 2317, 3882, 2588, 748, 2329, 1454, 2331, 2345,
+1448, 2583, 4063, 1414, 2264, 2265, 696, 572, 684, 2855, 2270, 2733, 2567, 4205, 3463, 4110,
+3648, 1343, 3636, 1310, 3888, 2592, 117, 588, 2647, 4064, 2254, 1401, 167, 2848, 581, 128,
+1461, 3902, 4080, 3900, 121, 1666, 2918, 2299, 537, 2913, 2385, 2287, 1468, 3256, 3602, 2885,
+524, 675, 521, 3313, 3720, 3311, 1258, 880, 622, 1256, 2017, 1254, 1252, 2639, 3953, 3091,
+771, 2767, 2916, 1482, 415, 3164, 3752, 2055, 4059, 140, 2427, 3194, 3740, 2053, 2431, 2088,
+2748, 103, 2004, 1560, 1225, 3579, 2754, 82, 4041, 2759, 4173, 2969, 3957, 3678, 4040, 420,
+4043, 3567, 1126, 2991, 1530, 227, 3633, 1528, 1369, 1393, 2576, 12, 1108, 1918, 3033, 529,
+2633, 4210, 61, 59, 1976, 2102, 4144, 1956, 3052, 2965, 1338, 1339, 1964, 3469, 3053, 3507,
+1874, 294, 3054, 3103, 549, 67, 2979, 63, 70, 3130, 71, 238, 230, 2853, 7, 4176,
+3989, 2651, 4001, 2663, 3858, 419, 3731, 3250, 4006, 924, 1430, 1363, 3467, 1345, 3466, 941,
+1501, 3465, 3464, 984, 752, 766, 1610, 1616, 1797, 4421, 1614, 1176, 919, 2059, 196, 2071,
+3108, 903, 4135, 1867, 66, 3061, 692, 1210, 4099, 4012, 1385, 2, 4103, 4137, 4101, 4100,
+2423, 4010, 2858, 1606, 1282, 4021, 2862, 1197, 4053, 2859, 4065, 3606, 1143, 3305, 2065, 656,
+1523, 644, 4138, 1701, 784, 2445, 3318, 4147, 1177, 1521, 1522, 1855, 3183, 1298, 1296, 1294,
+3181, 3179, 3203, 187, 3094, 3929, 2107, 3635, 3927, 1875, 17, 2535, 15, 3338, 13, 2370,
+21, 64, 3940, 3812, 3941, 3938, 1184, 1612, 3984, 1608, 3939, 4175, 4187, 3968, 3533, 2652,
+2439, 1114, 1893, 1985, 2631, 4217, 1589, 1591, 2058, 1078, 1052, 563, 1226, 1228, 204, 4028,
+57, 2667, 97, 3917, 302, 352, 500, 3234, 502, 546, 496, 1238, 747, 2578, 3574, 2033,
+4078, 1514, 68, 1513, 312, 2972, 2970, 2968, 1302, 2222, 3215, 4376, 4375, 2976, 3219, 2684,
+1306, 509, 4131, 4130, 2982, 4271, 468, 467, 1649, 3952, 4270, 4265, 4263, 465, 2950, 2948,
+2946, 1944, 4102, 2939, 2938, 2798, 484, 2906, 147, 2904, 2905, 479, 3854, 3856, 3747, 2956,
+2625, 2954, 472, 471, 3460, 473, 2958, 841, 3474, 2957, 425, 2801, 640, 3535, 1142, 1076,
+241, 1090, 1066, 961, 962, 963, 964, 2564, 756, 3645, 3851, 871, 2558, 1349, 84, 3960,
+189, 2843, 3197, 879, 881, 753, 289, 875, 876, 873, 3209, 3210, 1370, 1812, 3694, 1940,
+155, 882, 1131, 896, 897, 1250, 895, 1630, 1628, 890, 891, 767, 2593, 365, 3737, 3441,
+901, 898, 3442, 2465, 3996, 3443, 2619, 3444, 1890, 3445, 1597, 3500, 76, 3446, 4077, 3448,
+3449, 4004, 3454, 3455, 3331, 762, 3319, 3456, 3457, 3458, 2085, 648, 1378, 3459, 1806, 3461,
+2083, 3462, 3468, 653, 2919, 3475, 3505, 3790, 3545, 4439, 3411, 3412, 4154, 917, 3083, 3413,
+3414, 3434, 3437, 3438, 811, 3335, 810, 3323, 1580, 3784, 222, 2076, 236, 4145, 817, 816,
+814, 805, 2888, 804, 3837, 803, 309, 3161, 3169, 3173, 379, 1738, 377, 378, 374, 376,
+372, 373, 2653, 802, 806, 833, 832, 831, 837, 2026, 3080, 1069, 835, 818, 3131, 830,
+3133, 3132, 1517, 3134, 3286, 2936, 828, 3799, 669, 4384, 667, 2934, 772, 799, 2097, 797,
+2109, 1093, 777, 774, 1473, 3816, 2313, 4107, 2312, 1694, 1371, 3528, 3644, 2315, 2316, 1690,
+1152, 2865, 2987, 878, 3107, 75, 2326, 2325, 168, 2328, 3745, 2327, 605, 661, 2330, 2332,
+2318, 2974, 1172, 2975, 860, 838, 4193, 4005, 3337, 4190, 2320, 2319, 2322, 944, 1988, 4433,
+3248, 2784, 3722, 3870, 1435, 894, 268, 3245, 3821, 1064, 893, 892, 1088, 3794, 1911, 1061,
+2697, 2357, 317, 3609, 3665, 3659, 4293, 3671, 4295, 3677, 3732, 3015, 3012, 4284, 3809, 2573,
+321, 1474, 2124, 4306, 1734, 4308, 864, 4310, 1212, 1904, 4313, 3126, 2195, 2604, 3129, 3396,
+3128, 3125, 868, 867, 4323, 4324, 1815, 845, 840, 3157, 842, 2945, 949, 952, 855, 3299,
+1512, 2707, 953, 3254, 146, 148, 3744, 3971, 3326, 1443, 149, 2006, 1994, 137, 2841, 144,
+4088, 938, 626, 614, 134, 3672, 3759, 132, 129, 130, 133, 1417, 1124, 1852, 829, 2658,
+123, 1888, 125, 1245, 201, 126, 118, 1216, 4140, 516, 1214, 1992, 1045, 1039, 2552, 1051,
+2665, 2555, 2556, 2553, 2554, 4346, 1148, 3191, 50, 1195, 1189, 1450, 714, 2863, 745, 4194,
+3014, 3013, 3016, 1444, 2618, 1938, 2630, 3768, 3513, 3163, 4044, 2455, 1206, 1205, 1260, 1266,
+1268, 1538, 1262, 461, 1264, 665, 976, 663, 1133, 1993, 4164, 3804, 3085, 974, 3570, 284,
+3582, 2003, 1117, 975, 973, 4104, 90, 2577, 1971, 1972, 1564, 1562, 4092, 1602, 1556, 221,
+1428, 1091, 3899, 1598, 3903, 3905, 4027, 497, 2730, 4019, 1040, 4031, 1046, 3027, 1284, 1286,
+1288, 1290, 3028, 3030, 3970, 1695, 2011, 2374, 4051, 1058, 36, 35, 4169, 4166, 314, 3432,
+2012, 2013, 3240, 691, 2014, 291, 2010, 1190, 1196, 3527, 641, 1662, 99, 3127, 271, 2967,
+2367, 1458, 3707, 3084, 3082, 1654, 1674, 1950, 1658, 827, 1650, 4055, 4067, 800, 4159, 1553,
+3058, 3057, 4163, 4162, 1551, 277, 3056, 1547, 2563, 119, 1711, 1709, 900, 65, 843, 3616,
+823, 3604, 1128, 553, 3685, 1735, 2698, 3709, 1741, 3479, 301, 1353, 1733, 1347, 304, 1545,
+1995, 1445, 522, 1365, 3482, 4050, 2416, 243, 1842, 1038, 1784, 1783, 1786, 1330, 1328, 199,
+1782, 911, 3381, 1596, 2007, 4117, 3385, 3374, 2417, 3945, 1571, 1575, 1567, 2900, 3302, 1804,
+1899, 1792, 1374, 3216, 1182, 3368, 3217, 3963, 666, 3779, 3736, 3362, 2626, 2680, 821, 786,
+2710, 664, 1546, 78, 3771, 3352, 1161, 1550, 1548, 1542, 1554, 1552, 4326, 4165, 161, 4177,
+1817, 1060, 1819, 1084, 2609, 2795, 3206, 3783, 2450, 2766, 4054, 174, 2768, 1160, 1813, 2769,
+3490, 3251, 172, 3263, 2762, 2763, 3097, 1433, 2764, 135, 3746, 2765, 1415, 2775, 208, 3871,
+3873, 2776, 2770, 162, 3867, 2771, 2772, 2773, 166, 3073, 2750, 2753, 2746, 2747, 2579, 2749,
+3109, 1451, 4108, 2845, 2756, 2757, 4014, 2857, 1898, 2709, 3760, 262, 1595, 1593, 1640, 2887,
+1644, 1646, 2823, 2824, 2323, 2826, 2321, 2922, 2923, 3386, 2924, 2925, 2811, 2813, 2778, 740,
+3878, 2821, 3395, 2822, 2815, 3049, 2816, 3405, 1908, 2818, 1749, 1367, 2158, 3021, 2314, 2159,
+1673, 2161, 311, 4197, 1178, 4209, 2348, 2355, 1810, 3231, 3503, 217, 912, 183, 2105, 2375,
+1912, 1730, 1924, 1726, 1724, 1722, 2337, 1846, 1816, 1882, 1876, 2334, 1966, 1960, 1968, 1853,
+1015, 2692, 1381, 1012, 1420, 4442, 1011, 4444, 4443, 4446, 4445, 2550, 3495, 2581, 2642, 1014,
+1877, 1775, 1769, 1811, 1881, 1880, 1336, 1029, 1763, 1762, 1000, 1002, 1001, 1276, 695, 996,
+1191, 2430, 990, 1382, 3218, 3925, 998, 3728, 991, 997, 1008, 1914, 1007, 1010, 1364, 1856,
+1009, 1447, 1913, 1004, 1006, 1526, 1005, 929, 2041, 3502, 1478, 1104, 3096, 928, 936, 930,
+922, 3852, 948, 4082, 4191, 2713, 2712, 1265, 4437, 1796, 1536, 4438, 1167, 633, 1402, 269,
+632, 4042, 1843, 2634, 4039, 2622, 27, 25, 2100, 40, 618, 3943, 1668, 606, 3595, 3584,
+3994, 4109, 2399, 4121, 2402, 3176, 733, 23, 4148, 19, 719, 1861, 501, 2230, 527, 3791,
+2227, 2727, 2277, 62, 2897, 951, 8, 1594, 1592, 176, 2269, 274, 3068, 555, 2267, 3692,
+2612, 2268, 2266, 1233, 2239, 2068, 2297, 3171, 2263, 2296, 3154, 3717, 2231, 2300, 2278, 2275,
+3051, 2304, 603, 2273, 2274, 3757, 2281, 3392, 2279, 3394, 3389, 2286, 2283, 2284, 2271, 2290,
+3408, 3407, 2711, 3401, 3404, 2253, 3377, 1023, 795, 2251, 3373, 3372, 4048, 1332, 3180, 2249,
+3387, 2955, 783, 785, 3383, 3382, 2250, 1930, 3363, 1814, 2247, 611, 3359, 2235, 2261, 599,
+3371, 918, 660, 2962, 921, 715, 3346, 729, 2262, 2803, 2259, 2221, 2953, 2219, 2226, 2373,
+3355, 3354, 3349, 3348, 2598, 2260, 2257, 2258, 2851, 815, 2255, 2256, 4151, 2203, 305, 2832,
+2307, 2830, 2308, 809, 320, 4314, 3739, 1384, 2184, 2305, 2306, 2282, 1449, 2280, 2194, 4425,
+1018, 4427, 2198, 4073, 2760, 4071, 4424, 4069, 2294, 2291, 2292, 2289, 214, 1883, 1884, 1885,
+1140, 1887, 213, 212, 211, 1129, 1111, 1946, 507, 4146, 313, 3601, 1790, 1297, 2894, 1293,
+2069, 1802, 1491, 3923, 124, 109, 122, 3044, 1075, 1162, 2099, 3919, 234, 120, 220, 1113,
+3046, 946, 3045, 1147, 943, 4174, 1833, 2022, 3798, 2034, 1643, 1809, 1141, 131, 1426, 3832,
+3726, 4273, 1499, 4186, 4023, 1493, 1507, 3175, 2840, 142, 2849, 608, 138, 1947, 1703, 136,
+2732, 1705, 2852, 2025, 3534, 2794, 910, 616, 4079, 4290, 2252, 3522, 1308, 1164, 1304, 171,
+3715, 153, 683, 4400, 1767, 1768, 2557, 3620, 1487, 1677, 2590, 1980, 177, 738, 3749, 1170,
+739, 2601, 175, 1981, 338, 3702, 2024, 4399, 4398, 1679, 1752, 1753, 4061, 4397, 4049, 2875,
+3872, 2467, 3866, 0, 1836, 160, 3198, 1779, 4168, 158, 156, 2435, 2800, 356, 1358, 1346,
+1352, 154, 980, 3167, 982, 1621, 2914, 3690, 152, 1065, 151, 3565, 1502, 671, 1544, 557,
+164, 727, 923, 1681, 4250, 247, 927, 1479, 1683, 101, 1490, 258, 2886, 4277, 4256, 1689,
+3573, 3549, 4274, 1323, 1325, 3586, 1687, 1605, 565, 1838, 226, 1097, 1607, 1601, 1603, 765,
+1599, 2381, 1337, 3220, 2786, 3187, 1144, 1379, 1138, 1496, 4036, 3255, 407, 1366, 413, 4188,
+323, 400, 401, 398, 1383, 3521, 3721, 985, 987, 2347, 393, 1215, 391, 1736, 397, 1740,
+395, 288, 989, 1732, 1151, 388, 1311, 386, 4329, 1315, 450, 447, 91, 3224, 454, 1313,
+1319, 4361, 441, 721, 315, 1317, 4354, 442, 3213, 3201, 2879, 3640, 32, 436, 3376, 434,
+3004, 3884, 3886, 414, 731, 3007, 424, 418, 114, 717, 1340, 1376, 2799, 3202, 337, 1418,
+1871, 3611, 2000, 4240, 4241, 1859, 2973, 3351, 723, 3632, 1436, 318, 319, 709, 102, 3291,
+2551, 594, 335, 104, 3142, 598, 597, 1847, 1498, 1850, 1316, 1314, 295, 1318, 1851, 1848,
+1312, 3204, 4002, 1692, 2091, 1696, 3266, 3649, 1800, 280, 1798, 1698, 4046, 3192, 2380, 3120,
+4068, 2660, 1785, 4158, 4090, 1991, 3122, 3123, 3615, 244, 2042, 2044, 2043, 198, 3770, 2040,
+3101, 2354, 1576, 205, 2656, 4060, 749, 285, 4441, 1130, 4355, 2368, 3859, 1706, 3330, 1704,
+3512, 181, 1710, 3833, 1112, 1708, 1702, 3682, 1486, 1098, 1805, 4331, 3399, 1682, 1342, 190,
+3476, 2388, 526, 4072, 3480, 935, 934, 1910, 3748, 3270, 2860, 4212, 4075, 1072, 1539, 4087,
+3089, 310, 3719, 4332, 4348, 2453, 732, 1406, 1484, 322, 3321, 3333, 637, 2420, 647, 3597,
+3365, 3364, 3523, 2498, 2499, 4086, 2497, 3239, 2495, 3969, 1440, 2835, 2366, 2488, 270, 1391,
+2487, 2484, 3915, 1629, 1635, 2706, 2481, 4112, 2479, 2544, 2545, 2542, 2050, 362, 2048, 364,
+2539, 2534, 359, 3315, 361, 3614, 355, 2844, 357, 3828, 2526, 354, 3949, 2649, 1590, 1588,
+3961, 2516, 3997, 3985, 3158, 403, 3993, 2510, 3092, 3885, 1423, 685, 54, 3576, 925, 3378,
+1691, 3588, 3227, 2311, 3306, 2110, 2810, 3226, 18, 1697, 3999, 642, 3987, 654, 2472, 1253,
+1251, 1257, 1801, 651, 1255, 730, 760, 1508, 550, 554, 645, 556, 4300, 1208, 1016, 2725,
+3921, 2737, 486, 1781, 558, 541, 542, 543, 480, 3666, 2030, 674, 2018, 544, 1159, 1967,
+2659, 548, 533, 534, 293, 2454, 1746, 1341, 535, 1457, 539, 540, 3937, 520, 3300, 954,
+960, 942, 4430, 3499, 2448, 609, 972, 585, 4432, 4431, 3081, 1844, 586, 999, 587, 3244,
+589, 649, 590, 582, 281, 3485, 567, 2690, 568, 574, 559, 3498, 2295, 560, 3278, 2057,
+2054, 438, 439, 562, 566, 3630, 3879, 3642, 3877, 1101, 3514, 3172, 105, 3492, 1019, 95,
+1504, 93, 1036, 1864, 4119, 351, 1581, 658, 1585, 1941, 428, 4200, 1186, 1192, 2839, 1464,
+437, 1858, 718, 1222, 1224, 716, 1926, 3689, 1928, 547, 1455, 1925, 2715, 2831, 2829, 1067,
+1578, 1651, 3258, 384, 4182, 2828, 2703, 1655, 1754, 3577, 2147, 3861, 3863, 394, 2151, 1357,
+1427, 1351, 2155, 4125, 239, 2163, 1540, 3272, 1217, 2167, 2168, 3881, 2170, 743, 764, 2173,
+1106, 1173, 750, 1543, 2597, 4401, 4032, 4402, 2182, 4403, 4404, 4020, 2039, 3566, 1959, 3578,
+1955, 1943, 2113, 2867, 2115, 2116, 2117, 1891, 2119, 1903, 2838, 1179, 3605, 2134, 2135, 2587,
+453, 2961, 2139, 1459, 1452, 2142, 988, 1390, 2145, 1155, 3297, 788, 1185, 2528, 2527, 2850,
+1466, 58, 60, 1094, 1921, 1657, 2739, 1659, 3200, 1653, 2672, 250, 22, 3539, 349, 3538,
+353, 1633, 1631, 1213, 3541, 3540, 3223, 790, 595, 1109, 1463, 2807, 2338, 3235, 2456, 1555,
+1247, 2896, 1549, 2893, 1480, 4142, 30, 4045, 4057, 330, 2927, 3147, 3146, 1062, 2797, 2378,
+4070, 2928, 3470, 3472, 325, 3603, 2461, 329, 2433, 628, 3776, 2854, 2842, 4058, 2566, 2477,
+2476, 2462, 3259, 1780, 2571, 1777, 107, 724, 2802, 2391, 1778, 3864, 3862, 1917, 1916, 1915,
+96, 3166, 734, 676, 1570, 3526, 3190, 2628, 3087, 3265, 2343, 3484, 3704, 2640, 2669, 2833,
+2657, 2825, 3317, 1102, 1500, 1174, 2917, 4106, 2664, 3831, 2921, 3834, 1787, 261, 1356, 1333,
+263, 257, 45, 255, 254, 780, 3811, 2376, 229, 2817, 3316, 1361, 3673, 3667, 3, 1,
+1586, 1999, 904, 3723, 3517, 3817, 3823, 2075, 3795, 2063, 2437, 2837, 4052, 2912, 2090, 4089,
+627, 2741, 2742, 2008, 341, 47, 2743, 2072, 3763, 861, 2744, 2790, 2745, 278, 763, 1760,
+4047, 139, 4262, 1776, 2635, 2089, 4266, 14, 2101, 2881, 757, 1945, 576, 1611, 2883, 1470,
+1237, 1235, 3156, 1231, 1791, 4288, 4289, 4282, 4084, 536, 1639, 1645, 1647, 170, 2804, 629,
+1641, 593, 592, 591, 773, 3777, 770, 735, 700, 2023, 668, 3838, 192, 3284, 781, 779,
+2469, 776, 775, 1866, 801, 3212, 3839, 112, 793, 791, 789, 787, 3159, 3497, 807, 3366,
+2371, 677, 3369, 2907, 3370, 2689, 3357, 2701, 813, 812, 3356, 690, 173, 678, 3048, 3571,
+820, 699, 3295, 3358, 1573, 2429, 836, 3610, 728, 3360, 4074, 1579, 1180, 3350, 1577, 2056,
+2864, 1285, 1283, 431, 2485, 3296, 1100, 3353, 3342, 1150, 3830, 81, 3344, 3343, 3515, 3612,
+3345, 1627, 79, 3508, 2501, 2500, 3390, 1664, 4435, 2074, 2523, 4183, 1465, 4429, 3800, 4423,
+4417, 2520, 4405, 4167, 3075, 4179, 2511, 4373, 1270, 1902, 688, 673, 672, 670, 2792, 1373,
+1397, 2540, 1193, 2531, 2537, 4371, 3119, 4370, 3121, 4369, 1878, 4368, 2787, 4367, 713, 4366,
+4365, 4364, 4015, 2021, 2352, 2351, 2350, 2349, 1103, 4393, 874, 701, 877, 883, 889, 886,
+3104, 1862, 260, 615, 4380, 4381, 4382, 4383, 1929, 1200, 1927, 887, 950, 4213, 899, 4201,
+906, 908, 905, 839, 650, 981, 846, 711, 844, 850, 3261, 851, 2607, 510, 1394, 847,
+849, 852, 853, 858, 712, 169, 4018, 251, 859, 4261, 4260, 3294, 856, 490, 4264, 4267,
+2031, 4269, 4268, 857, 863, 865, 4272, 866, 872, 869, 1153, 3211, 1652, 474, 1656, 888,
+3199, 2868, 80, 3023, 1984, 2463, 3598, 2717, 1460, 2729, 3076, 1998, 3067, 1986, 704, 705,
+232, 2157, 792, 1936, 246, 702, 703, 2562, 3279, 610, 1041, 1035, 1047, 1053, 931, 1934,
+1935, 3110, 933, 932, 1931, 3361, 94, 2661, 2673, 4389, 1175, 1863, 3850, 1021, 1835, 4391,
+3928, 4239, 4156, 3047, 3876, 3922, 3011, 956, 3009, 959, 3020, 958, 3727, 2202, 2131, 2130,
+2446, 1970, 2944, 1829, 3031, 3959, 1873, 4180, 1841, 2452, 3548, 2458, 2856, 2464, 2447, 3810,
+3944, 3947, 3625, 2984, 1171, 3946, 2679, 957, 2677, 2676, 1239, 2144, 1083, 1535, 3962, 2140,
+2415, 3797, 4157, 2136, 3755, 2695, 3951, 3743, 2846, 1399, 2166, 1034, 2470, 1032, 2162, 3656,
+3662, 1054, 1042, 3493, 3674, 2150, 3818, 4083, 2675, 4095, 4122, 2473, 2475, 1386, 1119, 3631,
+3205, 2175, 3193, 2942, 3686, 3593, 3034, 2169, 3581, 3036, 1242, 3139, 1246, 3035, 2704, 2783,
+2785, 2646, 4208, 2624, 2782, 1989, 2214, 2457, 4363, 1187, 1049, 4374, 4359, 4356, 1516, 3629,
+1055, 1043, 1527, 4127, 1524, 4115, 2599, 2197, 769, 3741, 3753, 1759, 1757, 2395, 2035, 1081,
+3149, 1699, 2466, 2870, 1693, 3150, 3660, 2882, 636, 2468, 3072, 6, 3071, 3069, 185, 1892,
+191, 4202, 940, 3237, 621, 635, 3982, 4408, 1063, 188, 3225, 1377, 2444, 1169, 3320, 2788,
+180, 275, 1684, 3758, 3964, 4026, 3801, 2718, 3560, 3561, 3562, 3563, 3564, 1409, 498, 1163,
+3684, 2902, 686, 3580, 2884, 4226, 1392, 202, 1755, 203, 3070, 2398, 680, 200, 2793, 345,
+1243, 1156, 316, 273, 725, 276, 259, 141, 2002, 1416, 3322, 2016, 3806, 2441, 687, 3988,
+1434, 193, 194, 1907, 159, 3699, 1895, 2029, 1121, 3575, 3487, 3765, 955, 4029, 2093, 4113,
+4017, 1669, 370, 371, 1506, 3397, 38, 3398, 2406, 1974, 1389, 3400, 3079, 1712, 4022, 69,
+1425, 1438, 2062, 11, 215, 1731, 612, 3714, 3308, 256, 1534, 1092, 253, 1532, 3679, 3651,
+1830, 2714, 3653, 3654, 3655, 1558, 3781, 3289, 3301, 2244, 3496, 2061, 1832, 3282, 3285, 1354,
+1360, 607, 367, 2094, 2700, 2353, 1634, 1636, 423, 1632, 1168, 3572, 3307, 2670, 1788, 127,
+225, 1906, 235, 848, 195, 1068, 2682, 1181, 1413, 233, 342, 2204, 343, 28, 29, 157,
+264, 2067, 2079, 2915, 2866, 2425, 2424, 4222, 2422, 2421, 4220, 31, 4030, 3160, 3102, 4143,
+4066, 4134, 1116, 1774, 1080, 2096, 1505, 3618, 1772, 1771, 1770, 3897, 2596, 53, 55, 44,
+2716, 46, 2705, 4254, 1331, 1868, 1865, 48, 49, 822, 1281, 3789, 1287, 2393, 2650, 37,
+1582, 3738, 39, 339, 41, 3336, 4105, 2728, 2098, 710, 4227, 3268, 4225, 3705, 2861, 4003,
+3681, 2789, 1025, 1099, 1026, 3327, 1027, 1395, 207, 758, 2569, 1221, 3991, 1223, 4279, 4278,
+2662, 1219, 4275, 4219, 2637, 1761, 3874, 3724, 1613, 2285, 3880, 3713, 2288, 4321, 1515, 2585,
+2584, 1617, 1615, 4315, 4221, 4328, 2359, 2360, 4349, 2358, 3038, 2356, 4322, 4286, 1165, 1609,
+4302, 4301, 3208, 4299, 4298, 3042, 4312, 4311, 1201, 3039, 1202, 4307, 1204, 1203, 292, 1990,
+2123, 1188, 808, 1660, 1623, 4160, 3040, 2559, 3796, 4076, 3332, 1750, 1700, 186, 4440, 1648,
+4325, 971, 2586, 970, 1207, 2933, 2932, 2926, 1412, 26, 969, 2935, 1619, 1676, 1678, 1625,
+2960, 2959, 1670, 334, 967, 3950, 2952, 2951, 4280, 1824, 4276, 2963, 4170, 2738, 751, 4281,
+1675, 4287, 4199, 3641, 4283, 2966, 2964, 992, 2383, 4285, 4294, 3613, 2988, 1533, 2986, 2985,
+4296, 3086, 4297, 2989, 2980, 4291, 2908, 2978, 4161, 328, 399, 2981, 2605, 4292, 33, 1442,
+405, 3029, 4303, 406, 4304, 652, 411, 410, 4305, 1095, 1953, 382, 385, 4309, 387, 4318,
+389, 2929, 4319, 390, 4320, 392, 4316, 4317, 4327, 327, 2407, 2595, 2196, 1939, 3857, 1951,
+3135, 2160, 2190, 4093, 1794, 449, 2189, 2188, 2187, 2438, 965, 862, 2186, 1137, 920, 2185,
+819, 422, 706, 796, 1410, 2183, 2213, 3766, 2212, 2211, 2210, 613, 2209, 2208, 2805, 1718,
+2207, 2205, 1987, 2201, 2246, 4126, 3596, 2245, 2414, 2242, 2241, 2240, 223, 1475, 2238, 1070,
+2087, 3055, 2005, 2608, 2095, 92, 2720, 3711, 3687, 3022, 1680, 3328, 1030, 1686, 1688, 579,
+4340, 4343, 4342, 575, 2617, 4339, 578, 1766, 1765, 1764, 145, 583, 584, 2666, 3590, 3778,
+564, 348, 308, 3594, 530, 561, 528, 571, 1249, 573, 1672, 3901, 3592, 3589, 570, 3558,
+3591, 3556, 3555, 1031, 2574, 3552, 3551, 1429, 2409, 1441, 3077, 630, 2442, 552, 631, 634,
+525, 531, 532, 4038, 4008, 3978, 2434, 3942, 2836, 3930, 1663, 2874, 4243, 4242, 2546, 4216,
+2080, 994, 993, 4236, 4235, 4234, 4233, 4232, 2436, 2038, 4229, 3634, 4259, 4258, 4257, 4136,
+3583, 1773, 4253, 3956, 2947, 1244, 3853, 4248, 1248, 1218, 2694, 657, 2426, 1240, 625, 1320,
+3983, 1154, 52, 1398, 3979, 2073, 1823, 2655, 1232, 2408, 42, 2410, 2412, 2643, 907, 2641,
+1037, 707, 3329, 2674, 1566, 2548, 3904, 1574, 2547, 1572, 2611, 646, 3283, 1568, 3986, 360,
+1996, 358, 3494, 834, 363, 1139, 1321, 1411, 1145, 242, 3948, 228, 3236, 3174, 1483, 1073,
+3165, 4024, 3177, 3599, 333, 2688, 4181, 2138, 332, 3170, 2869, 4189, 1132, 4141, 1896, 4153,
+638, 2910, 4406, 2898, 4409, 2403, 2086, 4407, 3262, 983, 2582, 3481, 694, 2699, 682, 2084,
+3695, 2028, 1368, 2687, 2386, 2052, 4037, 2372, 4025, 3232, 1818, 1229, 2847, 2181, 2890, 476,
+478, 1531, 1469, 1529, 482, 481, 485, 456, 2060, 2909, 3271, 3402, 3403, 2440, 4149, 3393,
+455, 1743, 458, 3524, 457, 3697, 460, 4345, 459, 462, 464, 463, 466, 504, 503, 506,
+3486, 505, 1120, 508, 514, 3375, 340, 3916, 3918, 513, 3920, 517, 1519, 3585, 1518, 429,
+515, 519, 4116, 3339, 518, 3780, 1028, 488, 489, 3489, 2070, 2474, 3688, 755, 2719, 492,
+1569, 3347, 491, 1123, 495, 265, 3954, 3519, 279, 3764, 966, 3537, 937, 3207, 639, 494,
+1583, 679, 939, 2560, 3196, 1933, 1825, 88, 1837, 1198, 2451, 98, 2111, 100, 3782, 742,
+2931, 111, 2930, 3141, 3140, 106, 3138, 3137, 110, 108, 3710, 3754, 412, 290, 4185, 3652,
+2726, 3693, 2400, 3661, 2606, 116, 3488, 206, 2078, 2834, 3788, 3312, 3742, 3808, 1799, 1234,
+2104, 1236, 3786, 659, 3264, 662, 240, 3822, 2671, 83, 85, 1230, 3658, 2736, 87, 86,
+3756, 1071, 56, 89, 1166, 1922, 115, 1923, 4081, 331, 3041, 1685, 4129, 2809, 3228, 4132,
+4133, 1920, 3314, 1087, 2303, 1919, 3529, 968, 197, 3698, 1431, 1661, 1107, 3933, 604, 3734,
+1667, 1665, 2791, 601, 602, 2413, 1388, 3691, 600, 3712, 1424, 2971, 1462, 216, 2533, 4378,
+4377, 2877, 2620, 3840, 2632, 4390, 3844, 619, 1900, 1827, 3762, 3683, 1387, 1793, 1403, 3843,
+3621, 3842, 3623, 1997, 3841, 1822, 1854, 3304, 1869, 1879, 1857, 3010, 1400, 3774, 3706, 3003,
+2686, 1327, 297, 4139, 3019, 2678, 3017, 3037, 3043, 3025, 3078, 3074, 3116, 3099, 1334, 1335,
+3117, 3114, 1471, 3531, 1494, 1860, 3115, 3112, 3750, 3113, 3111, 3178, 237, 3148, 3136, 3118,
+1344, 3696, 1362, 3124, 3310, 3303, 3990, 1488, 3340, 4000, 1096, 3275, 2702, 1720, 1714, 1716,
+3274, 986, 1089, 3214, 3974, 3975, 3976, 3977, 2627, 4228, 2685, 1271, 2683, 1422, 977, 3869,
+2681, 2106, 3889, 2193, 266, 2191, 4224, 2228, 3887, 267, 1839, 2224, 3229, 1723, 2983,
+
+};
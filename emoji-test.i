@@ -1,6 +1,6 @@
 // Generated from emoji-test.txt by 'premake5 tables'.
 
-static const struct interval emojis[] = {
+inline constexpr struct interval emojis[] = {
 
 { 0x231A, 0x231B },
 { 0x23E9, 0x23EC },
@@ -86,7 +86,7 @@ static const struct interval emojis[] = {
 
 };
 
-static const struct interval mono_emojis[] = {
+inline constexpr struct interval mono_emojis[] = {
 
 { 0x231A, 0x231B },
 { 0x23E9, 0x23EC },
@@ -126,7 +126,7 @@ static const struct interval mono_emojis[] = {
 
 };
 
-static const struct interval possible_unqualified_half_width[] = {
+inline constexpr struct interval possible_unqualified_half_width[] = {
 
 { 0xA9, 0xA9 },
 { 0xAE, 0xAE },
@@ -246,3 +246,86 @@ static const struct interval possible_unqualified_half_width[] = {
 { 0x1F6F3, 0x1F6F3 },
 
 };
+
+inline constexpr struct interval emojis_15_0[] = {
+
+{ 0x1F6DC, 0x1F6DC },
+{ 0x1FA75, 0x1FA77 },
+{ 0x1FA87, 0x1FA88 },
+{ 0x1FAAD, 0x1FAAF },
+{ 0x1FABB, 0x1FABD },
+{ 0x1FABF, 0x1FABF },
+{ 0x1FACE, 0x1FACF },
+{ 0x1FADA, 0x1FADB },
+{ 0x1FAE8, 0x1FAE8 },
+{ 0x1FAF7, 0x1FAF8 },
+
+};
+
+inline constexpr struct interval emojis_14_0[] = {
+
+{ 0x1F6DD, 0x1F6DF },
+{ 0x1F7F0, 0x1F7F0 },
+{ 0x1F979, 0x1F979 },
+{ 0x1F9CC, 0x1F9CC },
+{ 0x1FA7B, 0x1FA7C },
+{ 0x1FAA9, 0x1FAAC },
+{ 0x1FAB7, 0x1FABA },
+{ 0x1FAC3, 0x1FAC5 },
+{ 0x1FAD7, 0x1FAD9 },
+{ 0x1FAE0, 0x1FAE7 },
+{ 0x1FAF0, 0x1FAF6 },
+
+};
+
+inline constexpr struct interval emojis_13_0[] = {
+
+{ 0x1F6D6, 0x1F6D7 },
+{ 0x1F6FB, 0x1F6FC },
+{ 0x1F90C, 0x1F90C },
+{ 0x1F972, 0x1F972 },
+{ 0x1F977, 0x1F978 },
+{ 0x1F9A3, 0x1F9A4 },
+{ 0x1F9AB, 0x1F9AD },
+{ 0x1F9CB, 0x1F9CB },
+{ 0x1FA74, 0x1FA74 },
+{ 0x1FA83, 0x1FA86 },
+{ 0x1FA96, 0x1FAA8 },
+{ 0x1FAB0, 0x1FAB6 },
+{ 0x1FAC0, 0x1FAC2 },
+{ 0x1FAD0, 0x1FAD6 },
+
+};
+
+inline constexpr struct interval emojis_12_0[] = {
+
+{ 0x1F6D5, 0x1F6D5 },
+{ 0x1F6FA, 0x1F6FA },
+{ 0x1F7E0, 0x1F7EB },
+{ 0x1F90D, 0x1F90F },
+{ 0x1F93F, 0x1F93F },
+{ 0x1F971, 0x1F971 },
+{ 0x1F97B, 0x1F97B },
+{ 0x1F9A5, 0x1F9AA },
+{ 0x1F9AE, 0x1F9AF },
+{ 0x1F9BA, 0x1F9BF },
+{ 0x1F9C3, 0x1F9CA },
+{ 0x1F9CD, 0x1F9CF },
+{ 0x1FA70, 0x1FA73 },
+{ 0x1FA78, 0x1FA7A },
+{ 0x1FA80, 0x1FA82 },
+{ 0x1FA90, 0x1FA95 },
+
+};
+
+inline constexpr struct emoji_version emoji_versions[] = {
+
+{ 150, emojis_15_0, _countof(emojis_15_0) },
+{ 140, emojis_14_0, _countof(emojis_14_0) },
+{ 131, nullptr, 0 },
+{ 130, emojis_13_0, _countof(emojis_13_0) },
+{ 121, nullptr, 0 },
+{ 120, emojis_12_0, _countof(emojis_12_0) },
+{ 110, nullptr, 0 },
+
+};
@@ -0,0 +1,148 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "emoji_forms.h"
+
+#include "emoji-forms.i"
+
+#include <atomic>
+#include <mutex>
+
+static_assert(_countof(emoji_forms_ucs_disp) == _countof(emoji_forms_ucs_index), "emoji_forms_ucs hash size mismatch");
+static_assert(_countof(emoji_forms_seq_disp) == _countof(emoji_forms), "emoji_forms_seq hash size mismatch");
+static_assert(_countof(emoji_forms_seq_index) == _countof(emoji_forms), "emoji_forms_seq hash size mismatch");
+
+// The widths of the forms for one generation of the wcwidth modes.  A table
+// is never changed once it's published, so threads can read it without a
+// lock.  A superseded table is retired like an unloaded profile, and freed
+// once no reader scope can still be using it.
+struct form_widths
+{
+    uint32          generation;
+    uint8           widths[_countof(emoji_forms)];
+};
+
+static std::atomic<const form_widths*> s_form_widths = nullptr;
+static std::mutex s_form_widths_mutex;
+
+//------------------------------------------------------------------------------
+static void free_form_widths(const void* data)
+{
+    delete static_cast<const form_widths*>(data);
+}
+
+//------------------------------------------------------------------------------
+// FNV-1 over the key bytes, starting from the given seed.  This must match
+// perfect_hash() in premake5.lua, which generates the tables.
+static uint32 perfect_hash(uint32 seed, const uint8* key, uint32 len)
+{
+    uint32 h = seed ? seed : 0x811c9dc5;
+    for (uint32 i = 0; i < len; ++i)
+        h = (h * 0x01000193) ^ key[i];
+    return h;
+}
+
+//------------------------------------------------------------------------------
+static uint32 perfect_hash_slot(const int32* disp, uint32 n, const uint8* key, uint32 len)
+{
+    const int32 d = disp[perfect_hash(0, key, len) % n];
+    return (d < 0) ? uint32(-d - 1) : perfect_hash(uint32(d), key, len) % n;
+}
+
+//------------------------------------------------------------------------------
+const emoji_form_sequence* get_emoji_form_sequence(char32_t ucs, uint32* count)
+{
+    if (ucs > 0x10ffff)
+        return nullptr;
+
+    const uint8 key[] = { uint8(ucs), uint8(ucs >> 8), uint8(ucs >> 16) };
+    const uint32 slot = perfect_hash_slot(emoji_forms_ucs_disp, _countof(emoji_forms_ucs_disp), key, _countof(key));
+    const uint32 first = emoji_forms_ucs_index[slot];
+    if (emoji_forms[first].ucs != ucs)
+        return nullptr;
+
+    assert(first == 0 || emoji_forms[first - 1].ucs < ucs);
+
+    if (count)
+    {
+        uint32 last = first + 1;
+        while (last < _countof(emoji_forms) && emoji_forms[last].ucs == ucs)
+            ++last;
+        *count = last - first;
+    }
+
+    return emoji_forms + first;
+}
+
+//------------------------------------------------------------------------------
+const emoji_form_sequence* get_emoji_form_sequences(uint32& count)
+{
+    count = _countof(emoji_forms);
+    return emoji_forms;
+}
+
+//------------------------------------------------------------------------------
+const emoji_form_sequence* get_emoji_form_sequence(const char* s, uint32 len)
+{
+    if (!len)
+        return nullptr;
+
+    const uint8* key = reinterpret_cast<const uint8*>(s);
+    const uint32 slot = perfect_hash_slot(emoji_forms_seq_disp, _countof(emoji_forms_seq_disp), key, len);
+    const emoji_form_sequence* x = emoji_forms + emoji_forms_seq_index[slot];
+    if (strncmp(x->seq, s, len) != 0 || x->seq[len])
+        return nullptr;
+
+    return x;
+}
+
+//------------------------------------------------------------------------------
+uint32 get_emoji_form_width(const emoji_form_sequence* sequence)
+{
+    assert(sequence >= emoji_forms && sequence < emoji_forms + _countof(emoji_forms));
+
+    // The widths depend on the wcwidth modes, so they're computed once each
+    // time the modes change.  The reader scope keeps the table alive until
+    // the width has been read from it.
+    wcwidth_reader_scope reader;
+    const uint32 generation = get_wcwidth_generation();
+    const form_widths* table = s_form_widths.load(std::memory_order_acquire);
+    if (!table || table->generation != generation)
+    {
+        std::lock_guard<std::mutex> lock(s_form_widths_mutex);
+        table = s_form_widths.load(std::memory_order_acquire);
+        if (!table || table->generation != generation)
+        {
+            // The generation is read before the profile, so that if the modes
+            // change meanwhile the table is already stale instead of wrong.
+            const wcwidth_profile* const profile = get_wcwidth_profile();
+
+            form_widths* widths = new form_widths;
+            widths->generation = generation;
+            for (uint32 i = 0; i < _countof(emoji_forms); ++i)
+            {
+                const char* seq = emoji_forms[i].seq;
+                widths->widths[i] = uint8(wcswidth(seq, uint32(strlen(seq)), profile));
+            }
+
+            const form_widths* const old = s_form_widths.exchange(widths, std::memory_order_acq_rel);
+            if (old)
+                retire_wcwidth_data(old, free_form_widths);
+            table = widths;
+        }
+    }
+
+    return table->widths[sequence - emoji_forms];
+}
+
+//------------------------------------------------------------------------------
+int32 known_sequence_width(const char* s, uint32 len)
+{
+    const emoji_form_sequence* sequence = get_emoji_form_sequence(s, len);
+    if (!sequence)
+        return -1;
+    return get_emoji_form_width(sequence);
+}
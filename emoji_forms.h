@@ -0,0 +1,28 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+struct emoji_form_sequence
+{
+    char32_t        ucs;
+    const char*     seq;
+    const char*     desc;
+};
+
+// Returns the first of the known emoji forms whose base codepoint is ucs, or
+// nullptr if there are none.  If count is not nullptr, it receives the number
+// of consecutive forms for ucs.
+const emoji_form_sequence* get_emoji_form_sequence(char32_t ucs, uint32* count=nullptr);
+
+// Returns all of the known emoji forms, sorted by base codepoint.
+const emoji_form_sequence* get_emoji_form_sequences(uint32& count);
+
+// Returns the known emoji form that exactly matches the UTF-8 sequence s, or
+// nullptr if there is none.
+const emoji_form_sequence* get_emoji_form_sequence(const char* s, uint32 len);
+
+// Returns the width of the known emoji form in the current wcwidth modes.
+// This can be called from any thread.
+uint32 get_emoji_form_width(const emoji_form_sequence* sequence);
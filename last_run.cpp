@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "last_run.h"
+#include "calibration.h"
+
+//------------------------------------------------------------------------------
+last_run::~last_run()
+{
+    cancel_save();
+}
+
+//------------------------------------------------------------------------------
+// Returns false if there are no usable results from the last run.  The key is
+// remembered for begin_save() either way.
+bool last_run::load(const char* key)
+{
+    // 64-bit FNV-1a, so that different keys practically never share a file.
+    uint64 hash = 0xcbf29ce484222325ull;
+    for (const char* s = key; *s; ++s)
+        hash = (hash ^ uint8(*s)) * 0x100000001b3ull;
+
+    char name[64];
+    char path[MAX_PATH];
+    sprintf(name, "wcwv-last-run-%016llx.bin", hash);
+    m_path.clear();
+    if (!get_cache_path(name, path, sizeof(path)))
+        return false;
+    m_path = path;
+
+    m_codepoints.clear();
+    m_sequences.clear();
+    if (!m_reader.open(path))
+        return false;
+
+    const auto& records = m_reader.records();
+    for (uint32 i = 0; i < records.size(); ++i)
+    {
+        if (records[i].seq)
+            m_sequences[records[i].seq] = i;
+        else
+            m_codepoints[records[i].ucs] = i;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+const result_record* last_run::find(char32_t ucs, const char* seq) const
+{
+    if (seq)
+    {
+        const auto it = m_sequences.find(seq);
+        return (it != m_sequences.end()) ? &m_reader.records()[it->second] : nullptr;
+    }
+    else
+    {
+        const auto it = m_codepoints.find(ucs);
+        return (it != m_codepoints.end()) ? &m_reader.records()[it->second] : nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool last_run::begin_save()
+{
+    if (m_path.empty())
+        return false;
+
+    const std::string temp = m_path + ".tmp";
+    return m_writer.open(temp.c_str(), result_format::bin);
+}
+
+//------------------------------------------------------------------------------
+bool last_run::end_save()
+{
+    const std::string temp = m_path + ".tmp";
+    if (!m_writer.close())
+    {
+        remove(temp.c_str());
+        return false;
+    }
+
+    // Replace the saved results in one step, so that they're never lost if
+    // the process is interrupted.
+    return !!MoveFileExA(temp.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING);
+}
+
+//------------------------------------------------------------------------------
+void last_run::cancel_save()
+{
+    if (!m_writer.is_open())
+        return;
+
+    m_writer.close();
+    const std::string temp = m_path + ".tmp";
+    remove(temp.c_str());
+}
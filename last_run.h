@@ -0,0 +1,45 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "result_writer.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//------------------------------------------------------------------------------
+// The predicted width and the result of each codepoint and sequence from the
+// last verification run, so that the next run can measure only what changed.
+//
+// It's kept in the bin results format (see result_writer) in %LOCALAPPDATA%,
+// in a file named after a hash of the key.  The key describes what the
+// results depend on besides the predictions, such as the terminal identity,
+// the --prefix and --suffix codepoints, and which codepoints are skipped (a
+// run only saves what it verified).  The new results are written to a
+// temporary file, which only replaces the saved results if the run finishes;
+// otherwise the temporary file is removed when the last_run is destroyed.
+class last_run
+{
+public:
+                    ~last_run();
+    bool            load(const char* key);
+    uint32          count() const { return uint32(m_reader.records().size()); }
+
+    // Returns the record for a codepoint (seq is nullptr) or a sequence, or
+    // nullptr if it wasn't verified in the last run.
+    const result_record* find(char32_t ucs, const char* seq) const;
+
+    bool            begin_save();
+    void            save(const result_record& record) { m_writer.write(record); }
+    bool            end_save();
+    void            cancel_save();
+
+private:
+    std::string     m_path;
+    result_reader   m_reader;
+    std::unordered_map<char32_t, uint32> m_codepoints;
+    std::unordered_map<std::string_view, uint32> m_sequences;
+    result_writer   m_writer;
+};
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "latency_histogram.h"
+
+//------------------------------------------------------------------------------
+static uint32 highest_bit(uint64 value)
+{
+    uint32 bit = 0;
+    while (value >>= 1)
+        ++bit;
+    return bit;
+}
+
+//------------------------------------------------------------------------------
+// A value at or above c_sub_buckets is shifted right until it's in the range
+// [c_sub_buckets, 2 * c_sub_buckets); the shift picks the group of buckets
+// and the shifted value picks the bucket within the group.
+uint32 latency_histogram::bucket_index(uint64 value)
+{
+    if (value < c_sub_buckets)
+        return uint32(value);
+
+    const uint32 shift = highest_bit(value) - c_sub_bits;
+    return (shift + 1) * c_sub_buckets + uint32(value >> shift) - c_sub_buckets;
+}
+
+//------------------------------------------------------------------------------
+uint64 latency_histogram::bucket_upper(uint32 index)
+{
+    if (index < c_sub_buckets)
+        return index;
+
+    const uint32 shift = index / c_sub_buckets - 1;
+    const uint64 base = uint64(c_sub_buckets + index % c_sub_buckets) << shift;
+    return base + ((uint64(1) << shift) - 1);
+}
+
+//------------------------------------------------------------------------------
+void latency_histogram::record(uint64 value)
+{
+    ++m_counts[bucket_index(value)];
+    ++m_count;
+    m_total += value;
+    m_min = min(m_min, value);
+    m_max = max(m_max, value);
+}
+
+//------------------------------------------------------------------------------
+void latency_histogram::merge(const latency_histogram& other)
+{
+    for (uint32 i = 0; i < c_buckets; ++i)
+        m_counts[i] += other.m_counts[i];
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_min = min(m_min, other.m_min);
+    m_max = max(m_max, other.m_max);
+}
+
+//------------------------------------------------------------------------------
+uint64 latency_histogram::percentile(double p) const
+{
+    if (!m_count)
+        return 0;
+
+    uint64 target = uint64(double(m_count) * p / 100 + 0.5);
+    target = max<uint64>(min<uint64>(target, m_count), 1);
+
+    uint64 seen = 0;
+    for (uint32 i = 0; i < c_buckets; ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= target)
+            return min(max(bucket_upper(i), min_value()), m_max);
+    }
+    return m_max;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// A fixed size histogram of latencies, in the style of HdrHistogram:  values
+// below 16 have their own buckets, and each power of two above that is split
+// into 16 buckets.  So any value from 0 to 2^64-1 can be recorded in constant
+// time, and percentiles are accurate to within 1/16 (about 6%) of the value.
+class latency_histogram
+{
+public:
+    enum : uint32
+    {
+        c_sub_bits      = 4,
+        c_sub_buckets   = 1 << c_sub_bits,
+        c_buckets       = (64 - c_sub_bits + 1) * c_sub_buckets,
+    };
+
+    void            record(uint64 value);
+    void            merge(const latency_histogram& other);
+    uint64          count() const { return m_count; }
+    uint64          total() const { return m_total; }
+    uint64          min_value() const { return m_count ? m_min : 0; }
+    uint64          max_value() const { return m_max; }
+    double          mean() const { return m_count ? double(m_total) / double(m_count) : 0; }
+
+    // Returns the smallest value (to within the bucket precision) that is
+    // greater than or equal to p percent of the recorded values.
+    uint64          percentile(double p) const;
+
+    // For exporting the buckets.  bucket_upper() is the largest value that
+    // goes in the bucket.
+    uint32          bucket_count(uint32 index) const { return m_counts[index]; }
+    static uint64   bucket_upper(uint32 index);
+
+private:
+    static uint32   bucket_index(uint64 value);
+
+    uint32          m_counts[c_buckets] = {};
+    uint64          m_count = 0;
+    uint64          m_total = 0;
+    uint64          m_min = ~uint64(0);
+    uint64          m_max = 0;
+};
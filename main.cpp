@@ -1,7 +1,27 @@
 #include "main.h"
 #include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "emoji_forms.h"
+#include "result_writer.h"
+#include "width_diff.h"
+#include "bench.h"
+#include "terminal_model.h"
+#include "dsr_pipeline.h"
+#include "verify_timing.h"
+#include "context_matrix.h"
+#include "codepoint_names.h"
+#include "prediction_snapshot.h"
+#include "calibration.h"
+#include "spsc_queue.h"
+#include "last_run.h"
+#include "column_format.h"
 
 #include <locale.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
 
 static HANDLE s_hout = GetStdHandle(STD_OUTPUT_HANDLE);
 static char32_t s_prefix = '\0';
@@ -11,58 +31,33 @@ static bool s_group_headers = true;
 static bool s_show_width = false;
 static bool s_decimal = false;
 static wcwidth_modes s_init_modes;
-
-struct emoji_form_sequence {
-  char32_t ucs;
-  const char* seq;
-  const char* desc;
-};
+static const char* s_emoji_version = nullptr;
+static const char* s_format = nullptr;
+static const char* s_output = nullptr;
+static const char* s_profile = nullptr;
+static const char* s_save_profile = nullptr;
+static bool s_diff = false;
+static bool s_predict_all = false;
+static const char* s_bench = nullptr;
+static const char* s_headless = nullptr;
+static terminal_model* s_terminal = nullptr;
+static bool s_dsr = false;
+static bool s_calibrate = false;
+static bool s_recalibrate = false;
+static dsr_pipeline* s_dsr_pipeline = nullptr;
+static std::vector<COORD> s_dsr_positions;
+static uint32 s_dsr_next = 0;
+static bool s_timing = false;
+static const char* s_timing_output = nullptr;
+static verify_timing* s_verify_timing = nullptr;
+static const char* s_bases = nullptr;
+static const char* s_marks = nullptr;
+static result_writer s_results;
+static bool s_full = false;
+static last_run* s_last_run = nullptr;
+static bool s_incremental = false;
 
 #include "unicode-blocks.i"
-#include "assigned-codepoints.i"
-#include "emoji-forms.i"
-
-static const char* is_assigned(char32_t ucs)
-{
-    const struct codepoint* table = c_assigned;
-    int32 min = 0;
-    int32 max = _countof(c_assigned) - 1;
-    int32 mid;
-
-    while (max >= min)
-    {
-        mid = (min + max) / 2;
-        if (ucs > table[mid].ucs)
-            min = mid + 1;
-        else if (ucs < table[mid].ucs)
-            max = mid - 1;
-        else
-            return table[mid].desc;
-    }
-
-    const struct codepoint_range* atable = c_assigned_areas;
-    min = 0;
-    max = _countof(c_assigned_areas) - 1;
-
-    while (max >= min)
-    {
-        mid = (min + max) / 2;
-        if (ucs > atable[mid].last)
-            min = mid + 1;
-        else if (ucs < atable[mid].first)
-            max = mid - 1;
-        else
-            return atable[mid].desc;
-    }
-
-    return 0;
-}
-
-static bool is_ideograph(char32_t ucs)
-{
-    const char* name = is_assigned(ucs);
-    return name && strstr(name, "IDEOGRAPH");
-}
 
 struct interval
 {
@@ -113,32 +108,6 @@ static bool is_kana(char32_t ucs)
     return !!bisearch(ucs, kana, _countof(kana) - 1);
 }
 
-static const emoji_form_sequence* get_emoji_form_sequence(char32_t ucs)
-{
-    int32 min = 0;
-    int32 max = _countof(emoji_forms);
-    int32 mid;
-
-    while (max > min)
-    {
-        mid = (min + max) / 2;
-        if (ucs > emoji_forms[mid].ucs)
-            min = mid + 1;
-        else
-            max = mid;
-    }
-
-    if (max == min && min < _countof(emoji_forms))
-    {
-        assert(min < 1 || emoji_forms[min - 1].ucs < ucs);
-        const emoji_form_sequence* x = emoji_forms + min;
-        if (x->ucs == ucs)
-            return x;
-    }
-
-    return nullptr;
-}
-
 class utf16fromutf32
 {
 public:
@@ -171,165 +140,282 @@ private:
     WORD m_length;
 };
 
-static int32 VerifyWidth(char32_t ucs)
+static LARGE_INTEGER s_qpc_freq = {};
+
+static LONGLONG GetTimestamp()
 {
-    utf16fromutf32 s(ucs);
-    char utf8[64];
-    WideCharToMultiByte(CP_UTF8, 0, s.c_str(), -1, utf8, _countof(utf8), nullptr, nullptr);
-    const uint32 expected_width = wcswidth(utf8, uint32(strlen(utf8)));
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
 
-    DWORD written = 0;
-    CONSOLE_SCREEN_BUFFER_INFO csbiBefore;
-    if (!GetConsoleScreenBufferInfo(s_hout, &csbiBefore))
-        return -1;
-    if (csbiBefore.dwCursorPosition.X != 0)
-        return -1;
+static uint32 ElapsedNanoseconds(LONGLONG began)
+{
+    if (!s_qpc_freq.QuadPart)
+        QueryPerformanceFrequency(&s_qpc_freq);
+    const LONGLONG ticks = GetTimestamp() - began;
+    return uint32(min<LONGLONG>(ticks * 1000000000 / s_qpc_freq.QuadPart, 0xffffffff));
+}
 
-    if (s_prefix)
+// One codepoint or sequence to verify, or a marker that tells the report stage
+// where a range or codepoint begins or ends.  The generate stage fills in the
+// expected width, and the measure stage fills in the rest.  Items are copied
+// through two queues, so they only refer to the text.
+struct verify_item
+{
+    enum kind : uint8
     {
-        utf16fromutf32 pre(s_prefix);
-        if (!WriteConsoleW(s_hout, pre.c_str(), pre.length(), &written, nullptr))
-            return -1;
-        if (written != pre.length())
-            return -1;
-        if (!GetConsoleScreenBufferInfo(s_hout, &csbiBefore))
-            return -1;
-    }
+        begin_range,
+        skip,                               // Skipped one or more codepoints.
+        unassigned,                         // The codepoint isn't assigned.
+        measure,
+        unchanged,                          // Passed in the last run, with the same prediction.
+        end_codepoint,
+        end_range,
+        range_failed,                       // Unable to measure the range.
+        measure_failed,                     // Unable to measure the item.
+        done,
+    };
 
-    if (!WriteConsoleW(s_hout, s.c_str(), s.length(), &written, nullptr))
-        return -1;
-    if (written != s.length())
-        return -1;
+    kind            type = done;
+    char32_t        ucs = 0;
+    uint32          index = 0;              // Index of the sequence for ucs.
+    const emoji_form_sequence* sequence = nullptr;
+    const block_range* range = nullptr;
+    int32           expected = 0;
+    int32           width = 0;
+    bool            suffix_effect = false;
+    bool            ok = false;
+    bool            erased = false;
+    uint32          elapsed_ns = 0;
+};
 
-    CONSOLE_SCREEN_BUFFER_INFO csbiAfter1;
-    if (!GetConsoleScreenBufferInfo(s_hout, &csbiAfter1))
-        return -1;
-    if (csbiAfter1.dwCursorPosition.Y != csbiBefore.dwCursorPosition.Y)
-        return -1;
+static void GetResultRecord(const verify_item& item, result_record& record)
+{
+    record.ucs = item.sequence ? item.sequence->ucs : item.ucs;
+    record.seq = item.sequence ? item.sequence->seq : nullptr;
+    record.block = item.range->desc;
+    record.block_first = item.range->first;
+    record.expected = item.expected;
+    record.actual = item.width;
+    record.suffix_effect = item.suffix_effect;
+    record.elapsed_ns = item.elapsed_ns;
+}
 
-    const SHORT width = csbiAfter1.dwCursorPosition.X - csbiBefore.dwCursorPosition.X;
-    if (width < 0 || width > 2)
-        return -1;
+// These go to the console, or to the terminal model when --headless is used.
+// When --dsr is used, the writes and cursor queries were already sent by
+// MeasureRange(), and these replay the replies.
+static bool GetCursorPosition(COORD& pos)
+{
+    if (s_dsr_pipeline)
+    {
+        if (s_dsr_next >= s_dsr_positions.size())
+            return false;
+        pos = s_dsr_positions[s_dsr_next++];
+        return true;
+    }
 
-    bool suffix_effect = false;
-    if (s_suffix)
+    if (s_terminal)
     {
-        utf16fromutf32 suf(s_suffix);
-        if (!WriteConsoleW(s_hout, suf.c_str(), suf.length(), &written, nullptr))
-            return -1;
-        if (written != suf.length())
-            return -1;
+        pos.X = SHORT(s_terminal->cursor_x());
+        pos.Y = 0;
+        return true;
+    }
 
-        CONSOLE_SCREEN_BUFFER_INFO csbiAfter2;
-        if (!GetConsoleScreenBufferInfo(s_hout, &csbiAfter2))
-            return -1;
-        suffix_effect = (csbiAfter2.dwCursorPosition.X != csbiBefore.dwCursorPosition.X + width + 1);
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (!GetConsoleScreenBufferInfo(s_hout, &csbi))
+        return false;
+    pos = csbi.dwCursorPosition;
+    return true;
+}
+
+static bool WriteText(const WCHAR* s, uint32 len)
+{
+    if (s_dsr_pipeline)
+        return true;
+
+    if (s_terminal)
+    {
+        char utf8[256];
+        const int32 utf8_len = WideCharToMultiByte(CP_UTF8, 0, s, len, utf8, _countof(utf8), nullptr, nullptr);
+        if (utf8_len <= 0)
+            return false;
+        s_terminal->write(utf8, utf8_len);
+        return true;
     }
 
-    const int32 ok = (width == expected_width) && !suffix_effect;
+    DWORD written = 0;
+    if (!WriteConsoleW(s_hout, s, len, &written, nullptr))
+        return false;
+    return (written == len);
+}
+
+static void EraseMeasurement(const COORD& pos, uint32 columns=8)
+{
+    if (s_dsr_pipeline)
+        return;
 
-    if (!s_show_width && (ok || !s_verbose))
+    if (s_terminal)
     {
-        SetConsoleCursorPosition(s_hout, csbiBefore.dwCursorPosition);
-        WriteConsoleW(s_hout, L"        ", 8, &written, nullptr);
-        SetConsoleCursorPosition(s_hout, csbiBefore.dwCursorPosition);
+        s_terminal->set_cursor_x(pos.X);
+        return;
     }
-    else
+
+    static const WCHAR c_spaces[] = L"                                ";
+    DWORD written = 0;
+    SetConsoleCursorPosition(s_hout, pos);
+    while (columns)
     {
-        printf("%s   %04X, width %u, expected %u", (s_suffix == ' ') ? "" : " ", (uint32)ucs, width, expected_width);
-        const char* desc = is_assigned(ucs);
-        if (desc && *desc)
-            printf("    %s", desc);
-        puts("");
-        if (suffix_effect)
-            printf("        WARNING:  Suffix codepoint affected the width after measurement!\n");
+        const uint32 n = min<uint32>(columns, _countof(c_spaces) - 1);
+        WriteConsoleW(s_hout, c_spaces, n, &written, nullptr);
+        columns -= n;
     }
+    SetConsoleCursorPosition(s_hout, pos);
+}
 
-    return ok;
+// Records the time since t for the step, and restarts t.
+static void EndStep(verify_step step, LONGLONG& t)
+{
+    if (s_verify_timing)
+    {
+        s_verify_timing->record_step(step, ElapsedNanoseconds(t));
+        t = GetTimestamp();
+    }
 }
 
-static int32 VerifyWidth(const emoji_form_sequence* sequence)
+// The report stage prints a report line after the measured text, which leaves
+// the console cursor at the beginning of the next line.
+static void EndReportLine()
 {
-    wchar_t s[64];
-    MultiByteToWideChar(CP_UTF8, 0, sequence->seq, -1, s, _countof(s));
+    if (s_terminal)
+        s_terminal->set_cursor_x(0);
+}
 
-    DWORD written = 0;
-    CONSOLE_SCREEN_BUFFER_INFO csbiBefore;
-    if (!GetConsoleScreenBufferInfo(s_hout, &csbiBefore))
-        return -1;
-    if (csbiBefore.dwCursorPosition.X != 0)
-        return -1;
+// Measures the width of the item's text, and whether it matches the expected
+// width.  Returns false if unable to measure.
+static bool MeasureItem(verify_item& item)
+{
+    WCHAR text[64];
+    uint32 text_len;
+    if (item.sequence)
+    {
+        MultiByteToWideChar(CP_UTF8, 0, item.sequence->seq, -1, text, _countof(text));
+        text_len = uint32(wcslen(text));
+    }
+    else
+    {
+        utf16fromutf32 s(item.ucs);
+        memcpy(text, s.c_str(), (s.length() + 1) * sizeof(WCHAR));
+        text_len = s.length();
+    }
+
+    const LONGLONG began = GetTimestamp();
+    LONGLONG step = began;
+
+    COORD before;
+    if (!GetCursorPosition(before))
+        return false;
+    EndStep(verify_step::query, step);
+    if (before.X != 0)
+        return false;
 
     if (s_prefix)
     {
         utf16fromutf32 pre(s_prefix);
-        if (!WriteConsoleW(s_hout, pre.c_str(), pre.length(), &written, nullptr))
-            return -1;
-        if (written != pre.length())
-            return -1;
-        if (!GetConsoleScreenBufferInfo(s_hout, &csbiBefore))
-            return -1;
+        if (!WriteText(pre.c_str(), pre.length()))
+            return false;
+        EndStep(verify_step::prefix, step);
+        if (!GetCursorPosition(before))
+            return false;
+        EndStep(verify_step::query, step);
     }
 
-    const uint32 s_len = uint32(wcslen(s));
-    if (!WriteConsoleW(s_hout, s, s_len, &written, nullptr))
-        return -1;
-    if (written != s_len)
-        return -1;
+    if (!WriteText(text, text_len))
+        return false;
+    EndStep(verify_step::glyph, step);
 
-    CONSOLE_SCREEN_BUFFER_INFO csbiAfter1;
-    if (!GetConsoleScreenBufferInfo(s_hout, &csbiAfter1))
-        return -1;
-    if (csbiAfter1.dwCursorPosition.Y != csbiBefore.dwCursorPosition.Y)
-        return -1;
+    COORD after1;
+    if (!GetCursorPosition(after1))
+        return false;
+    EndStep(verify_step::query, step);
+    if (after1.Y != before.Y)
+        return false;
 
-    const SHORT width = csbiAfter1.dwCursorPosition.X - csbiBefore.dwCursorPosition.X;
+    const SHORT width = after1.X - before.X;
+    if (!item.sequence && (width < 0 || width > 2))
+        return false;
 
     bool suffix_effect = false;
     if (s_suffix)
     {
         utf16fromutf32 suf(s_suffix);
-        if (!WriteConsoleW(s_hout, suf.c_str(), suf.length(), &written, nullptr))
-            return -1;
-        if (written != suf.length())
-            return -1;
+        if (!WriteText(suf.c_str(), suf.length()))
+            return false;
+        EndStep(verify_step::suffix, step);
 
-        CONSOLE_SCREEN_BUFFER_INFO csbiAfter2;
-        if (!GetConsoleScreenBufferInfo(s_hout, &csbiAfter2))
-            return -1;
-        suffix_effect = (csbiAfter2.dwCursorPosition.X != csbiBefore.dwCursorPosition.X + width + 1);
+        COORD after2;
+        if (!GetCursorPosition(after2))
+            return false;
+        EndStep(verify_step::query, step);
+        suffix_effect = (after2.X != before.X + width + 1);
     }
 
-    const int32 expected_width = wcswidth(sequence->seq, uint32(strlen(sequence->seq)));
-    const int32 ok = (width == expected_width) && !suffix_effect;
+    item.width = width;
+    item.suffix_effect = suffix_effect;
+    item.ok = (width == item.expected) && !suffix_effect;
+    item.elapsed_ns = ElapsedNanoseconds(began);
 
-    if (!s_show_width && (ok || !s_verbose))
+    item.erased = (s_results.is_open() || (!s_show_width && (item.ok || !s_verbose)));
+    if (item.erased)
     {
-        SetConsoleCursorPosition(s_hout, csbiBefore.dwCursorPosition);
-        WriteConsoleW(s_hout, L"        ", 8, &written, nullptr);
-        SetConsoleCursorPosition(s_hout, csbiBefore.dwCursorPosition);
+        EraseMeasurement(before);
+        EndStep(verify_step::erase, step);
     }
     else
     {
-        printf("%s   ", (s_suffix == ' ') ? "" : " ");
-        str_iter iter(sequence->seq);
-        while (iter.more())
+        EndReportLine();
+    }
+
+    if (s_verify_timing)
+    {
+        if (item.sequence)
+            s_verify_timing->record_measurement(item.sequence->ucs, item.sequence->seq, ElapsedNanoseconds(began));
+        else
+            s_verify_timing->record_measurement(item.ucs, nullptr, ElapsedNanoseconds(began));
+    }
+
+    return true;
+}
+
+// Prints the measurement after the measured text.
+static void PrintReportLine(const verify_item& item)
+{
+    const char* const indent = (s_suffix == ' ') ? "" : " ";
+    const char* desc;
+    if (item.sequence)
+    {
+        char codepoints[128] = "";
+        uint32 len = 0;
+        str_iter iter(item.sequence->seq);
+        while (iter.more() && len < sizeof(codepoints))
         {
-            if (iter.get_pointer() > sequence->seq)
-                printf(" ");
-            const int32 c = iter.next();
-            printf("%04X", c);
+            const char* const sep = (iter.get_pointer() > item.sequence->seq) ? " " : "";
+            len += column_snprintf(codepoints + len, sizeof(codepoints) - len, "%s%04X", sep, iter.next());
         }
-        printf(", width %u, expected %u", width, expected_width);
-        const char* desc = sequence->desc;
-        if (desc && *desc)
-            printf("    %s", desc);
-        puts("");
-        if (suffix_effect)
-            printf("        WARNING:  Suffix codepoint affected the width after measurement!\n");
+        column_fprintf(stdout, "%s   %s, width %u, expected %u", indent, codepoints, item.width, item.expected);
+        desc = item.sequence->desc;
+    }
+    else
+    {
+        column_fprintf(stdout, "%s   %04X, width %u, expected %u", indent, uint32(item.ucs), item.width, item.expected);
+        desc = get_codepoint_name(item.ucs);
     }
 
-    return ok;
+    if (desc && *desc)
+        column_fprintf(stdout, "    %s", desc);
+    column_fprintf(stdout, "\n");
+    if (item.suffix_effect)
+        column_fprintf(stdout, "        WARNING:  Suffix codepoint affected the width after measurement!\n");
 }
 
 static bool s_skip_all = false;
@@ -393,47 +479,874 @@ static bool IsSequenceSupported(const char* seq)
     return true;
 }
 
-static bool ParseCodepoint(const char* arg, interval& range, bool end_range=false)
-{
-    char* end;
-    int32 radix = s_decimal ? 10 : 16;
+// Queues the same writes and cursor queries that MeasureItem() makes for the
+// text, followed by erasing the line.
+static void QueueProbe(dsr_pipeline& pipeline, const char* text)
+{
+    char tmp[8];
+
+    pipeline.add_text("\r", 1);
+    pipeline.add_query();
+    if (s_prefix)
+    {
+        pipeline.add_text(tmp, to_utf8(s_prefix, tmp));
+        pipeline.add_query();
+    }
+    pipeline.add_text(text, uint32(strlen(text)));
+    pipeline.add_query();
+    if (s_suffix)
+    {
+        pipeline.add_text(tmp, to_utf8(s_suffix, tmp));
+        pipeline.add_query();
+    }
+    pipeline.add_text("\r\x1b[K", 4);
+}
+
+// What a verification run measures.  GenerateItems() and CountMeasureItems()
+// both use these, so that the count for --timing matches the items.
+
+// Returns true if verification stops before range.
+static bool IsPastLastRange(const block_range* range, bool all_blocks)
+{
+    return !range->first || (all_blocks && range->first >= 0x10000 && !s_terminal);
+}
+
+static bool IsRangeSkipped(const block_range* range)
+{
+    return s_skip_ideographs && range->desc && strstr(range->desc, "Ideograph");
+}
+
+// A range of one codepoint is verified even if it's skipped or unassigned.
+static bool IsCodepointSkipped(const block_range* range, char32_t c, bool assigned)
+{
+    return range->first != range->last && (IsSkip(c) || !assigned);
+}
+
+static bool IsSequenceSkipped(const emoji_form_sequence* sequence, bool only_ucs2)
+{
+    return only_ucs2 && !IsSequenceSupported(sequence->seq);
+}
+
+// Returns how many measure items GenerateItems() will produce for the ranges.
+static uint32 CountMeasureItems(const block_range* ranges, bool all_blocks, bool only_ucs2)
+{
+    uint32 total = 0;
+    for (const block_range* range = ranges; !IsPastLastRange(range, all_blocks); ++range)
+    {
+        if (IsRangeSkipped(range))
+            continue;
+
+        for (char32_t c = range->first; c <= range->last; ++c)
+        {
+            if (IsCodepointSkipped(range, c, is_assigned(c)))
+                continue;
+
+            uint32 count;
+            const emoji_form_sequence* sequence = get_emoji_form_sequence(c, &count);
+            if (!sequence)
+            {
+                ++total;
+                continue;
+            }
+            for (uint32 n = 0; n < count; ++n, ++sequence)
+                total += !IsSequenceSkipped(sequence, only_ucs2);
+        }
+    }
+    return total;
+}
+
+// Measures the items of a range in one batch, so that MeasureItem() can replay
+// the results.
+static bool MeasureRange(dsr_pipeline& pipeline, const std::vector<verify_item>& items)
+{
+    fflush(stdout);
+
+    for (const verify_item& item : items)
+    {
+        if (item.type != verify_item::measure)
+            continue;
+
+        if (item.sequence)
+        {
+            QueueProbe(pipeline, item.sequence->seq);
+        }
+        else
+        {
+            char utf8[8];
+            to_utf8(item.ucs, utf8);
+            QueueProbe(pipeline, utf8);
+        }
+    }
+
+    LONGLONG step = GetTimestamp();
+    s_dsr_next = 0;
+    const bool ok = pipeline.run(s_dsr_positions);
+    EndStep(verify_step::batch, step);
+    return ok;
+}
+
+// Verification runs in three stages, so that the console doesn't wait while
+// candidates are filtered, widths are predicted, or results are formatted:
+//
+//  - The generate stage (a worker thread) enumerates the codepoints and
+//    sequences to verify, and predicts their widths.
+//  - The measure stage (the main thread) owns the console, terminal model, or
+//    DSR pipeline, and measures each item.
+//  - The report stage prints and records the results, and coalesces failures
+//    into ranges.  It runs on a worker thread when its output can't land in
+//    the console being measured (--headless or --output).  Otherwise report
+//    lines belong right after the measured text, so it runs in the measure
+//    stage.
+//
+// The stages are connected by bounded lock-free queues, and items stay in
+// order, so the output is the same as verifying one item at a time.
+
+static const uint32 c_generate_queue_size = 1024;
+static const uint32 c_report_queue_size = 4096;
+
+// With --full or without results from the last run, everything is measured.
+// Otherwise about this many of the items that passed in the last run with the
+// same predicted width are measured anyway, picked at random, in case the
+// terminal changed.
+static const uint32 c_control_samples = 256;
+
+// Generate stage:  produces the items for each range, followed by a done item.
+// Stops early if cancel is set.
+static void GenerateItems(const block_range* ranges, bool all_blocks, bool only_ucs2, spsc_queue<verify_item>& out, const std::atomic<bool>& cancel)
+{
+    verify_item item;
+    auto emit = [&](verify_item::kind type){
+        item.type = type;
+        out.push(item);
+    };
+
+    std::minstd_rand random(GetTickCount());
+    auto emit_measure = [&](){
+        if (s_incremental)
+        {
+            const result_record* last = s_last_run->find(item.ucs, item.sequence ? item.sequence->seq : nullptr);
+            if (last && last->expected == item.expected && last->actual == last->expected && !last->suffix_effect &&
+                random() % s_last_run->count() >= c_control_samples)
+            {
+                item.width = last->actual;
+                item.suffix_effect = false;
+                item.ok = true;
+                item.elapsed_ns = last->elapsed_ns;
+                emit(verify_item::unchanged);
+                return;
+            }
+        }
+        emit(verify_item::measure);
+    };
+
+    for (const block_range* range = ranges; !IsPastLastRange(range, all_blocks) && !cancel; ++range)
+    {
+        if (IsRangeSkipped(range))
+            continue;
+
+        item.range = range;
+        item.ucs = 0;
+        item.sequence = nullptr;
+        emit(verify_item::begin_range);
+
+        // Consecutive skipped codepoints only need one skip item.
+        bool skipping = false;
+        for (char32_t c = range->first; c <= range->last && !cancel; ++c)
+        {
+            item.ucs = c;
+            item.sequence = nullptr;
+
+            const bool assigned = is_assigned(c);
+            if (IsCodepointSkipped(range, c, assigned))
+            {
+                if (!skipping)
+                    emit(verify_item::skip);
+                skipping = true;
+                continue;
+            }
+            skipping = false;
+
+            if (!assigned)
+                emit(verify_item::unassigned);
+
+            uint32 count;
+            const emoji_form_sequence* sequence = get_emoji_form_sequence(c, &count);
+            if (sequence)
+            {
+                for (uint32 n = 0; n < count; ++n, ++sequence)
+                {
+                    if (!IsSequenceSkipped(sequence, only_ucs2))
+                    {
+                        item.index = n;
+                        item.sequence = sequence;
+                        item.expected = get_emoji_form_width(sequence);
+                        emit_measure();
+                    }
+                }
+                item.sequence = nullptr;
+            }
+            else
+            {
+                utf16fromutf32 s(c);
+                char utf8[64];
+                WideCharToMultiByte(CP_UTF8, 0, s.c_str(), -1, utf8, _countof(utf8), nullptr, nullptr);
+                item.expected = wcswidth(utf8, uint32(strlen(utf8)));
+                emit_measure();
+            }
+
+            emit(verify_item::end_codepoint);
+        }
+
+        emit(verify_item::end_range);
+    }
+
+    emit(verify_item::done);
+}
+
+// Measure stage:  measures the items in order, and passes each item to report,
+// ending with the done item or a failed item.  Returns false if unable to
+// measure something.
+template<class F>
+static bool MeasureItems(spsc_queue<verify_item>& in, F&& report)
+{
+    auto measure = [&](verify_item& item){
+        if (item.type == verify_item::measure && !MeasureItem(item))
+        {
+            item.type = verify_item::measure_failed;
+            report(item);
+            return false;
+        }
+        report(item);
+        return true;
+    };
+
+    std::vector<verify_item> batch;
+    verify_item item;
+    while (true)
+    {
+        in.pop(item);
+        if (item.type == verify_item::done)
+        {
+            report(item);
+            return true;
+        }
+
+        if (item.type != verify_item::begin_range)
+        {
+            if (!measure(item))
+                return false;
+            continue;
+        }
+
+        if (s_verify_timing)
+            s_verify_timing->begin_block(item.range->first, item.range->last, item.range->desc);
+        report(item);
+
+        if (s_dsr_pipeline)
+        {
+            // The whole range is measured in one batch, and then replayed.
+            batch.clear();
+            do
+            {
+                in.pop(item);
+                batch.push_back(item);
+            }
+            while (item.type != verify_item::end_range);
+
+            if (!MeasureRange(*s_dsr_pipeline, batch))
+            {
+                item.type = verify_item::range_failed;
+                report(item);
+                return false;
+            }
+
+            for (verify_item& b : batch)
+            {
+                if (!measure(b))
+                    return false;
+            }
+        }
+    }
+}
+
+// Report stage:  prints and records the results, and counts them.
+struct verify_report
+{
+    bool            add(const verify_item& item);
+    void            end_failure_range();
+
+    uint32          tested = 0;
+    uint32          failed = 0;
+    uint32          unchanged = 0;
+    char32_t        first_failure = 0;
+    char32_t        last_failure = 0;
+    bool            codepoint_ok = true;
+};
+
+// Returns false after the done item or a failed item.
+bool verify_report::add(const verify_item& item)
+{
+    const block_range* const range = item.range;
+    switch (item.type)
+    {
+    case verify_item::begin_range:
+        if (s_group_headers && !s_results.is_open())
+        {
+            // CONSOLE_SCREEN_BUFFER_INFO csbi;
+            // GetConsoleScreenBufferInfo(s_hout, &csbi);
+            // SetConsoleTextAttribute(s_hout, csbi.wAttributes | 0xF);
+
+            if (range->first == range->last)
+                printf("CODEPOINT %04X", uint32(range->first));
+            else if (range->desc)
+                printf("%04X .. %04X -- %s", uint32(range->first), uint32(range->last), range->desc);
+            else
+                printf("%04X .. %04X", uint32(range->first), uint32(range->last));
+
+            // SetConsoleTextAttribute(s_hout, csbi.wAttributes);
+            puts("");
+        }
+        break;
+
+    case verify_item::skip:
+    case verify_item::end_range:
+        end_failure_range();
+        break;
+
+    case verify_item::unassigned:
+        if (!s_results.is_open())
+            printf("NOTE:  %04X is not an assigned codepoint.\n", uint32(item.ucs));
+        break;
+
+    case verify_item::measure:
+        if (s_results.is_open() || s_last_run)
+        {
+            result_record record;
+            GetResultRecord(item, record);
+            if (s_results.is_open())
+                s_results.write(record);
+            if (s_last_run)
+                s_last_run->save(record);
+        }
+        if (!item.erased)
+            PrintReportLine(item);
+
+        if (!item.ok)
+        {
+            ++failed;
+            if (!first_failure)
+                first_failure = item.ucs;
+            last_failure = item.ucs;
+            codepoint_ok = false;
+        }
+
+        ++tested;
+        break;
+
+    case verify_item::unchanged:
+        {
+            result_record record;
+            GetResultRecord(item, record);
+            s_last_run->save(record);
+            ++unchanged;
+        }
+        break;
+
+    case verify_item::end_codepoint:
+        if (codepoint_ok)
+            end_failure_range();
+        codepoint_ok = true;
+        break;
+
+    case verify_item::range_failed:
+        fprintf(stderr, "INTERNAL FAILURE:  unable to measure %04X..%04X.\n", uint32(range->first), uint32(range->last));
+        return false;
+
+    case verify_item::measure_failed:
+        if (item.sequence)
+            fprintf(stderr, "INTERNAL FAILURE:  unable to verify sequence #%u for %04X.\n", item.index, uint32(item.ucs));
+        else
+            fprintf(stderr, "INTERNAL FAILURE:  unable to verify %04X.\n", uint32(item.ucs));
+        return false;
+
+    case verify_item::done:
+        return false;
+    }
+
+    return true;
+}
+
+void verify_report::end_failure_range()
+{
+    if (first_failure && !s_results.is_open())
+    {
+        CONSOLE_SCREEN_BUFFER_INFO csbi;
+        HANDLE herr = GetStdHandle(STD_ERROR_HANDLE);
+        GetConsoleScreenBufferInfo(herr, &csbi);
+        SetConsoleTextAttribute(herr, (csbi.wAttributes & 0xF0) | 0x0C);
+
+        fprintf(stderr, "FAILED:  %04X..%04X do not match the expected width (%u codepoints).", uint32(first_failure), uint32(last_failure), uint32(last_failure + 1 - first_failure));
+
+        SetConsoleTextAttribute(herr, csbi.wAttributes);
+        fputs("\n", stderr);
+    }
+
+    first_failure = 0;
+    last_failure = 0;
+}
+
+// Verifies the ranges (up to the terminating range with first == 0), using the
+// three stages.  Returns false if unable to measure something.
+static bool VerifyRanges(const block_range* ranges, bool all_blocks, bool only_ucs2, verify_report& report)
+{
+    std::atomic<bool> cancel = false;
+    spsc_queue<verify_item> generated(c_generate_queue_size);
+    std::thread generator([&](){
+        GenerateItems(ranges, all_blocks, only_ucs2, generated, cancel);
+    });
+
+    bool ok;
+    if (s_terminal || s_results.is_open())
+    {
+        spsc_queue<verify_item> measured(c_report_queue_size);
+        std::thread reporter([&](){
+            verify_item item;
+            do
+                measured.pop(item);
+            while (report.add(item));
+        });
+        ok = MeasureItems(generated, [&](const verify_item& item){ measured.push(item); });
+        reporter.join();
+    }
+    else
+    {
+        ok = MeasureItems(generated, [&](const verify_item& item){ report.add(item); });
+    }
+
+    // If measuring stopped early, let the generate stage finish.
+    if (!ok)
+    {
+        cancel = true;
+        verify_item item;
+        do
+            generated.pop(item);
+        while (item.type != verify_item::done);
+    }
+
+    generator.join();
+    return ok;
+}
+
+// Compares the rate of cursor queries when waiting for each reply versus when
+// pipelining them.
+static bool CompareDsrRates(dsr_pipeline& pipeline)
+{
+    static const uint32 c_probes = 64;
+
+    if (!s_qpc_freq.QuadPart)
+        QueryPerformanceFrequency(&s_qpc_freq);
+
+    const uint32 window = pipeline.window();
+    double rates[2];
+    for (uint32 pass = 0; pass < 2; ++pass)
+    {
+        pipeline.set_window(pass ? window : 1);
+        for (uint32 i = 0; i < c_probes; ++i)
+        {
+            pipeline.add_text((i & 1) ? "\r\xe4\xb8\x80" : "\rx", (i & 1) ? 4 : 2);
+            pipeline.add_query();
+        }
+        pipeline.add_text("\r\x1b[K", 4);
+
+        const LONGLONG began = GetTimestamp();
+        if (!pipeline.run(s_dsr_positions))
+            return false;
+        const double seconds = double(GetTimestamp() - began) / double(s_qpc_freq.QuadPart);
+        rates[pass] = (seconds > 0) ? c_probes / seconds : 0;
+    }
+
+    printf("Cursor queries:  %.0f per second waiting for each reply, %.0f per second pipelined (window %u).\n",
+           rates[0], rates[1], window);
+    return true;
+}
+
+// Measures each calibration probe from the start of a line, all in one batch.
+static bool MeasureCalibrationProbes(const calibration& cal, std::vector<int32>& widths)
+{
+    widths.clear();
+
+    if (s_terminal)
+    {
+        for (uint32 i = 0; i < cal.probe_count(); ++i)
+        {
+            s_terminal->set_cursor_x(0);
+            s_terminal->write(cal.probe(i).c_str(), uint32(cal.probe(i).length()));
+            widths.push_back(int32(s_terminal->cursor_x()));
+        }
+        s_terminal->set_cursor_x(0);
+        return true;
+    }
+
+    fflush(stdout);
+
+    dsr_pipeline pipeline(s_hout, GetStdHandle(STD_INPUT_HANDLE));
+    if (!pipeline.open())
+        return false;
+    for (uint32 i = 0; i < cal.probe_count(); ++i)
+    {
+        pipeline.add_text("\r", 1);
+        pipeline.add_text(cal.probe(i).c_str(), uint32(cal.probe(i).length()));
+        pipeline.add_query();
+    }
+    pipeline.add_text("\r\x1b[K", 4);
+
+    std::vector<COORD> positions;
+    if (!pipeline.run(positions) || positions.size() != cal.probe_count())
+        return false;
+    for (const COORD& pos : positions)
+        widths.push_back(pos.X);
+    return true;
+}
+
+// Selects and activates the built-in combination of modes that best matches
+// the terminal, using the cached choice for this kind of terminal unless
+// --recalibrate is used.
+static bool Calibrate()
+{
+    static builtin_combination s_calibrated;
+
+    if (!s_qpc_freq.QuadPart)
+        QueryPerformanceFrequency(&s_qpc_freq);
+    const LONGLONG began = GetTimestamp();
+
+    calibration cal;
+    cal.init();
+
+    std::string identity;
+    if (s_headless)
+        identity = std::string("headless=") + s_headless;
+    else
+        get_terminal_identity(identity);
+
+    const builtin_combination* chosen = nullptr;
+    std::string name;
+    if (!s_recalibrate && load_cached_calibration(identity.c_str(), cal.signature(), name))
+        chosen = cal.find(name.c_str());
+
+    const bool cached = !!chosen;
+    uint32 matched = 0;
+    if (!chosen)
+    {
+        std::vector<int32> widths;
+        if (!MeasureCalibrationProbes(cal, widths))
+            return false;
+        chosen = cal.select(widths, get_wcwidth_profile(), matched);
+        save_cached_calibration(identity.c_str(), cal.signature(), chosen->name);
+    }
+
+    s_calibrated = *chosen;
+    activate_wcwidth_profile(&s_calibrated.profile);
+
+    const double ms = double(GetTimestamp() - began) * 1000 / double(s_qpc_freq.QuadPart);
+    if (cached)
+        printf("Calibration:  %s (cached for this terminal), %.1f ms.\n", chosen->name, ms);
+    else
+        printf("Calibration:  %s (%u of %u probes match), %.1f ms.\n", chosen->name, matched, cal.probe_count(), ms);
+    return true;
+}
+
+static bool ParseCodepoint(const char* arg, interval& range, bool end_range=false)
+{
+    char* end;
+    int32 radix = s_decimal ? 10 : 16;
+
+    if (arg[0] == '0' && (arg[1] == 'x' || arg[1] == 'X'))
+    {
+        radix = 16;
+        arg += 2;
+    }
+    else if ((arg[0] == 'U' || arg[0] == 'u') && arg[1] == '+')
+    {
+        radix = 16;
+        arg += 2;
+    }
+
+    const char32_t x = strtoul(arg, &end, radix);
+    if (!x)
+        return false;
+
+    if (end_range)
+    {
+        range.last = x;
+        if (*end && *end != ' ')
+            return false;
+    }
+    else
+    {
+        range.first = range.last = x;
+        if (end[0] == '-')
+            return ParseCodepoint(end + 1, range, true);
+        if (end[0] == '.' && end[1] == '.')
+            return ParseCodepoint(end + 2, range, true);
+        if (*end && *end != ' ')
+            return false;
+    }
+
+    return true;
+}
+
+// Parses a comma separated list of codepoints and ranges of codepoints.
+static bool ParseCodepointList(const char* arg, std::vector<char32_t>& out)
+{
+    while (*arg)
+    {
+        const char* comma = strchr(arg, ',');
+        const size_t len = comma ? size_t(comma - arg) : strlen(arg);
+
+        char item[64];
+        if (!len || len >= sizeof(item))
+            return false;
+        memcpy(item, arg, len);
+        item[len] = '\0';
+
+        interval range;
+        if (!ParseCodepoint(item, range) || range.last < range.first || range.last >= 0x110000)
+            return false;
+        for (char32_t c = range.first; c <= range.last; ++c)
+            out.push_back(c);
+
+        arg += len;
+        if (*arg)
+            ++arg;
+    }
+    return !out.empty();
+}
+
+// How many cursor queries and line readbacks measuring the pairs took.
+struct pair_measurements
+{
+    uint32          queries = 0;
+    uint32          readbacks = 0;
+};
+
+// Reads back the line from start, and fills columns with the column after
+// each separator that isn't part of a wide glyph, relative to start.  Fails
+// unless there's exactly one separator per pair.
+static bool ReadSeparatorColumns(const COORD& start, uint32 width, char separator, uint32 count, std::vector<int32>& columns)
+{
+    std::vector<CHAR_INFO> cells(width);
+    const COORD size = { SHORT(width), 1 };
+    const COORD origin = { 0, 0 };
+    SMALL_RECT rect = { start.X, start.Y, SHORT(start.X + width - 1), start.Y };
+    if (!ReadConsoleOutputW(s_hout, cells.data(), size, origin, &rect))
+        return false;
+
+    columns.clear();
+    for (uint32 x = 0; x < width; ++x)
+    {
+        if (cells[x].Char.UnicodeChar == WCHAR(separator) &&
+            !(cells[x].Attributes & (COMMON_LVB_LEADING_BYTE|COMMON_LVB_TRAILING_BYTE)))
+            columns.push_back(int32(x + 1));
+    }
+    return columns.size() == count;
+}
+
+// Writes the pairs at the beginning of the line, each followed by a separator
+// so that it can't join the next pair, and fills columns with the column
+// after each pair's separator, relative to the start of the line.
+//
+// The console gets the whole group in one write, and the cursor is read once
+// afterwards; then the line is read back to find the separators, so that each
+// pair is checked without a cursor query per pair.  Where the separators
+// can't be found, columns are -1.  The terminal model has no screen to read
+// back, but asking it for the cursor after each pair costs nothing.
+//
+// Fails if the cursor doesn't advance on the same line.
+static bool MeasurePairs(const context_matrix& matrix, const uint32* pairs, uint32 count, char separator,
+                         std::vector<int32>& columns, pair_measurements& stats)
+{
+    COORD start;
+    if (!GetCursorPosition(start) || start.X != 0)
+        return false;
+    ++stats.queries;
+
+    bool ok = true;
+    std::string text;
+    std::vector<WCHAR> wide;
+    COORD end = start;
+    columns.clear();
+    for (uint32 i = 0; ok && i < count; ++i)
+    {
+        matrix.append_text(pairs[i], text);
+        text.push_back(separator);
+        if (!s_terminal && i + 1 < count)
+            continue;
+
+        wide.resize(text.length() + 1);
+        const int32 wide_len = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), int32(text.length()), wide.data(), int32(wide.size()));
+        text.clear();
+
+        const COORD before = end;
+        ok = (wide_len > 0 &&
+              WriteText(wide.data(), uint32(wide_len)) &&
+              GetCursorPosition(end) &&
+              end.Y == before.Y && end.X > before.X);
+        ++stats.queries;
+        if (s_terminal)
+            columns.push_back(end.X - start.X);
+    }
+
+    if (ok && !s_terminal)
+    {
+        ++stats.readbacks;
+        if (!ReadSeparatorColumns(start, uint32(end.X - start.X), separator, count, columns))
+            columns.assign(count, -1);
+        columns.back() = end.X - start.X;
+    }
+
+    EraseMeasurement(start, uint32(max<SHORT>(end.X - start.X, 0)) + 8);
+    return ok;
+}
+
+// Measures a group of pairs and checks the column after each pair, so that a
+// pair that's too narrow can't be hidden by one that's too wide in the same
+// group.  Only groups with mismatches are split up and measured again, down to
+// single pairs, whose width is what the cursor reports.
+static bool VerifyPairs(context_matrix& matrix, const uint32* pairs, uint32 count, char separator, pair_measurements& stats)
+{
+    std::vector<int32> columns;
+    if (!MeasurePairs(matrix, pairs, count, separator, columns, stats))
+        return false;
+
+    if (count == 1)
+    {
+        matrix.set_actual(pairs[0], columns[0] - 1);
+        return true;
+    }
+
+    int32 expected = 0;
+    bool match = true;
+    for (uint32 i = 0; match && i < count; ++i)
+    {
+        expected += matrix.expected(pairs[i]) + 1;
+        match = (columns[i] == expected);
+    }
+
+    if (match)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            matrix.set_actual(pairs[i], matrix.expected(pairs[i]));
+        return true;
+    }
+
+    const uint32 half = count / 2;
+    return (VerifyPairs(matrix, pairs, half, separator, stats) &&
+            VerifyPairs(matrix, pairs + half, count - half, separator, stats));
+}
+
+// Measures every pair of --bases and --marks, and prints a table of the
+// results.
+static int32 RunMatrix(int32 argc)
+{
+    // Each pair is at most 5 columns wide including its separator, and a batch
+    // must not wrap.
+    static const uint32 c_max_batch = 32;
+    static const uint32 c_max_pair_columns = 5;
+
+    std::vector<char32_t> bases;
+    std::vector<char32_t> marks;
+    if (!s_bases || !s_marks || argc)
+    {
+        fputs("The --bases and --marks options must be used together, without codepoint arguments.\n", stderr);
+        return 1;
+    }
+    if (!ParseCodepointList(s_bases, bases))
+    {
+        fprintf(stderr, "Unable to parse '%s' as a list of codepoints or ranges of codepoints.\n", s_bases);
+        return 1;
+    }
+    if (!ParseCodepointList(s_marks, marks))
+    {
+        fprintf(stderr, "Unable to parse '%s' as a list of codepoints or ranges of codepoints.\n", s_marks);
+        return 1;
+    }
+
+    uint32 batch = c_max_batch;
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (!s_terminal && GetConsoleScreenBufferInfo(s_hout, &csbi))
+        batch = max<uint32>(min<uint32>(batch, (csbi.dwSize.X - 1) / c_max_pair_columns), 1);
 
-    if (arg[0] == '0' && (arg[1] == 'x' || arg[1] == 'X'))
+    context_matrix matrix;
+    matrix.init(bases, marks);
+
+    // The separator after each pair must not be one of the codepoints, so
+    // that it can be found when the line is read back.
+    char separator = '|';
+    for (const char* candidate = "|#~^"; *candidate; ++candidate)
     {
-        radix = 16;
-        arg += 2;
+        if (std::find(bases.begin(), bases.end(), char32_t(*candidate)) == bases.end() &&
+            std::find(marks.begin(), marks.end(), char32_t(*candidate)) == marks.end())
+        {
+            separator = *candidate;
+            break;
+        }
     }
-    else if ((arg[0] == 'U' || arg[0] == 'u') && arg[1] == '+')
+
+    fflush(stdout);
+    const DWORD began = GetTickCount();
+
+    std::vector<uint32> pairs;
+    pair_measurements stats;
+    for (uint32 first = 0; first < matrix.pair_count(); first += batch)
     {
-        radix = 16;
-        arg += 2;
+        const uint32 count = min(batch, matrix.pair_count() - first);
+        pairs.clear();
+        for (uint32 i = 0; i < count; ++i)
+            pairs.push_back(first + i);
+
+        if (!VerifyPairs(matrix, pairs.data(), count, separator, stats))
+        {
+            fprintf(stderr, "INTERNAL FAILURE:  unable to verify %04X %04X.\n", uint32(matrix.base(first)), uint32(matrix.mark(first)));
+            return 1;
+        }
     }
 
-    const char32_t x = strtoul(arg, &end, radix);
-    if (!x)
-        return false;
+    const DWORD elapsed = GetTickCount() - began;
 
-    if (end_range)
+    if (s_results.is_open())
     {
-        range.last = x;
-        if (*end && *end != ' ')
-            return false;
+        std::string text;
+        for (uint32 i = 0; i < matrix.pair_count(); ++i)
+        {
+            text.clear();
+            matrix.append_text(i, text);
+
+            result_record record;
+            record.ucs = matrix.base(i);
+            record.seq = text.c_str();
+            record.expected = matrix.expected(i);
+            record.actual = matrix.actual(i);
+            s_results.write(record);
+        }
+        if (!s_results.close())
+        {
+            fprintf(stderr, "Unable to write results to '%s'.\n", s_output);
+            return 1;
+        }
     }
     else
     {
-        range.first = range.last = x;
-        if (end[0] == '-')
-            return ParseCodepoint(end + 1, range, true);
-        if (end[0] == '.' && end[1] == '.')
-            return ParseCodepoint(end + 2, range, true);
-        if (*end && *end != ' ')
-            return false;
+        matrix.print_table(stdout, s_verbose);
     }
 
-    return true;
+    const uint32 mismatches = matrix.mismatch_count();
+    printf("\nTested %u pairs (%u bases x %u marks) in %u.%03u seconds with %u cursor queries and %u line readbacks; %u differ.\n",
+           matrix.pair_count(), matrix.base_count(), matrix.mark_count(), elapsed / 1000, elapsed % 1000,
+           stats.queries, stats.readbacks, mismatches);
+    return !!mismatches;
 }
 
-enum class option_type { boolean, codepoint, init_mode };
+enum class option_type { boolean, codepoint, string, init_mode };
 
 struct option_definition
 {
@@ -458,12 +1371,35 @@ static bool parse_options(int32& argc, char**& argv, const option_definition* op
         for (const option_definition* o = options; o->name; ++o)
         {
             const char* arg = argv[i] + 2;
-            const bool no = (o->type == option_type::boolean && strncmp(arg, "no-", 3) == 0);
+            const bool no = ((o->type == option_type::boolean || o->type == option_type::init_mode) && strncmp(arg, "no-", 3) == 0);
             if (no)
                 arg += 3;
-            if (strcmp(arg, o->name) == 0)
+
+            // Options that take an argument accept either "--name value" or
+            // "--name=value".
+            const char* value = strchr(arg, '=');
+            const size_t name_len = value ? size_t(value - arg) : strlen(arg);
+            const bool takes_value = (o->type == option_type::codepoint || o->type == option_type::string);
+            if (value && !takes_value)
+                continue;
+
+            if (strlen(o->name) == name_len && strncmp(arg, o->name, name_len) == 0)
             {
                 found = true;
+                if (takes_value)
+                {
+                    if (value)
+                        ++value;
+                    else if (i + 1 < argc)
+                        value = argv[++i];
+                    else
+                    {
+                        fprintf(stderr, "Missing argument for %s.\n", argv[i]);
+                        exit(1);
+                        return false;
+                    }
+                }
+
                 switch (o->type)
                 {
                 case option_type::boolean:
@@ -475,22 +1411,18 @@ static bool parse_options(int32& argc, char**& argv, const option_definition* op
                 case option_type::codepoint:
                     {
                         interval interval;
-                        if (i + 1 >= argc)
-                        {
-                            fprintf(stderr, "Missing argument for %s.\n", argv[i]);
-                            exit(1);
-                            return false;
-                        }
-                        ++i;
-                        if (!ParseCodepoint(argv[i], interval) || interval.first != interval.last)
+                        if (!ParseCodepoint(value, interval) || interval.first != interval.last)
                         {
-                            fprintf(stderr, "Unable to parse '%s' as a codepoint.\n", argv[i]);
+                            fprintf(stderr, "Unable to parse '%s' as a codepoint.\n", value);
                             exit(1);
                             return false;
                         }
                         *static_cast<char32_t*>(o->value) = interval.first;
                     }
                     break;
+                case option_type::string:
+                    *static_cast<const char**>(o->value) = value;
+                    break;
                 case option_type::init_mode:
                     *static_cast<int32*>(o->value) = no ? -1 : 1;
                     break;
@@ -522,6 +1454,7 @@ static const option_definition c_options[] =
     { "decimal",                option_type::boolean,     &s_decimal },
     { "color-emoji",            option_type::init_mode,   &s_init_modes.color_emoji },
     { "only-ucs2",              option_type::init_mode,   &s_init_modes.only_ucs2 },
+    { "emoji-version",          option_type::string,      &s_emoji_version },
     { "group-headers",          option_type::boolean,     &s_group_headers },
     { "skip-combining",         option_type::boolean,     &s_skip_combining },
     { "skip-emoji",             option_type::boolean,     &s_skip_emoji },
@@ -530,6 +1463,22 @@ static const option_definition c_options[] =
     { "skip-kana",              option_type::boolean,     &s_skip_kana },
     { "skip-all",               option_type::boolean,     &s_skip_all },
     { "show-width",             option_type::boolean,     &s_show_width },
+    { "format",                 option_type::string,      &s_format },
+    { "output",                 option_type::string,      &s_output },
+    { "profile",                option_type::string,      &s_profile },
+    { "save-profile",           option_type::string,      &s_save_profile },
+    { "diff",                   option_type::boolean,     &s_diff },
+    { "predict-all",            option_type::boolean,     &s_predict_all },
+    { "bench",                  option_type::string,      &s_bench },
+    { "headless",               option_type::string,      &s_headless },
+    { "dsr",                    option_type::boolean,     &s_dsr },
+    { "calibrate",              option_type::boolean,     &s_calibrate },
+    { "recalibrate",            option_type::boolean,     &s_recalibrate },
+    { "timing",                 option_type::boolean,     &s_timing },
+    { "timing-output",          option_type::string,      &s_timing_output },
+    { "full",                   option_type::boolean,     &s_full },
+    { "bases",                  option_type::string,      &s_bases },
+    { "marks",                  option_type::string,      &s_marks },
     {}
 };
 
@@ -537,17 +1486,15 @@ int main(int argc, char** argv)
 {
     --argc, ++argv;
 
-    DWORD mode;
-    if (!GetConsoleMode(s_hout, &mode))
-    {
-        fputs("This test tool is not compatible with redirected output.\n", stderr);
-        return 1;
-    }
-
     if (!parse_options(argc, argv, c_options))
     {
         static const char usage[] =
         "Usage:  wcwv [flags] [codepoint [...]]\n"
+        "        wcwv --diff config1 config2\n"
+        "        wcwv --predict-all [--output file]\n"
+        "        wcwv --bench name\n"
+        "        wcwv --headless config [flags] [codepoint [...]]\n"
+        "        wcwv --bases list --marks list [flags]\n"
         "\n"
         "  Each \"codepoint\" can be a single value, or a range of values denoted by two\n"
         "  values separated by '..' or '-' (such as '0x300..0x31F').  By default, values\n"
@@ -560,8 +1507,76 @@ int main(int argc, char** argv)
         "  --suffix codepoint    Set codepoint for suffix character (default is U+20,\n"
         "                        which is the space character).\n"
         "\n"
+        "  --format fmt          Write one record per measurement to the --output file,\n"
+        "                        in the specified format (jsonl, csv, or bin).\n"
+        "  --output file         Set the file for --format output.\n"
+        "\n"
+        "  --profile file        Predict widths using the width profile in the file,\n"
+        "                        instead of the built-in tables.\n"
+        "  --save-profile file   Save the width profile for the current modes (or for\n"
+        "                        --profile) to the file, and exit.\n"
+        "  --emoji-version ver   Predict color emoji widths using the emoji from an\n"
+        "                        older emoji version (such as 13.0), for terminals\n"
+        "                        that haven't been updated.  Use --emoji-version=list\n"
+        "                        to list the versions.\n"
+        "\n"
+        "  --diff                Compare the widths of two configs for all codepoints\n"
+        "                        and emoji sequences, and print the differences.  A\n"
+        "                        config is mk_wcwidth, mk_wcwidth_ucs2, mk_wcwidth_cjk,\n"
+        "                        or mk_wcwidth_cjk_ucs2 (optionally followed by +color\n"
+        "                        and/or an emoji version such as +e13.0), a profile\n"
+        "                        file, or a --format=bin results file.\n"
+        "\n"
+        "  --predict-all         Write the predicted widths of all codepoints and emoji\n"
+        "                        sequences in every combination of modes (each config\n"
+        "                        as for --diff, on each Windows version) to stdout or\n"
+        "                        to the --output file.  The snapshot is deterministic,\n"
+        "                        so diffing two snapshots shows what a table change\n"
+        "                        does.\n"
+        "\n"
+        "  --headless config     Run the tests without a console, against an in-process\n"
+        "                        terminal model that renders text using the widths of\n"
+        "                        the config (a built-in config or a profile file, as\n"
+        "                        for --diff).  The full tests include all codepoints\n"
+        "                        instead of only the BMP, and the exit code is nonzero\n"
+        "                        if any widths differ.\n"
+        "\n"
+        "  --dsr                 Measure widths by querying the cursor position with VT\n"
+        "                        escape sequences instead of console APIs, so that the\n"
+        "                        terminal itself is measured even through a pty (such\n"
+        "                        as over ssh).  Many queries are pipelined at once;\n"
+        "                        the query rate is printed along with the rate when\n"
+        "                        waiting for each reply.\n"
+        "\n"
+        "  --calibrate           Measure about ten probe strings in one batch, and\n"
+        "                        use the built-in modes that best match the terminal,\n"
+        "                        instead of guessing from the environment.  The choice\n"
+        "                        is cached per kind of terminal in %LOCALAPPDATA%.\n"
+        "  --recalibrate         Calibrate even if there's a cached choice.\n"
+        "\n"
+        "  --timing-output file  Write the timing breakdown (see --timing) to the file\n"
+        "                        as JSON, including the histogram buckets, so runs can\n"
+        "                        be compared across terminals and terminal versions.\n"
+        "\n"
+        "  --bench name          Run the named benchmark (using the current modes or\n"
+        "                        --profile), and print the results.  Use --bench=list\n"
+        "                        to list the benchmarks.\n"
+        "\n"
+        "  --bases list          Measure every pair of a base codepoint from the list\n"
+        "  --marks list          and a mark codepoint from the list (such as how each\n"
+        "                        combining mark affects each base), and print a table\n"
+        "                        of the results with a row per base and a column per\n"
+        "                        mark.  A list is codepoints or ranges separated by\n"
+        "                        commas.  Pairs are written in batches, and each\n"
+        "                        pair's column is read back; only batches with\n"
+        "                        mismatches are split up and measured again.  Only\n"
+        "                        rows with mismatches are shown, unless --verbose is\n"
+        "                        used.\n"
+        "\n"
         "  NOTE:  the --prefix and --suffix options are experimental, and can be used to\n"
         "  help manually analyze how combining marks affect grapheme widths.\n"
+        "  NOTE:  when --format is used, the console is only used for measuring; group\n"
+        "  headers, failure reports, and --verbose/--show-width details are omitted.\n"
         "\n"
         "On/off options:\n"
         "  --verbose             Verbose output; don't erase failed codepoints.\n"
@@ -570,6 +1585,13 @@ int main(int argc, char** argv)
         "  --only-ucs2           Assume only UCS2 support.\n"
         "  --group-headers       Shows names of groups of codepoints (default).\n"
         "  --show-width          Shows expected and actual width for each character.\n"
+        "  --full                Verify everything, instead of only the codepoints whose\n"
+        "                        predicted widths changed or that failed in the last\n"
+        "                        run, plus a small random sample of the rest.\n"
+        "  --timing              Show the rate and time remaining in the console title,\n"
+        "                        and print a breakdown of where the time went:  latency\n"
+        "                        percentiles for each step of a measurement, and the\n"
+        "                        slowest blocks and measurements.\n"
         "  --skip-combining      Skip testing combining marks.\n"
         "  --skip-emoji          Skip testing emojis.\n"
         "  --skip-eaa            Skip testing East Asian Ambiguous characters.\n"
@@ -585,7 +1607,8 @@ int main(int argc, char** argv)
         "\n"
         "Examples:\n"
         "\n"
-        "  wcwv                  Run the full tests.\n"
+        "  wcwv                  Run the full tests.  After the first run, only what\n"
+        "                        changed since the last run is measured.\n"
         "  wcwv --verbose        Run the full tests, and leave failed codepoints visible\n"
         "                        after failing.\n"
         "  wcwv 300              Run the test on codepoint U+300.\n"
@@ -593,14 +1616,219 @@ int main(int argc, char** argv)
         "  wcwv 300..3FF         Run the test on codepoints U+300 through U+3FF.\n"
         "  wcwv 20..2F 40..5F    Run the test on codepoints U+20 through U+2F\n"
         "                        and U+40 through U+5F.\n"
+        "  wcwv --format=jsonl --output=results.jsonl\n"
+        "                        Run the full tests, and write the results to the\n"
+        "                        results.jsonl file.\n"
+        "  wcwv --diff mk_wcwidth+color mk_wcwidth_ucs2\n"
+        "                        Show how widths differ between Windows Terminal and\n"
+        "                        conhost.\n"
+        "  wcwv --diff mk_wcwidth+color+e13.0 mk_wcwidth+color\n"
+        "                        Show which emoji were added after emoji version 13.0.\n"
+        "  wcwv --predict-all --output=before.txt\n"
+        "                        Save every prediction, to diff against a snapshot\n"
+        "                        taken after changing the tables.\n"
+        "  wcwv --bench=dbcs     Compare measuring DBCS code page text directly against\n"
+        "                        converting it to UTF-8 first.\n"
+        "  wcwv --bases=41..5A,1100..1112 --marks=300..36F\n"
+        "                        Measure how each combining diacritical mark affects\n"
+        "                        Latin capital letters and Hangul leading consonants.\n"
+        "  wcwv --headless=baseline.wcwp\n"
+        "                        Check the current tables against widths saved earlier\n"
+        "                        with --save-profile=baseline.wcwp.\n"
+        "  wcwv --no-color-emoji --save-profile=mono.wcwp\n"
+        "                        Save the built-in widths without color emoji to the\n"
+        "                        mono.wcwp file.\n"
         ;
         printf("%s", usage);
         return 0;
     }
 
+    if (s_emoji_version)
+    {
+        uint32 count;
+        const uint32* versions = get_emoji_versions(count);
+        if (strcmp(s_emoji_version, "list") == 0)
+        {
+            for (uint32 i = 0; i < count; ++i)
+                printf("%u.%u%s\n", versions[i] / 10, versions[i] % 10, i ? "" : "  (default)");
+            return 0;
+        }
+
+        uint32 version;
+        if (!parse_emoji_version(s_emoji_version, version))
+        {
+            fprintf(stderr, "Unsupported emoji version '%s'; use --emoji-version=list to list them.\n", s_emoji_version);
+            return 1;
+        }
+        s_init_modes.emoji_version = int32(version);
+    }
+
+    // Diffing only evaluates widths, so it doesn't need a console.
+    if (s_diff)
+    {
+        if (argc != 2)
+        {
+            fprintf(stderr, "The --diff option requires exactly two configs.\n");
+            return 1;
+        }
+
+        width_config configs[2];
+        for (int32 i = 0; i < 2; ++i)
+        {
+            if (!configs[i].load(argv[i]))
+            {
+                fprintf(stderr, "Unable to load '%s' as a config, profile, or results file.\n", argv[i]);
+                return 1;
+            }
+        }
+
+        diff_widths(configs[0], configs[1], stdout);
+        return 0;
+    }
+
+    // So does predicting all widths.
+    if (s_predict_all)
+    {
+        FILE* out = s_output ? fopen(s_output, "wb") : stdout;
+        if (!out)
+        {
+            fprintf(stderr, "Unable to open '%s' for writing.\n", s_output);
+            return 1;
+        }
+
+        bool ok = write_prediction_snapshot(out);
+        if (out != stdout)
+            ok = (fclose(out) == 0) && ok;
+        if (!ok)
+        {
+            fprintf(stderr, "Unable to write the prediction snapshot.\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    // Benchmarks only measure strings, so they don't need a console either.
+    if (s_bench)
+    {
+        if (strcmp(s_bench, "list") == 0)
+        {
+            list_benchmarks(stdout);
+            return 0;
+        }
+
+        initialize_wcwidth(&s_init_modes);
+        if (s_profile)
+        {
+            const wcwidth_profile* profile = load_wcwidth_profile(s_profile);
+            if (!profile)
+            {
+                fprintf(stderr, "Unable to load width profile '%s'.\n", s_profile);
+                return 1;
+            }
+            activate_wcwidth_profile(profile);
+        }
+
+        uint32 failures = 0;
+        if (!run_benchmark(s_bench, stdout, failures))
+        {
+            fprintf(stderr, "There is no benchmark named '%s'; use --bench=list to list them.\n", s_bench);
+            return 1;
+        }
+        if (failures)
+        {
+            fprintf(stderr, "The '%s' benchmark found %u mismatches or failures.\n", s_bench, failures);
+            return 1;
+        }
+        return 0;
+    }
+
+    // The terminal model replaces the console.
+    width_config headless_config;
+    std::unique_ptr<terminal_model> headless_terminal;
+    if (s_headless)
+    {
+        if (!headless_config.load(s_headless) || !headless_config.profile())
+        {
+            fprintf(stderr, "Unable to load '%s' as a config or profile for --headless.\n", s_headless);
+            return 1;
+        }
+        headless_terminal = std::make_unique<terminal_model>(headless_config.profile());
+        s_terminal = headless_terminal.get();
+    }
+
+    DWORD mode;
+    if (!s_terminal && !GetConsoleMode(s_hout, &mode))
+    {
+        fputs("This test tool is not compatible with redirected output.\n", stderr);
+        return 1;
+    }
+
+    if (s_dsr && s_terminal)
+    {
+        fputs("The --dsr and --headless options cannot be used together.\n", stderr);
+        return 1;
+    }
+
+    if (s_dsr && (s_bases || s_marks))
+    {
+        fputs("The --dsr option cannot be used with --bases and --marks.\n", stderr);
+        return 1;
+    }
+
+    if (s_format || s_output)
+    {
+        result_format format;
+        if (!s_format || !parse_result_format(s_format, format))
+        {
+            fprintf(stderr, "The --format option must be jsonl, csv, or bin.\n");
+            return 1;
+        }
+        if (!s_output)
+        {
+            fprintf(stderr, "The --format option requires --output.\n");
+            return 1;
+        }
+        if (!s_results.open(s_output, format))
+        {
+            fprintf(stderr, "Unable to open '%s' for writing.\n", s_output);
+            return 1;
+        }
+    }
+
     setlocale(LC_ALL, ".utf8");
 
     initialize_wcwidth(&s_init_modes);
+
+    if (s_profile)
+    {
+        const wcwidth_profile* profile = load_wcwidth_profile(s_profile);
+        if (!profile)
+        {
+            fprintf(stderr, "Unable to load width profile '%s'.\n", s_profile);
+            return 1;
+        }
+        activate_wcwidth_profile(profile);
+    }
+    else if (s_calibrate || s_recalibrate)
+    {
+        if (!Calibrate())
+        {
+            fputs("Unable to calibrate; the terminal might not support DSR.\n", stderr);
+            return 1;
+        }
+    }
+
+    if (s_save_profile)
+    {
+        if (!save_wcwidth_profile(s_save_profile, get_wcwidth_profile()))
+        {
+            fprintf(stderr, "Unable to write width profile '%s'.\n", s_save_profile);
+            return 1;
+        }
+        printf("Saved width profile '%s' to '%s'.\n", get_wcwidth_profile()->name, s_save_profile);
+        return 0;
+    }
+
     const bool c_only_ucs2 = get_only_ucs2();
 
     std::vector<block_range> manual_ranges;
@@ -664,142 +1892,98 @@ int main(int argc, char** argv)
         printf("\n");
     }
 
-    const bool s_sequences_supported = get_color_emoji();
-    const block_range* const ranges = manual_ranges.empty() ? c_blocks : &manual_ranges.front();
-    const DWORD began = GetTickCount();
-
-    uint32 tested = 0;
-    uint32 failed = 0;
-
-    for (const block_range* range = ranges; range->first; ++range)
+    // The pipeline restores the console modes when it goes out of scope.
+    std::unique_ptr<dsr_pipeline> dsr;
+    if (s_dsr)
     {
-        if (manual_ranges.empty() && range->first >= 0x10000)
-            break;
-
-        if (s_skip_ideographs && range->desc && strstr(range->desc, "Ideograph"))
-            continue;
-
-        // char32_t prev = 0;
-
-        char32_t first_failure = 0;
-        char32_t last_failure = 0;
-
-        if (s_group_headers)
+        dsr = std::make_unique<dsr_pipeline>(s_hout, GetStdHandle(STD_INPUT_HANDLE));
+        if (!dsr->open() || !CompareDsrRates(*dsr))
         {
-            // CONSOLE_SCREEN_BUFFER_INFO csbi;
-            // GetConsoleScreenBufferInfo(s_hout, &csbi);
-            // SetConsoleTextAttribute(s_hout, csbi.wAttributes | 0xF);
-
-            if (range->first == range->last)
-                printf("CODEPOINT %04X", uint32(range->first));
-            else if (range->desc)
-                printf("%04X .. %04X -- %s", uint32(range->first), uint32(range->last), range->desc);
-            else
-                printf("%04X .. %04X", uint32(range->first), uint32(range->last));
-
-            // SetConsoleTextAttribute(s_hout, csbi.wAttributes);
-            puts("");
+            fputs("Unable to query the cursor position; the terminal might not support DSR.\n", stderr);
+            return 1;
         }
+        s_dsr_pipeline = dsr.get();
+    }
 
-        auto maybe_report_failure_range = [&](){
-            if (first_failure)
-            {
-                CONSOLE_SCREEN_BUFFER_INFO csbi;
-                HANDLE herr = GetStdHandle(STD_ERROR_HANDLE);
-                GetConsoleScreenBufferInfo(herr, &csbi);
-                SetConsoleTextAttribute(herr, (csbi.wAttributes & 0xF0) | 0x0C);
-
-                fprintf(stderr, "FAILED:  %04X..%04X do not match the expected width (%u codepoints).", uint32(first_failure), uint32(last_failure), uint32(last_failure + 1 - first_failure));
-
-                SetConsoleTextAttribute(herr, csbi.wAttributes);
-                fputs("\n", stderr);
+    if (s_bases || s_marks)
+        return RunMatrix(argc);
 
-                first_failure = 0;
-                last_failure = 0;
-            }
-        };
+    const bool s_sequences_supported = get_color_emoji();
+    const block_range* const ranges = manual_ranges.empty() ? c_blocks : &manual_ranges.front();
 
-        for (char32_t c = range->first; c <= range->last; ++c)
+    // The full tests remember each prediction and result for the next run,
+    // which then only measures what changed (unless --full is used).  The
+    // --format output is for the full tests, and --headless is fast anyway.
+    last_run last;
+    if (manual_ranges.empty() && !s_terminal)
+    {
+        std::string key;
+        get_terminal_identity(key);
+        char settings[96];
+        sprintf(settings, ";prefix=%X;suffix=%X;dsr=%u;skip=%u%u%u%u%u%u", uint32(s_prefix), uint32(s_suffix), s_dsr,
+                s_skip_all, s_skip_combining, s_skip_emoji, s_skip_eaa, s_skip_ideographs, s_skip_kana);
+        key += settings;
+
+        const bool loaded = last.load(key.c_str());
+        if (last.begin_save())
         {
-            const bool single_codepoint = (range->first == range->last);
-            if (!single_codepoint && IsSkip(c))
-            {
-                maybe_report_failure_range();
-                continue;
-            }
-
-            const bool assigned = is_assigned(c);
-            if (!assigned && !single_codepoint)
-            {
-                maybe_report_failure_range();
-                continue;
-            }
-
-            // if (!prev || (prev >> 12) != (c >> 12))
-            // {
-            //     if (!prev)
-            //         printf("%04X ...\n", uint32(c));
-            //     prev = c;
-            // }
+            s_last_run = &last;
+            s_incremental = loaded && !s_full && !s_results.is_open();
+        }
+    }
 
-            if (!assigned && single_codepoint)
-                printf("NOTE:  %04X is not an assigned codepoint.\n", uint32(c));
+    // The measurements are counted up front, to estimate the time remaining.
+    // Which unchanged items get measured isn't known up front, so there's no
+    // estimate for an incremental run.
+    std::unique_ptr<verify_timing> timing;
+    if (s_timing || s_timing_output)
+    {
+        const uint32 expected = s_incremental ? 0 : CountMeasureItems(ranges, manual_ranges.empty(), c_only_ucs2);
 
-            int32 verified = true;
-            const emoji_form_sequence* sequence = get_emoji_form_sequence(c);
-            if (sequence)
-            {
-                for (int32 n = 0; sequence->ucs == c; ++n)
-                {
-                    if (!c_only_ucs2 || IsSequenceSupported(sequence->seq))
-                    {
-                        const int32 v = VerifyWidth(sequence);
-                        if (v < 0)
-                        {
-                            fprintf(stderr, "INTERNAL FAILURE:  unable to verify sequence #%d for %04X.\n", n, uint32(c));
-                            return 1;
-                        }
+        timing = std::make_unique<verify_timing>();
+        timing->begin_run(expected);
+        s_verify_timing = timing.get();
+    }
 
-                        if (!v)
-                        {
-                            ++failed;
-                            if (!first_failure)
-                                first_failure = c;
-                            last_failure = c;
-                            verified = false;
-                        }
+    const DWORD began = GetTickCount();
 
-                        ++tested;
-                    }
+    verify_report report;
+    if (!VerifyRanges(ranges, manual_ranges.empty(), c_only_ucs2, report))
+        return 1;
 
-                    ++sequence;
-                }
-            }
-            else
-            {
-                verified = VerifyWidth(c);
-                if (verified < 0)
-                {
-                    fprintf(stderr, "INTERNAL FAILURE:  unable to verify %04X.\n", uint32(c));
-                    return 1;
-                }
+    const uint32 tested = report.tested;
+    const uint32 failed = report.failed;
 
-                if (!verified)
-                {
-                    ++failed;
-                    if (!first_failure)
-                        first_failure = c;
-                    last_failure = c;
-                }
+    if (s_last_run)
+        s_last_run->end_save();
 
-                ++tested;
-            }
+    if (!s_results.close())
+    {
+        fprintf(stderr, "Unable to write results to '%s'.\n", s_output);
+        return 1;
+    }
 
-            if (verified)
-                maybe_report_failure_range();
+    if (s_verify_timing)
+    {
+        s_verify_timing->end_run();
+        if (s_timing)
+            s_verify_timing->print_breakdown(stdout);
+        if (s_timing_output && !s_verify_timing->export_json(s_timing_output))
+        {
+            fprintf(stderr, "Unable to write timing to '%s'.\n", s_timing_output);
+            return 1;
         }
+    }
 
-        maybe_report_failure_range();
+    const DWORD elapsed = GetTickCount() - began;
+    if (s_terminal)
+    {
+        // Output is likely redirected, so report without colors.
+        printf("\nTested %u codepoints in %u.%03u seconds", tested, elapsed / 1000, elapsed % 1000);
+        if (elapsed)
+            printf(" (%.0f per second)", double(tested) * 1000 / elapsed);
+        printf("; %u failed.\n", failed);
+        return !!failed;
     }
 
     CONSOLE_SCREEN_BUFFER_INFO csbiAttr;
@@ -810,12 +1994,14 @@ int main(int argc, char** argv)
                        (failed > 200 || ratio > 0.01f) ? 0x0C :
                        0x0E);
 
-    const DWORD elapsed = GetTickCount() - began;
     printf("\nTested %u codepoints in %u.%03u seconds; ", tested, elapsed / 1000, elapsed % 1000);
     SetConsoleTextAttribute(s_hout, (csbiAttr.wAttributes & ~0xF) | attr);
     printf("%u", failed);
     SetConsoleTextAttribute(s_hout, csbiAttr.wAttributes);
     printf(" failed.\n");
 
+    if (report.unchanged)
+        printf("Skipped %u codepoints that passed in the last run and still have the same\npredicted widths; use --full to verify them too.\n", report.unchanged);
+
     return !!failed;
 }
@@ -7,12 +7,16 @@
 
 typedef __int8 int8;
 typedef unsigned __int8 uint8;
+typedef __int16 int16;
+typedef unsigned __int16 uint16;
 typedef __int32 int32;
 typedef unsigned __int32 uint32;
+typedef __int64 int64;
+typedef unsigned __int64 uint64;
 
 #undef min
 #undef max
-template<class T> T min(T a, T b) { return (a <= b) ? a : b; }
-template<class T> T max(T a, T b) { return (a >= b) ? a : b; }
+template<class T> constexpr T min(T a, T b) { return (a <= b) ? a : b; }
+template<class T> constexpr T max(T a, T b) { return (a >= b) ? a : b; }
 
 #include "wcwidth.h"
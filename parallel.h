@@ -0,0 +1,35 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+//------------------------------------------------------------------------------
+// Calls fn(begin, end) for consecutive chunks of [0, count), on as many
+// threads as there are CPUs (including the calling thread).  Chunks are handed
+// out on demand, since some chunks can be much more expensive than others.
+template <class T>
+void parallel_chunks(uint32 count, uint32 chunk, const T& fn)
+{
+    std::atomic<uint32> next = 0;
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            const uint32 begin = next.fetch_add(chunk);
+            if (begin >= count)
+                break;
+            fn(begin, min(begin + chunk, count));
+        }
+    };
+
+    const uint32 num_threads = min<uint32>(max<uint32>(std::thread::hardware_concurrency(), 1), (count + chunk - 1) / chunk);
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < num_threads; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "width_diff.h"
+#include "emoji_forms.h"
+#include "prediction_snapshot.h"
+#include "parallel.h"
+
+#include <string>
+
+static const uint32 c_snapshot_version = 2;
+
+// Codepoints are evaluated a block at a time, for all columns at once, so
+// that the widths don't need a byte per codepoint per column.
+static const uint32 c_block_size = 0x10000;
+
+//------------------------------------------------------------------------------
+static char width_char(int8 width)
+{
+    return (width < 0) ? '-' : (width <= 9) ? char('0' + width) : '+';
+}
+
+//------------------------------------------------------------------------------
+static void print_codepoint_row(FILE* out, char32_t first, char32_t last, const std::string& row)
+{
+    if (first == last)
+        fprintf(out, "%04X %s\n", uint32(first), row.c_str());
+    else
+        fprintf(out, "%04X..%04X %s\n", uint32(first), uint32(last), row.c_str());
+}
+
+//------------------------------------------------------------------------------
+bool write_prediction_snapshot(FILE* out)
+{
+    std::vector<builtin_combination> columns;
+    get_builtin_combinations(columns);
+    const uint32 num_columns = uint32(columns.size());
+
+    fprintf(out, "# wcwv prediction snapshot %u\n", c_snapshot_version);
+    fprintf(out, "# Each row has one width per column:  0..9, or - for a negative width.\n");
+    fprintf(out, "# Codepoint rows have a second group of columns with the width of the\n");
+    fprintf(out, "# codepoint by itself in the profile, where zero width, combining, and\n");
+    fprintf(out, "# control codepoints differ from the wcswidth() of the codepoint.\n");
+    fprintf(out, "#\n");
+    for (uint32 i = 0; i < num_columns; ++i)
+        fprintf(out, "# column %u: %s\n", i + 1, columns[i].name);
+
+    // Codepoints.
+    fputs("[codepoints]\n", out);
+    const uint32 num_cells = num_columns * c_block_size;
+    std::vector<int8> widths(num_cells * 2);
+    std::string row(num_columns * 2 + 1, ' ');
+    std::string prev;
+    char32_t first = 0;
+    for (uint32 block = 0; block < 0x110000; block += c_block_size)
+    {
+        parallel_chunks(num_cells, 0x1000, [&](uint32 begin, uint32 end)
+        {
+            const wcwidth_profile* const profile = &columns[begin / c_block_size].profile;
+            char utf8[8];
+            for (uint32 i = begin; i < end; ++i)
+            {
+                const char32_t ucs = char32_t(block + i % c_block_size);
+                const uint32 len = to_utf8(ucs, utf8);
+                widths[i] = int8(wcswidth(utf8, len, profile));
+                widths[num_cells + i] = int8(profile->width(ucs, profile->combining_mark_width));
+            }
+        });
+
+        for (uint32 offset = 0; offset < c_block_size; ++offset)
+        {
+            for (uint32 c = 0; c < num_columns; ++c)
+            {
+                row[c] = width_char(widths[c * c_block_size + offset]);
+                row[num_columns + 1 + c] = width_char(widths[num_cells + c * c_block_size + offset]);
+            }
+
+            const char32_t ucs = block + offset;
+            if (row != prev)
+            {
+                if (ucs)
+                    print_codepoint_row(out, first, ucs - 1, prev);
+                prev = row;
+                first = ucs;
+            }
+        }
+    }
+    print_codepoint_row(out, first, 0x10ffff, prev);
+
+    // Sequences.
+    fputs("[sequences]\n", out);
+    uint32 count;
+    const emoji_form_sequence* const forms = get_emoji_form_sequences(count);
+    widths.resize(size_t(num_columns) * count);
+    row.resize(num_columns);
+    parallel_chunks(num_columns * count, 0x100, [&](uint32 begin, uint32 end)
+    {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const char* seq = forms[i % count].seq;
+            widths[i] = int8(wcswidth(seq, uint32(strlen(seq)), &columns[i / count].profile));
+        }
+    });
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        str_iter iter(forms[i].seq);
+        while (iter.more())
+        {
+            if (iter.get_pointer() > forms[i].seq)
+                fputc(' ', out);
+            fprintf(out, "%04X", iter.next());
+        }
+        for (uint32 c = 0; c < num_columns; ++c)
+            row[c] = width_char(widths[c * count + i]);
+        fprintf(out, " %s\n", row.c_str());
+    }
+
+    return !ferror(out);
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Writes the width that wcswidth() predicts for every codepoint 0..0x10FFFF
+// and every known emoji form, in every combination of the built-in modes
+// (see get_builtin_combinations()).
+//
+// The snapshot is text with one column per combination, so that a table
+// change shows up as a small diff:
+//
+//      # column 1: mk_wcwidth win8
+//      ...
+//      [codepoints]
+//      0000 000000000000... 000000000000...
+//      0001..001F 111111111111... ------------...
+//      [sequences]
+//      0023 FE0F 20E3 111122221111...
+//
+// Codepoint rows have a second group of columns with the width of the
+// codepoint by itself in each profile (wcwidth_profile::width()), so that a
+// table change to a zero width, combining, or control codepoint shows up even
+// where wcswidth() of the codepoint alone doesn't change.  Consecutive
+// codepoints with the same widths in every column share a row.  A width is
+// 0..9, or - if it's negative, or + if it's more than 9.  The output depends
+// only on the tables, not on the OS or console it runs in.  Returns false if
+// writing failed.
+bool write_prediction_snapshot(FILE* out);
@@ -15,6 +15,7 @@ workspace("wcwidth-verifier")
     location(to)
 
     characterset("MBCS")
+    cppdialect("C++20")
     manifest("off")
     fatalwarnings("all")
     staticruntime("on")
@@ -42,9 +43,36 @@ workspace("wcwidth-verifier")
         files("str_iter.cpp")
         files("wcwidth.cpp")
         files("wcwidth_iter.cpp")
+        files("wcwidth_profile.cpp")
+        files("wcswidth_cache.cpp")
+        files("wcswidth_parallel.cpp")
+        files("column_index.cpp")
+        files("codepoint_names.cpp")
+        files("dbcs_width.cpp")
+        files("render_width.cpp")
+        files("column_format.cpp")
+        files("redraw_diff.cpp")
+        files("cell_grid.cpp")
+        files("terminal_model.cpp")
+        files("dsr_pipeline.cpp")
+        files("latency_histogram.cpp")
+        files("verify_timing.cpp")
+        files("context_matrix.cpp")
+        files("emoji_forms.cpp")
+        files("result_writer.cpp")
+        files("last_run.cpp")
+        files("width_diff.cpp")
+        files("prediction_snapshot.cpp")
+        files("calibration.cpp")
+        files("bench.cpp")
         files("main.cpp")
         files("main.rc")
 
+        filter "options:no-embedded-names"
+            defines("NO_EMBEDDED_NAMES")
+            postbuildcommands({ '{COPYFILE} "' .. path.getabsolute("codepoint-names.bin") .. '" "%{cfg.targetdir}"' })
+        filter {}
+
 --------------------------------------------------------------------------------
 local function escape_cpp(text)
     return text:gsub("([?\"\\])", "\\%1")
@@ -56,33 +84,167 @@ local function to_symbol_cpp(text)
 end
 
 --------------------------------------------------------------------------------
-local function utf32to8(c)
+local function utf32to8_bytes(c)
     if type(c) ~= "number" then
         error(string.format("arg #1 unexpected type %s; expected number", type(c)))
     elseif c < 0 then
         error(string.format("arg #1 cannot be negative"))
     elseif c <= 0x007f then
-        return string.format("\\x%02x", c)
+        return { c }
     elseif c <= 0x07ff then
         local b2 = 0x80 + bit32.band(c, 0x3f)
         local b1 = 0xc0 + bit32.band(bit32.rshift(c, 6), 0x1f)
-        return string.format("\\x%02x\\x%02x", b1, b2)
+        return { b1, b2 }
     elseif c <= 0xffff then
         local b3 = 0x80 + bit32.band(c, 0x3f)
         local b2 = 0x80 + bit32.band(bit32.rshift(c, 6), 0x3f)
         local b1 = 0xe0 + bit32.band(bit32.rshift(c, 12), 0x0f)
-        return string.format("\\x%02x\\x%02x\\x%02x", b1, b2, b3)
+        return { b1, b2, b3 }
     elseif c <= 0x10ffff then
         local b4 = 0x80 + bit32.band(c, 0x3f)
         local b3 = 0x80 + bit32.band(bit32.rshift(c, 6), 0x3f)
         local b2 = 0x80 + bit32.band(bit32.rshift(c, 12), 0x3f)
         local b1 = 0xf0 + bit32.band(bit32.rshift(c, 18), 0x07)
-        return string.format("\\x%02x\\x%02x\\x%02x\\x%02x", b1, b2, b3, b4)
+        return { b1, b2, b3, b4 }
     else
         error(string.format("arg #1 value 0x%x exceeds 0x10ffff", c))
     end
 end
 
+--------------------------------------------------------------------------------
+local function utf32to8(c)
+    local s = ""
+    for _, b in ipairs(utf32to8_bytes(c)) do
+        s = s .. string.format("\\x%02x", b)
+    end
+    return s
+end
+
+--------------------------------------------------------------------------------
+-- FNV-1 over an array of bytes, starting from the given seed.  Must match
+-- perfect_hash() in emoji_forms.cpp.  The multiply is split so that it stays
+-- exact even when the intermediate values are floating point.
+local function perfect_hash(seed, bytes)
+    local h = (seed ~= 0) and seed or 0x811c9dc5
+    for _, b in ipairs(bytes) do
+        h = ((h % 0x100) * 0x1000000 + h * 403) % 0x100000000
+        h = bit32.bxor(h, b)
+    end
+    return h
+end
+
+--------------------------------------------------------------------------------
+-- Builds a minimal perfect hash over an array of keys (each key is an array
+-- of bytes), using the hash-and-displace approach.  Returns an array of
+-- displacements and an array mapping slots to key indices (both 0-based, for
+-- emitting into C++ tables).
+--
+-- Lookup:  d = disp[hash(0, key) % n]; the slot is -d - 1 if d is negative,
+-- otherwise hash(d, key) % n.  The caller must verify the key in the slot.
+local function build_perfect_hash(keys)
+    local n = #keys
+    local buckets = {}
+    for i, key in ipairs(keys) do
+        local b = perfect_hash(0, key) % n
+        if not buckets[b] then
+            buckets[b] = {}
+        end
+        table.insert(buckets[b], i)
+    end
+
+    -- Place the largest buckets first, while the most slots are free.
+    local order = {}
+    for b, _ in pairs(buckets) do
+        table.insert(order, b)
+    end
+    table.sort(order, function (x, y)
+        local nx = #buckets[x]
+        local ny = #buckets[y]
+        if nx ~= ny then
+            return nx > ny
+        end
+        return x < y
+    end)
+
+    local disp = {}
+    local slots = {}
+    for i = 0, n - 1 do
+        disp[i] = 0
+    end
+
+    -- Find a seed for each multi-key bucket that scatters its keys into free
+    -- slots.
+    local singles = {}
+    for _, b in ipairs(order) do
+        local bucket = buckets[b]
+        if #bucket == 1 then
+            table.insert(singles, b)
+        else
+            local d = 1
+            while true do
+                local placed = {}
+                local ok = true
+                for _, i in ipairs(bucket) do
+                    local s = perfect_hash(d, keys[i]) % n
+                    if slots[s] or placed[s] then
+                        ok = false
+                        break
+                    end
+                    placed[s] = i
+                end
+                if ok then
+                    for s, i in pairs(placed) do
+                        slots[s] = i
+                    end
+                    disp[b] = d
+                    break
+                end
+                d = d + 1
+            end
+        end
+    end
+
+    -- Single-key buckets go directly into the remaining free slots.
+    local free = 0
+    for _, b in ipairs(singles) do
+        while slots[free] do
+            free = free + 1
+        end
+        slots[free] = buckets[b][1]
+        disp[b] = -free - 1
+    end
+
+    local index = {}
+    for s = 0, n - 1 do
+        index[s] = slots[s] - 1
+    end
+    return disp, index
+end
+
+--------------------------------------------------------------------------------
+local function output_perfect_hash(out, tag, keys, values)
+    local disp, index = build_perfect_hash(keys)
+    if values then
+        for s = 0, #keys - 1 do
+            index[s] = values[index[s] + 1]
+        end
+    end
+
+    out:write("\nstatic const int32 " .. tag .. "_disp[] = {\n\n")
+    for s = 0, #keys - 1 do
+        out:write(string.format("%d,", disp[s]))
+        out:write((s % 16 == 15 or s == #keys - 1) and "\n" or " ")
+    end
+    out:write("\n};\n")
+
+    out:write("\nstatic const uint16 " .. tag .. "_index[] = {\n\n")
+    for s = 0, #keys - 1 do
+        out:write(string.format("%d,", index[s]))
+        out:write((s % 16 == 15 or s == #keys - 1) and "\n" or " ")
+    end
+    out:write("\n};\n")
+end
+
 --------------------------------------------------------------------------------
 local function parse_version_file()
     local ver_file = io.open("version.h")
@@ -134,7 +296,7 @@ end
 --------------------------------------------------------------------------------
 local function output_character_ranges(out, tag, indexed, filtered)
     -- Declaration.
-    out:write("\nstatic const struct interval " .. tag .. "[] = {\n\n")
+    out:write("\ninline constexpr struct interval " .. tag .. "[] = {\n\n")
 
     -- Build sorted array of characters.
     local chars = {}
@@ -170,6 +332,58 @@ local function output_character_ranges(out, tag, indexed, filtered)
     return chars, count_ranges
 end
 
+--------------------------------------------------------------------------------
+-- The emoji versions that can be selected at runtime, newest first.  The
+-- newest must be the version of emoji-test.txt.
+local emoji_versions = { "15.0", "14.0", "13.1", "13.0", "12.1", "12.0", "11.0" }
+
+--------------------------------------------------------------------------------
+local function output_emoji_versions(out, indexed, filtered)
+    -- The version of each emoji character is the oldest version of any of
+    -- the lines that begin with it.
+    local versions = {}
+    for d, t in pairs(indexed) do
+        if not filtered[d] then
+            for _, e in ipairs(t) do
+                local v = e[2] and tonumber(e[2]:match("^E(%d+%.%d+) "))
+                if v and (not versions[d] or v < versions[d]) then
+                    versions[d] = v
+                end
+            end
+        end
+    end
+
+    -- Output ranges of the emoji characters added in each version, compared
+    -- to the next older version.  The table for an older version is the
+    -- emojis table minus the characters added in each newer version.
+    local tags = {}
+    for i = 1, #emoji_versions - 1 do
+        local newer = tonumber(emoji_versions[i])
+        local older = tonumber(emoji_versions[i + 1])
+        local added = {}
+        for d, v in pairs(versions) do
+            if v > older and v <= newer then
+                added[d] = true
+            end
+        end
+        if next(added) then
+            tags[i] = "emojis_" .. emoji_versions[i]:gsub("%.", "_")
+            output_character_ranges(out, tags[i], added)
+        end
+    end
+
+    out:write("\ninline constexpr struct emoji_version emoji_versions[] = {\n\n")
+    for i, version in ipairs(emoji_versions) do
+        local number = version:gsub("%.", "")
+        if tags[i] then
+            out:write(string.format("{ %s, %s, _countof(%s) },\n", number, tags[i], tags[i]))
+        else
+            out:write(string.format("{ %s, nullptr, 0 },\n", number))
+        end
+    end
+    out:write("\n};\n")
+end
+
 --------------------------------------------------------------------------------
 local function output_emoji_forms(out, tag, indexed, possible_unqualified_half_width, filtered)
     local forms = {}
@@ -193,23 +407,42 @@ local function output_emoji_forms(out, tag, indexed, possible_unqualified_half_w
     out:write("\nstatic const emoji_form_sequence " .. tag .. "[] = {\n\n")
 
     local count = 0
+    local ucs_keys = {}
+    local seq_keys = {}
+    local ucs_first = {}
     for ucs, t in spairs(forms) do
+        local first = count
         for _, form in ipairs(t) do
             local seq = ""
+            local bytes = {}
             for x in string.gmatch(form[1], "[0-9A-Fa-f]+") do
-                seq = seq .. utf32to8(tonumber(x, 16))
+                local d = tonumber(x, 16)
+                seq = seq .. utf32to8(d)
+                for _, b in ipairs(utf32to8_bytes(d)) do
+                    table.insert(bytes, b)
+                end
             end
             if form[2] then
                 out:write(string.format("{ 0x%X, \"%s\", \"%s\" },\n", ucs, seq, form[2]:upper()))
             else
                 out:write(string.format("{ 0x%X, \"%s\" },\n", ucs, seq))
             end
+            table.insert(seq_keys, bytes)
             count = count + 1
         end
+        -- Base codepoints are keyed by their 3 low-order bytes.
+        table.insert(ucs_keys, { bit32.band(ucs, 0xff), bit32.band(bit32.rshift(ucs, 8), 0xff), bit32.rshift(ucs, 16) })
+        table.insert(ucs_first, first)
     end
 
     out:write("\n};\n")
 
+    -- Perfect hashes for looking up the first form for a base codepoint, and
+    -- for looking up a form by its exact UTF-8 sequence.  The base codepoint
+    -- index maps to the index of the first form in emoji_forms.
+    output_perfect_hash(out, "emoji_forms_ucs", ucs_keys, ucs_first)
+    output_perfect_hash(out, "emoji_forms_seq", seq_keys)
+
     return count
 end
 
@@ -272,14 +505,49 @@ local function do_emojis()
     -- Output ranges of emoji characters which may be half-width if unqualified.
     local half_width = output_character_ranges(out, "possible_unqualified_half_width", possible_unqualified_half_width, nil)
 
+    -- Output the emoji characters added in each older emoji version.
+    output_emoji_versions(out, indexed, filtered)
+
     out:close()
 
     print("   " .. #emojis .. " emojis; " .. count_ranges .. " ranges")
     print("   " .. #half_width .. " possible unqualified half width emojis")
+    print("   " .. #emoji_versions .. " emoji versions; oldest is " .. emoji_versions[#emoji_versions])
 
     do_emoji_forms(header, indexed, possible_unqualified_half_width, filtered)
 end
 
+--------------------------------------------------------------------------------
+-- Writes the names in a sidecar file instead of in assigned-codepoints.i, so
+-- that wcwv doesn't page them in (or relocate a pointer per name) at startup.
+-- The layout matches names_file_header in codepoint_names.cpp.
+local function output_names_file(name, names, checksum)
+    local file = io.open(name, "wb")
+
+    local header_size = 28
+    local offsets_offset = header_size
+    local names_offset = offsets_offset + 4 * #names
+
+    local offsets = {}
+    local names_size = 0
+    for _,n in ipairs(names) do
+        table.insert(offsets, string.pack("<I4", names_size))
+        names_size = names_size + #n + 1
+    end
+
+    file:write("WCWN")
+    file:write(string.pack("<I4I4I4I4I4I4", 1, #names, checksum, offsets_offset, names_offset, names_size))
+    file:write(table.concat(offsets))
+    for _,n in ipairs(names) do
+        file:write(n)
+        file:write("\0")
+    end
+
+    file:close()
+
+    print("   " .. (names_offset + names_size) .. " bytes in " .. name)
+end
+
 --------------------------------------------------------------------------------
 local function do_assigned()
     local out = "assigned-codepoints.i"
@@ -292,17 +560,18 @@ local function do_assigned()
     local header = {
         "// Generated from UnicodeData.txt by 'premake5 tables'.",
         "",
-        "struct codepoint {",
-        "    char32_t ucs;",
+        "struct codepoint_range {",
+        "    char32_t first;",
+        "    char32_t last;",
         "    const char* desc;",
         "};",
         "",
-        "struct codepoint_range {",
+        "struct codepoint_interval {",
         "    char32_t first;",
         "    char32_t last;",
-        "    const char* desc;",
         "};",
         "",
+        "// The names are in codepoint-names.bin, in the same order.",
     }
 
     for _,line in ipairs(header) do
@@ -310,12 +579,15 @@ local function do_assigned()
         out:write("\n")
     end
 
-    out:write("static const struct codepoint c_assigned[] = {\n\n")
+    out:write("static const char32_t c_assigned[] = {\n\n")
 
     local lineno = 0
     local assigned = 0
     local area, first
     local first_last_ranges = {}
+    local names = {}
+    local ideographs = {}
+    local checksum = 0
     for line in data:lines() do
         lineno = lineno + 1
         local codepoint,description = line:match("^(%x+);([^;]*);")
@@ -336,13 +608,34 @@ local function do_assigned()
             end
             area = nil
         elseif description ~= "<control>" then
-            out:write(string.format("{0x%s,\"%s\"},\n", codepoint, escape_cpp(description)))
+            local ucs = tonumber(codepoint, 16)
+            out:write(string.format("0x%s, // %s\n", codepoint, description))
+            table.insert(names, description)
+            checksum = (checksum * 31 + ucs) % 0x100000000
+            if description:find("IDEOGRAPH") then
+                local last = ideographs[#ideographs]
+                if last and last[2] + 1 == ucs then
+                    last[2] = ucs
+                else
+                    table.insert(ideographs, {ucs,ucs})
+                end
+            end
             assigned = assigned + 1
         end
     end
 
     out:write("\n};\n\n")
 
+    out:write(string.format("static const uint32 c_assigned_checksum = 0x%08X;\n\n", checksum))
+
+    -- Codepoints whose names say they're ideographs, so that finding them
+    -- doesn't need the names.
+    out:write("static const struct codepoint_interval c_named_ideographs[] = {\n\n")
+    for _,r in ipairs(ideographs) do
+        out:write(string.format("{0x%04X,0x%04X},\n", r[1], r[2]))
+    end
+    out:write("\n};\n\n")
+
     for i,r in ipairs(first_last_ranges) do
         out:write(string.format("static const codepoint_range c_%s = {0x%X,0x%X,\"%s\"};\n", to_symbol_cpp(r[3]), r[1], r[2], r[3]))
     end
@@ -356,6 +649,8 @@ local function do_assigned()
     out:close()
 
     print("   " .. assigned .." assigned codepoints (not including various large First..Last ranges)")
+
+    output_names_file("codepoint-names.bin", names, checksum)
 end
 
 --------------------------------------------------------------------------------
@@ -405,6 +700,12 @@ local function do_blocks()
     out:close()
 end
 
+--------------------------------------------------------------------------------
+newoption {
+    trigger = "no-embedded-names",
+    description = "Leave the codepoint names out of wcwv.exe; they're loaded from codepoint-names.bin next to it",
+}
+
 --------------------------------------------------------------------------------
 newaction {
     trigger = "tables",
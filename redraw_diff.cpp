@@ -0,0 +1,151 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "redraw_diff.h"
+
+// Blocks are compared with memcmp first, and then the block that differs is
+// compared byte by byte.
+static const uint32 c_compare_block = 64;
+
+//------------------------------------------------------------------------------
+static uint32 common_prefix_len(const char* a, const char* b, uint32 len)
+{
+    uint32 i = 0;
+    while (len - i >= c_compare_block && memcmp(a + i, b + i, c_compare_block) == 0)
+        i += c_compare_block;
+    while (i < len && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// Same as common_prefix_len(), but from the ends of a and b backwards.
+static uint32 common_suffix_len(const char* a_end, const char* b_end, uint32 len)
+{
+    uint32 i = 0;
+    while (len - i >= c_compare_block && memcmp(a_end - i - c_compare_block, b_end - i - c_compare_block, c_compare_block) == 0)
+        i += c_compare_block;
+    while (i < len && a_end[-1 - int32(i)] == b_end[-1 - int32(i)])
+        ++i;
+    return i;
+}
+
+//------------------------------------------------------------------------------
+struct tail_boundary
+{
+    uint32          from_end;               // Bytes from the boundary to the end of the line.
+    uint32          width;                  // Columns from the beginning of the span to the boundary.
+};
+
+//------------------------------------------------------------------------------
+// Iterates the clusters from begin (which must be a cluster boundary) to the
+// end of the line, and collects the boundaries that are within tail_len bytes
+// of the end.  Returns the total width.
+static uint32 collect_tail_boundaries(const char* begin, const char* end, uint32 tail_len, const wcwidth_profile* profile, std::vector<tail_boundary>& boundaries)
+{
+    uint32 width = 0;
+    wcwidth_iter iter(begin, int32(end - begin), profile);
+    while (true)
+    {
+        const uint32 from_end = uint32(end - iter.get_pointer());
+        if (from_end <= tail_len)
+            boundaries.push_back({ from_end, width });
+        if (!iter.next())
+            break;
+        width += iter.character_wcwidth_onectrl();
+    }
+    return width;
+}
+
+//------------------------------------------------------------------------------
+bool find_redraw_span(const char* old_line, uint32 old_len, const char* new_line, uint32 new_len, redraw_span& span, const wcwidth_profile* profile)
+{
+    // Use the same profile for every iterator, even if another thread
+    // activates a different one meanwhile.
+    wcwidth_reader_scope reader;
+    if (!profile)
+        profile = get_wcwidth_profile();
+
+    const uint32 prefix_len = common_prefix_len(old_line, new_line, min(old_len, new_len));
+    if (prefix_len == old_len && prefix_len == new_len)
+        return false;
+
+    // Walk the clusters of both lines in step.  A cluster is common to both
+    // lines if it has the same length in both and lies within the common
+    // bytes; the first one that differs (even if it only became longer)
+    // begins the span.
+    uint32 column = 0;
+    const char* old_mid = old_line;
+    const char* new_mid = new_line;
+    {
+        wcwidth_iter old_iter(old_line, old_len, profile);
+        wcwidth_iter new_iter(new_line, new_len, profile);
+        while (old_iter.next() && new_iter.next())
+        {
+            if (old_iter.character_length() != new_iter.character_length() ||
+                uint32(old_iter.get_pointer() - old_line) > prefix_len)
+                break;
+            column += old_iter.character_wcwidth_onectrl();
+            old_mid = old_iter.get_pointer();
+            new_mid = new_iter.get_pointer();
+        }
+    }
+
+    // The span ends at the earliest position within the common bytes at the
+    // end that is a cluster boundary in both lines; from there on, both lines
+    // have the same clusters.  Iterating forward from the beginning of the
+    // span finds the boundaries (and the widths up to each one) in one pass.
+    const char* const old_end = old_line + old_len;
+    const char* const new_end = new_line + new_len;
+    const uint32 suffix_len = common_suffix_len(old_end, new_end, uint32(min(old_end - old_mid, new_end - new_mid)));
+
+    std::vector<tail_boundary> old_tail;
+    std::vector<tail_boundary> new_tail;
+    const uint32 old_width = collect_tail_boundaries(old_mid, old_end, suffix_len, profile, old_tail);
+    const uint32 new_width = collect_tail_boundaries(new_mid, new_end, suffix_len, profile, new_tail);
+
+    // Both lists are in order of decreasing distance from the end.
+    tail_boundary old_split = { 0, old_width };
+    tail_boundary new_split = { 0, new_width };
+    for (size_t i = 0, j = 0; i < old_tail.size() && j < new_tail.size();)
+    {
+        if (old_tail[i].from_end > new_tail[j].from_end)
+            ++i;
+        else if (old_tail[i].from_end < new_tail[j].from_end)
+            ++j;
+        else
+        {
+            old_split = old_tail[i];
+            new_split = new_tail[j];
+            break;
+        }
+    }
+
+    const uint32 suffix_columns = old_width - old_split.width;
+    const char* const old_tail_ptr = old_end - old_split.from_end;
+    const char* const new_tail_ptr = new_end - new_split.from_end;
+
+    span.column = column;
+    span.old_columns = old_split.width;
+    span.new_columns = new_split.width;
+    span.old_begin = uint32(old_mid - old_line);
+    span.new_begin = uint32(new_mid - new_line);
+
+    if (span.old_columns == span.new_columns)
+    {
+        span.old_end = uint32(old_tail_ptr - old_line);
+        span.new_end = uint32(new_tail_ptr - new_line);
+    }
+    else
+    {
+        span.old_columns += suffix_columns;
+        span.new_columns += suffix_columns;
+        span.old_end = old_len;
+        span.new_end = new_len;
+    }
+
+    return true;
+}
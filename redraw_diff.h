@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+struct wcwidth_profile;
+
+//------------------------------------------------------------------------------
+// The part of a line that needs to be repainted when it changes.  Columns are
+// counted from the beginning of the line, and byte offsets are relative to the
+// beginning of each line.
+struct redraw_span
+{
+    uint32          column;                 // First column to repaint.
+    uint32          old_columns;            // Columns the span occupied in the old line.
+    uint32          new_columns;            // Columns the span occupies in the new line.
+    uint32          old_begin;              // Bytes of the span in the old line.
+    uint32          old_end;
+    uint32          new_begin;              // Bytes of the span in the new line.
+    uint32          new_end;
+};
+
+//------------------------------------------------------------------------------
+// Finds the smallest span of columns to repaint to change the old line into
+// the new line.  Returns false if the lines are identical.
+//
+// The span begins after the clusters the lines have in common at the
+// beginning, and ends before the clusters they have in common at the end; the
+// comparison is always on cluster boundaries, so a combining mark or emoji
+// modifier added to an unchanged character repaints that character.  If the
+// changed part has a different width in the new line, the rest of the line
+// shifts, so the span extends to the end of both lines; then when old_columns
+// is greater than new_columns, the caller must also erase the leftover
+// columns.
+//
+// Widths are the same as wcswidth().  The lines must be valid UTF-8 and must
+// not contain NUL.  When profile is nullptr, the active profile is used.
+bool find_redraw_span(const char* old_line, uint32 old_len, const char* new_line, uint32 new_len, redraw_span& span, const wcwidth_profile* profile=nullptr);
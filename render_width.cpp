@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "render_width.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define USE_SSE2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//------------------------------------------------------------------------------
+// Returns a pointer to the first byte that isn't printable ASCII (a control
+// character, DEL, or part of a UTF-8 sequence), or end if there is none.
+static const char* find_special_byte(const char* p, const char* end)
+{
+#ifdef USE_SSE2
+    // Bytes 0x80 and above are negative as signed chars, so one signed
+    // compare finds both control characters and non-ASCII bytes.
+    const __m128i space = _mm_set1_epi8(0x20);
+    const __m128i del = _mm_set1_epi8(0x7f);
+    while (end - p >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i special = _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, del));
+        const uint32 mask = uint32(_mm_movemask_epi8(special));
+        if (mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return p + index;
+#else
+            return p + __builtin_ctz(mask);
+#endif
+        }
+        p += 16;
+    }
+#endif
+
+    for (; p < end; ++p)
+    {
+        const uint8 c = uint8(*p);
+        if (c < 0x20 || c >= 0x7f)
+            break;
+    }
+    return p;
+}
+
+//------------------------------------------------------------------------------
+static uint32 hex_width(char32_t c)
+{
+    uint32 digits = 2;
+    for (c >>= 8; c; c >>= 4)
+        ++digits;
+    return digits + 2;
+}
+
+//------------------------------------------------------------------------------
+static uint32 control_width(char32_t c, uint32 column, const render_options& options)
+{
+    if (c == '\t' && options.tab_width)
+        return options.tab_width - (column % options.tab_width);
+
+    switch (options.controls)
+    {
+    case render_control::caret:
+        if (c < 0x20 || c == 0x7f)
+            return 2;
+        return hex_width(c);
+    case render_control::hex:
+        return hex_width(c);
+    default:
+        return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32 render_width(const char* s, uint32 len, const render_options& options, const wcwidth_profile* profile)
+{
+    const char* const end = s + len;
+    uint32 column = options.start_column;
+
+    wcwidth_iter iter(s, len, profile);
+    while (true)
+    {
+        // Each printable ASCII byte is one column.  But the last one before a
+        // non-ASCII byte is left for the iterator, because it can begin a
+        // cluster (such as a combining mark or a keycap sequence).
+        const char* const p = iter.get_pointer();
+        const char* run_end = find_special_byte(p, end);
+        if (run_end < end && uint8(*run_end) >= 0x80 && run_end > p)
+            --run_end;
+        if (run_end > p)
+        {
+            column += uint32(run_end - p);
+            iter.reset_pointer(run_end);
+        }
+
+        const char32_t c = iter.next();
+        if (!c)
+            break;
+
+        const int32 w = iter.character_wcwidth_signed();
+        column += (w >= 0) ? w : control_width(c, column, options);
+    }
+
+    return column - options.start_column;
+}
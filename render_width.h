@@ -0,0 +1,37 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+struct wcwidth_profile;
+
+//------------------------------------------------------------------------------
+// How control characters are displayed.
+enum class render_control : uint8
+{
+    zero,               // Not displayed; 0 columns.
+    caret,              // ^X notation for C0 controls and DEL (2 columns), and
+                        // hex notation for any other control characters.
+    hex,                // <XX> notation (4 columns, or more for codepoints
+                        // above U+FF).
+};
+
+struct render_options
+{
+    uint32          start_column = 0;       // Column where the text starts.
+    uint32          tab_width = 8;          // 0 means TAB is just a control character.
+    render_control  controls = render_control::caret;
+};
+
+//------------------------------------------------------------------------------
+// Returns how many columns the text occupies when displayed starting at
+// options.start_column:  TAB advances to the next tab stop (tab stops are
+// every tab_width columns, counting from column 0), other control characters
+// are displayed according to options.controls, and everything else has the
+// same width as in wcswidth().  A NUL ends the text.
+//
+// This is a single pass over the text.  Runs of printable ASCII are found
+// with a vectorized search for control and non-ASCII bytes, and only the rest
+// of the text goes through wcwidth_iter.  When profile is nullptr, the active
+// profile is used.
+uint32 render_width(const char* s, uint32 len, const render_options& options, const wcwidth_profile* profile=nullptr);
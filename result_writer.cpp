@@ -0,0 +1,366 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "result_writer.h"
+
+static const uint32 c_buffer_size = 1024 * 1024;
+static const uint32 c_buffer_count = 4;
+static const uint32 c_max_record_len = 1024;
+static const uint32 c_max_quoted_len = 128;
+
+//------------------------------------------------------------------------------
+bool parse_result_format(const char* name, result_format& format)
+{
+    if (strcmp(name, "jsonl") == 0)
+        format = result_format::jsonl;
+    else if (strcmp(name, "csv") == 0)
+        format = result_format::csv;
+    else if (strcmp(name, "bin") == 0)
+        format = result_format::bin;
+    else
+        return false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static char* append_codepoints(char* p, char32_t ucs, const char* seq)
+{
+    if (!seq)
+        return p + sprintf(p, "%04X", uint32(ucs));
+
+    str_iter iter(seq);
+    while (iter.more())
+    {
+        if (iter.get_pointer() > seq)
+            *(p++) = ' ';
+        p += sprintf(p, "%04X", iter.next());
+    }
+    return p;
+}
+
+//------------------------------------------------------------------------------
+uint32 escape_json_char(char c, char* out)
+{
+    static const char c_hex[] = "0123456789abcdef";
+
+    if (c == '"' || c == '\\')
+    {
+        out[0] = '\\';
+        out[1] = c;
+        return 2;
+    }
+
+    if (uint8(c) < 0x20)
+    {
+        memcpy(out, "\\u00", 4);
+        out[4] = c_hex[uint8(c) >> 4];
+        out[5] = c_hex[uint8(c) & 0xf];
+        return 6;
+    }
+
+    out[0] = c;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// Appends text quoted for the output format.  Block descriptions come from
+// Blocks.txt and are short, but the quoted length is capped regardless so a
+// record always fits in c_max_record_len.
+static char* append_quoted(char* p, const char* text, result_format format)
+{
+    char* const end = p + 1 + c_max_quoted_len;
+    *(p++) = '"';
+    for (; text && *text; ++text)
+    {
+        // CSV only needs to double the quotes.
+        char escaped[6];
+        uint32 len;
+        if (format == result_format::jsonl)
+            len = escape_json_char(*text, escaped);
+        else
+        {
+            len = (*text == '"') ? 2 : 1;
+            escaped[0] = escaped[1] = *text;
+        }
+
+        if (p + len > end)
+            break;
+        memcpy(p, escaped, len);
+        p += len;
+    }
+    *(p++) = '"';
+    return p;
+}
+
+//------------------------------------------------------------------------------
+result_writer::~result_writer()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+bool result_writer::open(const char* path, result_format format)
+{
+    assert(!m_file);
+    assert(format != result_format::none);
+
+    m_file = fopen(path, (format == result_format::bin) ? "wb" : "w");
+    if (!m_file)
+        return false;
+
+    m_format = format;
+    m_closing = false;
+    m_failed = false;
+    m_buffers.resize(c_buffer_count);
+    for (buffer& b : m_buffers)
+    {
+        b.data = static_cast<char*>(malloc(c_buffer_size));
+        b.used = 0;
+        if (!b.data)
+        {
+            for (buffer& f : m_buffers)
+                free(f.data);
+            m_buffers.clear();
+            m_empty.clear();
+            fclose(m_file);
+            m_file = nullptr;
+            return false;
+        }
+        m_empty.push_back(&b);
+    }
+    m_current = m_empty.back();
+    m_empty.pop_back();
+
+    m_thread = std::thread([this](){ writer_thread(); });
+
+    switch (m_format)
+    {
+    case result_format::csv:
+        {
+            static const char c_header[] = "kind,ucs,seq,block,expected,actual,suffix_effect,ok,time_us\n";
+            memcpy(reserve(sizeof(c_header) - 1), c_header, sizeof(c_header) - 1);
+            m_current->used += sizeof(c_header) - 1;
+        }
+        break;
+    case result_format::bin:
+        {
+            char* p = reserve(8);
+            memcpy(p, c_result_bin_magic, 4);
+            memcpy(p + 4, &c_result_bin_version, 4);
+            m_current->used += 8;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool result_writer::close()
+{
+    if (!m_file)
+        return true;
+
+    submit();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closing = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+
+    const bool ok = !m_failed && !ferror(m_file);
+    fclose(m_file);
+    m_file = nullptr;
+
+    for (buffer& b : m_buffers)
+        free(b.data);
+    m_buffers.clear();
+    m_empty.clear();
+    m_full.clear();
+    m_current = nullptr;
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+void result_writer::write(const result_record& record)
+{
+    assert(m_file);
+
+    const bool ok = (record.actual == record.expected) && !record.suffix_effect;
+    char* const begin = reserve(c_max_record_len);
+    char* p = begin;
+
+    switch (m_format)
+    {
+    case result_format::jsonl:
+        p += sprintf(p, "{\"kind\":\"%s\",\"ucs\":\"%04X\",\"seq\":\"", record.seq ? "sequence" : "codepoint", uint32(record.ucs));
+        p = append_codepoints(p, record.ucs, record.seq);
+        p += sprintf(p, "\",\"block\":");
+        p = append_quoted(p, record.block, m_format);
+        p += sprintf(p, ",\"expected\":%d,\"actual\":%d,\"suffix_effect\":%s,\"ok\":%s,\"time_us\":%u.%03u}\n",
+                     record.expected, record.actual, record.suffix_effect ? "true" : "false", ok ? "true" : "false",
+                     record.elapsed_ns / 1000, record.elapsed_ns % 1000);
+        break;
+
+    case result_format::csv:
+        p += sprintf(p, "%s,%04X,", record.seq ? "sequence" : "codepoint", uint32(record.ucs));
+        p = append_codepoints(p, record.ucs, record.seq);
+        *(p++) = ',';
+        p = append_quoted(p, record.block, m_format);
+        p += sprintf(p, ",%d,%d,%d,%d,%u.%03u\n",
+                     record.expected, record.actual, record.suffix_effect, ok,
+                     record.elapsed_ns / 1000, record.elapsed_ns % 1000);
+        break;
+
+    case result_format::bin:
+        {
+            const uint32 seq_len = record.seq ? min<uint32>(uint32(strlen(record.seq)), 255) : 0;
+            const uint32 fields[] = { uint32(record.ucs), uint32(record.block_first), record.elapsed_ns };
+            memcpy(p, fields, sizeof(fields));
+            p += sizeof(fields);
+            *(p++) = char(int8(record.expected));
+            *(p++) = char(int8(record.actual));
+            *(p++) = char((record.seq ? result_bin_sequence : 0) |
+                          (record.suffix_effect ? result_bin_suffix_effect : 0) |
+                          (ok ? result_bin_ok : 0));
+            *(p++) = char(seq_len);
+            memcpy(p, record.seq, seq_len);
+            p += seq_len;
+        }
+        break;
+
+    default:
+        assert(false);
+        break;
+    }
+
+    assert(p - begin <= c_max_record_len);
+    m_current->used += uint32(p - begin);
+}
+
+//------------------------------------------------------------------------------
+// Returns a pointer to at least len free bytes in the current buffer.  When
+// the current buffer is too full, it's handed off to the writer thread.
+char* result_writer::reserve(uint32 len)
+{
+    assert(len <= c_buffer_size);
+    if (m_current->used + len > c_buffer_size)
+        submit();
+    return m_current->data + m_current->used;
+}
+
+//------------------------------------------------------------------------------
+void result_writer::submit()
+{
+    if (!m_current->used)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_full.insert(m_full.begin(), m_current);
+    m_cv.notify_all();
+
+    // This only waits if the writer thread has fallen behind by all of the
+    // buffers.
+    m_cv.wait(lock, [this](){ return !m_empty.empty(); });
+    m_current = m_empty.back();
+    m_empty.pop_back();
+    m_current->used = 0;
+}
+
+//------------------------------------------------------------------------------
+void result_writer::writer_thread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this](){ return m_closing || !m_full.empty(); });
+        if (m_full.empty())
+            break;
+
+        buffer* b = m_full.back();
+        m_full.pop_back();
+
+        lock.unlock();
+        if (fwrite(b->data, 1, b->used, m_file) != b->used)
+            m_failed = true;
+        lock.lock();
+
+        m_empty.push_back(b);
+        m_cv.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool result_reader::open(const char* path)
+{
+    m_records.clear();
+    m_strings.clear();
+
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    std::vector<char> data;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        const long size = ftell(file);
+        if (size > 0 && fseek(file, 0, SEEK_SET) == 0)
+        {
+            data.resize(size);
+            if (fread(data.data(), 1, data.size(), file) != data.size())
+                data.clear();
+        }
+    }
+    fclose(file);
+
+    if (data.size() < 8 || memcmp(data.data(), c_result_bin_magic, 4) != 0)
+        return false;
+    uint32 version;
+    memcpy(&version, data.data() + 4, 4);
+    if (version != c_result_bin_version)
+        return false;
+
+    // Each record takes more bytes in the file than its NUL terminated seq
+    // string does, so this never reallocates (which would invalidate the seq
+    // pointers).
+    m_strings.reserve(data.size());
+
+    const uint32 c_fixed_len = 16;
+    const char* p = data.data() + 8;
+    const char* const end = data.data() + data.size();
+    while (p < end)
+    {
+        if (uint32(end - p) < c_fixed_len)
+            return false;
+
+        uint32 fields[3];
+        memcpy(fields, p, sizeof(fields));
+        const uint8 flags = uint8(p[14]);
+        const uint32 seq_len = uint8(p[15]);
+        if (uint32(end - p) < c_fixed_len + seq_len)
+            return false;
+
+        result_record record;
+        record.ucs = char32_t(fields[0]);
+        record.block_first = char32_t(fields[1]);
+        record.elapsed_ns = fields[2];
+        record.expected = int8(p[12]);
+        record.actual = int8(p[13]);
+        record.suffix_effect = !!(flags & result_bin_suffix_effect);
+        if (flags & result_bin_sequence)
+        {
+            record.seq = m_strings.data() + m_strings.size();
+            m_strings.insert(m_strings.end(), p + c_fixed_len, p + c_fixed_len + seq_len);
+            m_strings.push_back('\0');
+        }
+        m_records.push_back(record);
+
+        p += c_fixed_len + seq_len;
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//------------------------------------------------------------------------------
+enum class result_format { none, jsonl, csv, bin };
+
+bool parse_result_format(const char* name, result_format& format);
+
+// Writes c to out the way it must appear inside a JSON string, and returns
+// the number of bytes written (at most 6).  Control characters are written as
+// \u00XX escapes.
+uint32 escape_json_char(char c, char* out);
+
+//------------------------------------------------------------------------------
+// One measurement.  For a sequence, ucs is the base codepoint and seq is the
+// UTF-8 sequence; for a single codepoint, seq is nullptr.
+struct result_record
+{
+    char32_t        ucs = 0;
+    const char*     seq = nullptr;
+    const char*     block = nullptr;
+    char32_t        block_first = 0;
+    int32           expected = 0;
+    int32           actual = 0;
+    bool            suffix_effect = false;
+    uint32          elapsed_ns = 0;
+};
+
+//------------------------------------------------------------------------------
+// The binary format is little-endian:  an 8 byte header ("WCWR" followed by a
+// uint32 version), then one record per measurement:
+//
+//      uint32  ucs
+//      uint32  block_first
+//      uint32  elapsed_ns
+//      int8    expected
+//      int8    actual
+//      uint8   flags           (result_bin_flags)
+//      uint8   seq_len         (0 for a single codepoint)
+//      char    seq[seq_len]    (UTF-8 sequence)
+enum result_bin_flags : uint8
+{
+    result_bin_sequence         = 0x01,
+    result_bin_suffix_effect    = 0x02,
+    result_bin_ok               = 0x04,
+};
+
+static const char c_result_bin_magic[4] = { 'W', 'C', 'W', 'R' };
+static const uint32 c_result_bin_version = 1;
+
+//------------------------------------------------------------------------------
+// Formats records into large buffers, and writes the buffers to the output
+// file on a background thread so that file I/O doesn't interleave with (or
+// skew the timing of) measurements.
+class result_writer
+{
+public:
+                    result_writer() = default;
+                    ~result_writer();
+    bool            open(const char* path, result_format format);
+    bool            close();
+    bool            is_open() const { return !!m_file; }
+    void            write(const result_record& record);
+
+private:
+    struct buffer
+    {
+        char*       data;
+        uint32      used;
+    };
+
+    char*           reserve(uint32 len);
+    void            submit();
+    void            writer_thread();
+
+    FILE*           m_file = nullptr;
+    result_format   m_format = result_format::none;
+    buffer*         m_current = nullptr;
+    std::vector<buffer*> m_empty;
+    std::vector<buffer*> m_full;
+    std::vector<buffer> m_buffers;
+    std::thread     m_thread;
+    std::mutex      m_mutex;
+    std::condition_variable m_cv;
+    bool            m_closing = false;
+    bool            m_failed = false;
+};
+
+//------------------------------------------------------------------------------
+// Reads a file written in the bin format.  The seq strings in the records
+// point into the reader, so they're only valid while the reader exists.
+// Block descriptions aren't stored in the bin format, so block is nullptr.
+class result_reader
+{
+public:
+    bool            open(const char* path);
+    const std::vector<result_record>& records() const { return m_records; }
+
+private:
+    std::vector<char> m_strings;
+    std::vector<result_record> m_records;
+};
@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Bounded queue between exactly one producer thread and one consumer thread.
+// Pushing and popping are lock-free; push() only blocks when the queue is
+// full, and pop() only blocks when it's empty, by waiting on the other side's
+// index.  Each side only wakes the other side when it might be waiting, so
+// that a steady stream of items doesn't cost a wake per item.  A producer
+// waiting for a full queue isn't woken until the queue is half empty, so that
+// the two threads don't take turns one item at a time.
+template <class T>
+class spsc_queue
+{
+public:
+    // The capacity is rounded up to a power of two.
+    explicit        spsc_queue(uint32 capacity);
+
+    void            push(const T& item);
+    void            pop(T& item);
+
+private:
+    std::vector<T>  m_items;
+    uint32          m_mask;
+    alignas(64) std::atomic<uint32> m_head = 0;     // Next to pop; only the consumer writes it.
+    alignas(64) std::atomic<uint32> m_tail = 0;     // Next to push; only the producer writes it.
+};
+
+//------------------------------------------------------------------------------
+template <class T>
+spsc_queue<T>::spsc_queue(uint32 capacity)
+{
+    uint32 size = 1;
+    while (size < capacity)
+        size <<= 1;
+    m_items.resize(size);
+    m_mask = size - 1;
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void spsc_queue<T>::push(const T& item)
+{
+    const uint32 tail = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const uint32 head = m_head.load(std::memory_order_acquire);
+        if (tail - head <= m_mask)
+            break;
+        m_head.wait(head, std::memory_order_acquire);
+    }
+
+    m_items[tail & m_mask] = item;
+    m_tail.store(tail + 1);
+
+    // The consumer can only be waiting if the queue was empty.
+    if (m_head.load() == tail)
+        m_tail.notify_one();
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void spsc_queue<T>::pop(T& item)
+{
+    const uint32 head = m_head.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const uint32 tail = m_tail.load(std::memory_order_acquire);
+        if (tail != head)
+            break;
+        m_tail.wait(tail, std::memory_order_acquire);
+    }
+
+    item = m_items[head & m_mask];
+    m_head.store(head + 1);
+
+    // The producer can only be waiting if the queue was full, and it was
+    // full until at least half of the items were popped.
+    if (m_tail.load() - (head + 1) == (m_mask + 1) / 2)
+        m_head.notify_one();
+}
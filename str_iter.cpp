@@ -19,6 +19,8 @@ int32 str_iter_impl<char>::next()
         if (encode_length)
         {
             --encode_length;
+            if (!more())
+                break;
             continue;
         }
 
@@ -87,3 +89,33 @@ uint32 str_iter_impl<wchar_t>::length() const
 {
     return (uint32)((m_ptr <= m_end) ? m_end - m_ptr : wcslen(m_ptr));
 }
+
+//------------------------------------------------------------------------------
+uint32 to_utf8(char32_t ucs, char* out)
+{
+    uint32 n = 0;
+    if (ucs < 0x80)
+    {
+        out[n++] = char(ucs);
+    }
+    else if (ucs < 0x800)
+    {
+        out[n++] = char(0xc0 | (ucs >> 6));
+        out[n++] = char(0x80 | (ucs & 0x3f));
+    }
+    else if (ucs < 0x10000)
+    {
+        out[n++] = char(0xe0 | (ucs >> 12));
+        out[n++] = char(0x80 | ((ucs >> 6) & 0x3f));
+        out[n++] = char(0x80 | (ucs & 0x3f));
+    }
+    else
+    {
+        out[n++] = char(0xf0 | (ucs >> 18));
+        out[n++] = char(0x80 | ((ucs >> 12) & 0x3f));
+        out[n++] = char(0x80 | ((ucs >> 6) & 0x3f));
+        out[n++] = char(0x80 | (ucs & 0x3f));
+    }
+    out[n] = '\0';
+    return n;
+}
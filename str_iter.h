@@ -90,3 +90,10 @@ template <typename T> bool str_iter_impl<T>::more() const
 //------------------------------------------------------------------------------
 typedef str_iter_impl<char>     str_iter;
 typedef str_iter_impl<wchar_t>  wstr_iter;
+
+
+
+//------------------------------------------------------------------------------
+// Encodes ucs as UTF-8 and NUL terminates it; out must have room for 5 bytes.
+// Returns the number of bytes, not counting the NUL terminator.
+uint32 to_utf8(char32_t ucs, char* out);
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "terminal_model.h"
+
+//------------------------------------------------------------------------------
+terminal_model::terminal_model(const wcwidth_profile* profile)
+: m_profile(profile)
+{
+}
+
+//------------------------------------------------------------------------------
+void terminal_model::set_cursor_x(uint32 x)
+{
+    m_line.clear();
+    m_origin = x;
+    m_cursor_x = x;
+}
+
+//------------------------------------------------------------------------------
+void terminal_model::write(const char* s, uint32 len)
+{
+    m_line.append(s, len);
+
+    // Move the start of m_line up to the last safe cluster boundary.  Only
+    // the bytes at the end of the old text can have become part of a
+    // different codepoint, so older boundaries were already checked.
+    const char* const line = m_line.c_str();
+    const char* const end = line + m_line.length();
+    const char* const oldest = max(line + 1, end - min<uint32>(len + 3, uint32(m_line.length())));
+    for (const char* p = end - 1; p >= oldest; --p)
+    {
+        if (is_safe_cluster_boundary(line, p, end, *m_profile))
+        {
+            m_origin += wcswidth(line, uint32(p - line), m_profile);
+            m_line.erase(0, p - line);
+            break;
+        }
+    }
+
+    m_cursor_x = m_origin + wcswidth(m_line.c_str(), uint32(m_line.length()), m_profile);
+}
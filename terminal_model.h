@@ -0,0 +1,38 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+
+struct wcwidth_profile;
+
+//------------------------------------------------------------------------------
+// A headless stand-in for a terminal, which lets the verifier run without a
+// console and as fast as the CPU allows.
+//
+// The terminal renders text according to its own width profile, which is
+// independent of the profile that predicts the expected widths.  For example,
+// a profile saved from an earlier version of the tables can be used as the
+// terminal, to catch unintended changes to the tables.
+//
+// It only tracks the cursor column.  Text written since the last safe cluster
+// boundary (see is_safe_cluster_boundary()) is kept, and each write recomputes
+// the cursor from there, so a write can join a cluster from an earlier write
+// (such as a combining mark written after its base character), like in a real
+// terminal.  Text before the boundary can't change width, so each write only
+// costs about its own length.
+class terminal_model
+{
+public:
+    explicit        terminal_model(const wcwidth_profile* profile);
+    uint32          cursor_x() const { return m_cursor_x; }
+    void            set_cursor_x(uint32 x);
+    void            write(const char* s, uint32 len);
+
+private:
+    const wcwidth_profile* const m_profile;
+    std::string     m_line;                 // Text written since the last safe cluster boundary.
+    uint32          m_origin = 0;           // Column where m_line begins.
+    uint32          m_cursor_x = 0;
+};
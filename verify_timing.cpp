@@ -0,0 +1,314 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "verify_timing.h"
+#include "column_format.h"
+#include "result_writer.h"
+
+#include <algorithm>
+
+// How often the status in the console title is updated.
+static const double c_status_interval = 0.25;
+
+static const char* const c_step_names[] =
+{
+    "prefix",
+    "glyph",
+    "query",
+    "suffix",
+    "erase",
+    "batch",
+};
+static_assert(_countof(c_step_names) == uint32(verify_step::count), "step names must match verify_step");
+
+//------------------------------------------------------------------------------
+static void print_json_string(FILE* out, const char* text)
+{
+    fputc('"', out);
+    for (; text && *text; ++text)
+    {
+        char escaped[6];
+        fwrite(escaped, 1, escape_json_char(*text, escaped), out);
+    }
+    fputc('"', out);
+}
+
+//------------------------------------------------------------------------------
+static void print_codepoints(FILE* out, char32_t ucs, const char* seq)
+{
+    if (!seq)
+    {
+        fprintf(out, "%04X", uint32(ucs));
+        return;
+    }
+
+    str_iter iter(seq);
+    while (iter.more())
+    {
+        if (iter.get_pointer() > seq)
+            fputc(' ', out);
+        fprintf(out, "%04X", iter.next());
+    }
+}
+
+//------------------------------------------------------------------------------
+static void print_histogram_json(FILE* out, const latency_histogram& h)
+{
+    fprintf(out, "{\"count\":%llu,\"total_ns\":%llu,\"min_ns\":%llu,\"mean_ns\":%.0f,\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"max_ns\":%llu,\"buckets\":[",
+            h.count(), h.total(), h.min_value(), h.mean(), h.percentile(50), h.percentile(90), h.percentile(99), h.max_value());
+
+    // Only non-empty buckets, as [upper_ns, count] pairs.
+    bool first = true;
+    for (uint32 i = 0; i < latency_histogram::c_buckets; ++i)
+    {
+        if (!h.bucket_count(i))
+            continue;
+        fprintf(out, "%s[%llu,%u]", first ? "" : ",", latency_histogram::bucket_upper(i), h.bucket_count(i));
+        first = false;
+    }
+
+    fputs("]}", out);
+}
+
+//------------------------------------------------------------------------------
+static void print_histogram_row(FILE* out, const char* name, const latency_histogram& h)
+{
+    fprintf(out, "  %-8s %9llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, h.count(),
+            h.mean() / 1000, double(h.percentile(50)) / 1000, double(h.percentile(90)) / 1000,
+            double(h.percentile(99)) / 1000, double(h.max_value()) / 1000);
+}
+
+//------------------------------------------------------------------------------
+verify_timing::verify_timing()
+{
+    QueryPerformanceFrequency(&m_freq);
+}
+
+//------------------------------------------------------------------------------
+verify_timing::~verify_timing()
+{
+    if (m_has_title)
+        SetConsoleTitleA(m_title);
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::begin_run(uint32 expected)
+{
+    m_expected = expected;
+    m_has_title = !!GetConsoleTitleA(m_title, _countof(m_title));
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    m_run_began = now.QuadPart;
+    m_last_status = 0;
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::end_run()
+{
+    end_block();
+    m_elapsed = seconds_since(m_run_began);
+
+    if (m_has_title)
+    {
+        SetConsoleTitleA(m_title);
+        m_has_title = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::begin_block(char32_t first, char32_t last, const char* desc)
+{
+    end_block();
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    m_block_began = now.QuadPart;
+
+    m_blocks.emplace_back();
+    block_timing& block = m_blocks.back();
+    block.first = first;
+    block.last = last;
+    block.desc = desc;
+    block.elapsed_ns = 0;
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::end_block()
+{
+    if (!m_blocks.empty() && m_block_began)
+    {
+        m_blocks.back().elapsed_ns = uint64(seconds_since(m_block_began) * 1e9);
+        if (!m_blocks.back().measurements.count())
+            m_blocks.pop_back();
+    }
+    m_block_began = 0;
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::record_step(verify_step step, uint64 ns)
+{
+    m_steps[uint32(step)].record(ns);
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::record_measurement(char32_t ucs, const char* seq, uint64 ns)
+{
+    ++m_measured;
+    m_measurements.record(ns);
+    if (!m_blocks.empty())
+        m_blocks.back().measurements.record(ns);
+
+    // Keep the slowest measurements sorted, slowest first.
+    if (m_slowest_count < c_max_slowest || ns > m_slowest[m_slowest_count - 1].ns)
+    {
+        uint32 i = min(m_slowest_count, c_max_slowest - 1);
+        for (; i > 0 && m_slowest[i - 1].ns < ns; --i)
+            m_slowest[i] = m_slowest[i - 1];
+        m_slowest[i] = { ucs, seq, ns };
+        m_slowest_count = min(m_slowest_count + 1, c_max_slowest);
+    }
+
+    update_status();
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::update_status()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    if (m_last_status && double(now.QuadPart - m_last_status) / double(m_freq.QuadPart) < c_status_interval)
+        return;
+    m_last_status = now.QuadPart;
+
+    const double elapsed = seconds_since(m_run_began);
+    const double rate = (elapsed > 0) ? m_measured / elapsed : 0;
+
+    char status[128];
+    if (m_expected && rate > 0)
+    {
+        const uint32 remaining = (m_measured < m_expected) ? uint32((m_expected - m_measured) / rate + 0.5) : 0;
+        sprintf(status, "wcwv:  %u of %u (%u%%), %.0f per second, %u:%02u remaining",
+                m_measured, m_expected, uint32(uint64(m_measured) * 100 / m_expected), rate,
+                remaining / 60, remaining % 60);
+    }
+    else
+    {
+        sprintf(status, "wcwv:  %u, %.0f per second", m_measured, rate);
+    }
+    SetConsoleTitleA(status);
+}
+
+//------------------------------------------------------------------------------
+double verify_timing::seconds_since(LONGLONG began) const
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return double(now.QuadPart - began) / double(m_freq.QuadPart);
+}
+
+//------------------------------------------------------------------------------
+void verify_timing::print_breakdown(FILE* out) const
+{
+    fprintf(out, "\nMeasured %u in %.3f seconds", m_measured, m_elapsed);
+    if (m_elapsed > 0)
+        fprintf(out, " (%.0f per second)", m_measured / m_elapsed);
+    fputs(".\n", out);
+
+    fprintf(out, "\n  %-8s %9s %10s %10s %10s %10s %10s\n", "step", "count", "mean us", "p50 us", "p90 us", "p99 us", "max us");
+    for (uint32 i = 0; i < uint32(verify_step::count); ++i)
+    {
+        if (m_steps[i].count())
+            print_histogram_row(out, c_step_names[i], m_steps[i]);
+    }
+    print_histogram_row(out, "total", m_measurements);
+
+    // The blocks where the measurements took the most time in total.
+    std::vector<const block_timing*> blocks;
+    for (const auto& block : m_blocks)
+        blocks.push_back(&block);
+    std::sort(blocks.begin(), blocks.end(), [](const block_timing* a, const block_timing* b) {
+        return a->measurements.total() > b->measurements.total();
+    });
+    if (blocks.size() > c_max_slowest)
+        blocks.resize(c_max_slowest);
+
+    if (!blocks.empty())
+    {
+        fputs("\nSlowest blocks:\n", out);
+        for (const block_timing* block : blocks)
+        {
+            const latency_histogram& h = block->measurements;
+            fprintf(out, "  %04X..%04X %9.1f ms total, %6llu measured, p50 %8.1f us, p99 %8.1f us",
+                    uint32(block->first), uint32(block->last), double(h.total()) / 1e6, h.count(),
+                    double(h.percentile(50)) / 1000, double(h.percentile(99)) / 1000);
+            if (block->desc)
+                fprintf(out, "  %s", block->desc);
+            fputs("\n", out);
+        }
+    }
+
+    if (m_slowest_count)
+    {
+        fputs("\nSlowest measurements:\n", out);
+        for (uint32 i = 0; i < m_slowest_count; ++i)
+        {
+            // Show the text itself as well, padded to a fixed number of
+            // columns so the codepoints line up even for wide characters.
+            char utf8[8] = {};
+            const char* text = m_slowest[i].seq;
+            if (!text && m_slowest[i].ucs >= 0x20 && m_slowest[i].ucs != 0x7f)
+                utf8[to_utf8(m_slowest[i].ucs, utf8)] = '\0';
+            column_fprintf(out, "  %10.1f us  %-4.4s  ", double(m_slowest[i].ns) / 1000, text ? text : utf8);
+            print_codepoints(out, m_slowest[i].ucs, m_slowest[i].seq);
+            fputs("\n", out);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool verify_timing::export_json(const char* path) const
+{
+    FILE* out = fopen(path, "w");
+    if (!out)
+        return false;
+
+    fprintf(out, "{\"measured\":%u,\"seconds\":%.6f,\n\"steps\":{", m_measured, m_elapsed);
+    bool first = true;
+    for (uint32 i = 0; i < uint32(verify_step::count); ++i)
+    {
+        if (!m_steps[i].count())
+            continue;
+        fprintf(out, "%s\n\"%s\":", first ? "" : ",", c_step_names[i]);
+        print_histogram_json(out, m_steps[i]);
+        first = false;
+    }
+
+    fputs("},\n\"total\":", out);
+    print_histogram_json(out, m_measurements);
+
+    fputs(",\n\"blocks\":[", out);
+    first = true;
+    for (const auto& block : m_blocks)
+    {
+        fprintf(out, "%s\n{\"first\":\"%04X\",\"last\":\"%04X\",\"desc\":", first ? "" : ",", uint32(block.first), uint32(block.last));
+        print_json_string(out, block.desc);
+        fprintf(out, ",\"elapsed_ns\":%llu,\"measurements\":", block.elapsed_ns);
+        print_histogram_json(out, block.measurements);
+        fputs("}", out);
+        first = false;
+    }
+
+    fputs("],\n\"slowest\":[", out);
+    for (uint32 i = 0; i < m_slowest_count; ++i)
+    {
+        fprintf(out, "%s\n{\"codepoints\":\"", i ? "," : "");
+        print_codepoints(out, m_slowest[i].ucs, m_slowest[i].seq);
+        fprintf(out, "\",\"ns\":%llu}", m_slowest[i].ns);
+    }
+    fputs("]}\n", out);
+
+    const bool ok = !ferror(out);
+    return (fclose(out) == 0) && ok;
+}
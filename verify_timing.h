@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "latency_histogram.h"
+
+//------------------------------------------------------------------------------
+// The steps of measuring one codepoint or sequence.
+enum class verify_step : uint8
+{
+    prefix,             // Writing the --prefix codepoint.
+    glyph,              // Writing the codepoint or sequence.
+    query,              // Getting the cursor position.
+    suffix,             // Writing the --suffix codepoint.
+    erase,              // Erasing the measurement.
+    batch,              // Measuring a whole range at once (--dsr).
+    count
+};
+
+//------------------------------------------------------------------------------
+// Collects timing for a verification run:  a histogram for each step, and
+// for the total time of the measurements in each block, plus the slowest
+// individual measurements.
+//
+// While the run is in progress, the console title shows the rate and the
+// estimated time remaining, so the status never disturbs the measurements on
+// the screen.  Afterwards, the breakdown can be printed, and exported as JSON
+// to compare runs across terminals and terminal versions.
+class verify_timing
+{
+public:
+                    verify_timing();
+                    ~verify_timing();
+    void            begin_run(uint32 expected);
+    void            end_run();
+    void            begin_block(char32_t first, char32_t last, const char* desc);
+    void            record_step(verify_step step, uint64 ns);
+    void            record_measurement(char32_t ucs, const char* seq, uint64 ns);
+    void            print_breakdown(FILE* out) const;
+    bool            export_json(const char* path) const;
+
+private:
+    struct block_timing
+    {
+        char32_t    first;
+        char32_t    last;
+        const char* desc;
+        uint64      elapsed_ns;             // Wall time in the measure stage, until the next block began.
+        latency_histogram measurements;
+    };
+
+    struct slow_measurement
+    {
+        char32_t    ucs;
+        const char* seq;
+        uint64      ns;
+    };
+
+    void            end_block();
+    void            update_status();
+    double          seconds_since(LONGLONG began) const;
+
+    static const uint32 c_max_slowest = 10;
+
+    LARGE_INTEGER   m_freq;
+    LONGLONG        m_run_began = 0;
+    LONGLONG        m_block_began = 0;
+    LONGLONG        m_last_status = 0;
+    double          m_elapsed = 0;
+    uint32          m_expected = 0;
+    uint32          m_measured = 0;
+    latency_histogram m_steps[uint32(verify_step::count)];
+    latency_histogram m_measurements;
+    std::vector<block_timing> m_blocks;
+    slow_measurement m_slowest[c_max_slowest];
+    uint32          m_slowest_count = 0;
+    char            m_title[256];
+    bool            m_has_title = false;
+};
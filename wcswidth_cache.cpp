@@ -0,0 +1,190 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcswidth_cache.h"
+
+// Each slot has room for a key this long; longer strings bypass the cache.
+static const uint32 c_max_key_len = 128;
+static const uint32 c_max_probe = 8;
+
+//------------------------------------------------------------------------------
+// Hashes 8 bytes at a time.  This only needs to spread typical short strings
+// well; the keys are compared exactly, so collisions only cost a probe.
+static uint64 hash_bytes(const char* s, uint32 len)
+{
+    const uint64 c_mul = 0x9e3779b97f4a7c15ull;
+    uint64 h = len * c_mul;
+
+    while (len >= 8)
+    {
+        uint64 v;
+        memcpy(&v, s, 8);
+        h = (h ^ v) * c_mul;
+        h ^= h >> 29;
+        s += 8;
+        len -= 8;
+    }
+
+    if (len)
+    {
+        uint64 v = 0;
+        memcpy(&v, s, len);
+        h = (h ^ v) * c_mul;
+        h ^= h >> 29;
+    }
+
+    return h ^ (h >> 32);
+}
+
+//------------------------------------------------------------------------------
+wcswidth_cache::wcswidth_cache(uint32 capacity, bool shared)
+: m_shared(shared)
+{
+    uint32 size = 16;
+    while (size < capacity)
+        size <<= 1;
+
+    m_slots.resize(size);
+    m_keys.resize(size_t(size) * c_max_key_len);
+    m_mask = size - 1;
+    clear();
+}
+
+//------------------------------------------------------------------------------
+void wcswidth_cache::clear()
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_shared)
+        lock.lock();
+
+    memset(m_slots.data(), 0, m_slots.size() * sizeof(m_slots[0]));
+    m_stats = wcswidth_cache_stats();
+}
+
+//------------------------------------------------------------------------------
+wcswidth_cache_stats wcswidth_cache::stats() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_shared)
+        lock.lock();
+
+    return m_stats;
+}
+
+//------------------------------------------------------------------------------
+uint32 wcswidth_cache::wcswidth(const char* s, uint32 len)
+{
+    // Skip the hash for strings that can't be cached anyway.
+    if (len > c_max_key_len)
+    {
+        const uint32 width = ::wcswidth(s, len);
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        if (m_shared)
+            lock.lock();
+        ++m_stats.bypassed;
+        return width;
+    }
+
+    const uint64 hash = hash_bytes(s, len);
+
+    // The generation is read before computing the width, so that if the
+    // modes change meanwhile the entry is already stale instead of being
+    // wrong.
+    const uint32 generation = get_wcwidth_generation();
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_shared)
+        lock.lock();
+
+    uint32 width;
+    if (find(hash, s, len, generation, width))
+    {
+        ++m_stats.hits;
+        return width;
+    }
+    ++m_stats.misses;
+
+    // Other threads can use the cache while this one measures.
+    if (m_shared)
+        lock.unlock();
+    width = ::wcswidth(s, len);
+    if (m_shared)
+        lock.lock();
+
+    insert(hash, s, len, generation, width);
+    return width;
+}
+
+//------------------------------------------------------------------------------
+bool wcswidth_cache::find(uint64 hash, const char* s, uint32 len, uint32 generation, uint32& width)
+{
+    // Entries are never removed, so the probe stops at an empty slot.
+    const uint32 home = uint32(hash) & m_mask;
+    for (uint32 i = 0; i < c_max_probe; ++i)
+    {
+        const uint32 index = (home + i) & m_mask;
+        const slot& entry = m_slots[index];
+        if (!entry.generation)
+            break;
+        if (entry.generation == generation && entry.hash == hash && entry.len == len &&
+            memcmp(&m_keys[size_t(index) * c_max_key_len], s, len) == 0)
+        {
+            width = entry.width;
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void wcswidth_cache::insert(uint64 hash, const char* s, uint32 len, uint32 generation, uint32 width)
+{
+    // The first stale or empty slot in the probe window is reused, unless
+    // another thread inserted the same key meanwhile.  When the window is
+    // full, the entry in the home slot is replaced.
+    const uint32 home = uint32(hash) & m_mask;
+    uint32 target = home;
+    bool have_target = false;
+    for (uint32 i = 0; i < c_max_probe; ++i)
+    {
+        const uint32 index = (home + i) & m_mask;
+        const slot& entry = m_slots[index];
+        if (entry.generation != generation)
+        {
+            if (!have_target)
+            {
+                target = index;
+                have_target = true;
+            }
+            if (!entry.generation)
+                break;
+            continue;
+        }
+
+        if (entry.hash == hash && entry.len == len &&
+            memcmp(&m_keys[size_t(index) * c_max_key_len], s, len) == 0)
+            return;
+    }
+
+    slot& entry = m_slots[target];
+    entry.hash = hash;
+    entry.generation = generation;
+    entry.len = len;
+    entry.width = width;
+    memcpy(&m_keys[size_t(target) * c_max_key_len], s, len);
+}
+
+//------------------------------------------------------------------------------
+wcswidth_cache& get_thread_wcswidth_cache()
+{
+    static thread_local wcswidth_cache s_cache(1024, false);
+    return s_cache;
+}
+
+//------------------------------------------------------------------------------
+uint32 cached_wcswidth(const char* s, uint32 len)
+{
+    return get_thread_wcswidth_cache().wcswidth(s, len);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <mutex>
+
+//------------------------------------------------------------------------------
+struct wcswidth_cache_stats
+{
+    uint64          hits = 0;
+    uint64          misses = 0;
+    uint64          bypassed = 0;           // Strings too long to cache.
+};
+
+//------------------------------------------------------------------------------
+// A bounded cache in front of wcswidth(), for callers that measure the same
+// strings over and over (such as prompt segments that are redrawn many times
+// per second).
+//
+// It's an open-addressing table with a short linear probe, keyed by a hash of
+// the string bytes.  Each entry remembers the wcwidth generation it was
+// computed in, so entries become stale automatically when initialize_wcwidth()
+// changes the modes or a different profile is activated.  When the probe
+// window is full, the entry in the home slot is replaced.
+//
+// A shared cache can be used from any thread and serializes access with a
+// mutex, which isn't held while measuring a miss.  An unshared cache must only
+// be used by one thread, and has no locking at all; get_thread_wcswidth_cache()
+// returns one per thread.
+class wcswidth_cache
+{
+public:
+    explicit        wcswidth_cache(uint32 capacity=1024, bool shared=true);
+    uint32          wcswidth(const char* s, uint32 len);
+    void            clear();
+    wcswidth_cache_stats stats() const;
+
+private:
+                    wcswidth_cache(const wcswidth_cache&) = delete;
+    wcswidth_cache& operator=(const wcswidth_cache&) = delete;
+
+    struct slot
+    {
+        uint64      hash;
+        uint32      generation;             // 0 means the slot is empty.
+        uint32      len;
+        uint32      width;
+    };
+
+    bool            find(uint64 hash, const char* s, uint32 len, uint32 generation, uint32& width);
+    void            insert(uint64 hash, const char* s, uint32 len, uint32 generation, uint32 width);
+
+    std::vector<slot> m_slots;
+    std::vector<char> m_keys;
+    uint32          m_mask;
+    const bool      m_shared;
+    mutable std::mutex m_mutex;
+    wcswidth_cache_stats m_stats;
+};
+
+//------------------------------------------------------------------------------
+// Returns the calling thread's unshared cache.
+wcswidth_cache& get_thread_wcswidth_cache();
+
+// Same as wcswidth(), but uses the calling thread's cache.
+uint32 cached_wcswidth(const char* s, uint32 len);
@@ -0,0 +1,95 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "parallel.h"
+
+// Smaller strings aren't worth the cost of starting threads.
+static const uint32 c_min_chunk_len = 256 * 1024;
+static const uint32 c_chunks_per_thread = 4;
+// How far past a nominal split point to look for a safe cluster boundary.
+// If there is none, the chunk is merged with the next one.
+static const uint32 c_max_resync_len = 4096;
+
+//------------------------------------------------------------------------------
+struct chunk_width
+{
+    const char*     begin;
+    const char*     end;
+    uint32          width;
+    bool            terminated;
+};
+
+//------------------------------------------------------------------------------
+// The first decoded NUL ends the string (including a stray continuation byte
+// that decodes to 0), so a chunk also reports whether it stopped early; only
+// the chunks up to and including the first one that stopped count.
+static void measure_chunk(chunk_width& chunk, const wcwidth_profile* profile)
+{
+    uint32 width = 0;
+    wcwidth_iter iter(chunk.begin, int32(chunk.end - chunk.begin), profile);
+    while (iter.next())
+        width += iter.character_wcwidth_onectrl();
+
+    chunk.width = width;
+    chunk.terminated = (iter.get_pointer() < chunk.end);
+}
+
+//------------------------------------------------------------------------------
+uint32 wcswidth_parallel(const char* s, uint32 len, const wcwidth_profile* profile)
+{
+    const uint32 num_threads = max<uint32>(std::thread::hardware_concurrency(), 1);
+    if (num_threads == 1 || len < 2 * c_min_chunk_len)
+        return wcswidth(s, len, profile);
+
+    return wcswidth_chunked(s, len, min<uint32>(num_threads * c_chunks_per_thread, len / c_min_chunk_len), profile);
+}
+
+//------------------------------------------------------------------------------
+uint32 wcswidth_chunked(const char* s, uint32 len, uint32 num_chunks, const wcwidth_profile* profile)
+{
+    num_chunks = min(max<uint32>(num_chunks, 1), max<uint32>(len, 1));
+
+    // Keep the profile alive until every worker thread is done with it.
+    wcwidth_reader_scope reader;
+    if (!profile)
+        profile = get_wcwidth_profile();
+
+    // Move each nominal split point forward to a safe cluster boundary, so
+    // that no cluster spans two chunks.
+    const char* const end = s + len;
+    const uint32 nominal_len = len / num_chunks;
+
+    std::vector<chunk_width> chunks;
+    const char* begin = s;
+    for (uint32 i = 1; i < num_chunks; ++i)
+    {
+        const char* split = max(s + size_t(i) * nominal_len, begin + 1);
+        const char* const limit = min(split + c_max_resync_len, end);
+        while (split < limit && !is_safe_cluster_boundary(s, split, end, *profile))
+            ++split;
+        if (split >= limit)
+            continue;
+
+        chunks.push_back({ begin, split });
+        begin = split;
+    }
+    chunks.push_back({ begin, end });
+
+    parallel_chunks(uint32(chunks.size()), 1, [&](uint32 first, uint32 last)
+    {
+        for (uint32 i = first; i < last; ++i)
+            measure_chunk(chunks[i], profile);
+    });
+
+    uint32 width = 0;
+    for (const auto& chunk : chunks)
+    {
+        width += chunk.width;
+        if (chunk.terminated)
+            break;
+    }
+    return width;
+}
@@ -5,7 +5,14 @@
 
 #include "str_iter.h"
 
+struct wcwidth_profile;
+struct wcwidth_reader_slot;
+
 //------------------------------------------------------------------------------
+// Returns the width of one codepoint in the active profile.  Each call opens
+// a reader scope (see wcwidth_reader_scope), which costs a memory fence unless
+// the thread already has one open.  To measure a string, use wcswidth() or
+// wcwidth_iter, which open one scope for the whole string.
 typedef int32 wcwidth_t (char32_t);
 extern wcwidth_t *wcwidth;
 
@@ -13,15 +20,38 @@ struct wcwidth_modes
 {
     int32 color_emoji = 0;          // 0=no change, 1=force true, -1=force false
     int32 only_ucs2 = 0;            // 0=no change, 1=force true, -1=force false
+    int32 emoji_version = 0;        // 0=no change, else major * 10 + minor
 };
 
 // The first call to this automatically detects the modes.  But the modes can
 // be overridden by passing in a wcwidth_modes struct.  Any fields that are 0
 // have no effect, but any non-zero field forcibly override the corresponding
 // mode (1 forces the mode true, and -1 forces the mode false).
+//
+// The emoji version selects which characters are color emoji; it starts as
+// the newest version, and an unsupported version selects the newest supported
+// version that isn't newer (or the oldest supported version).
 void initialize_wcwidth(const wcwidth_modes* modes=nullptr);
+
+// These report the active profile (see activate_wcwidth_profile()), which
+// might not be the built-in profile for the modes.  A loaded profile's tables
+// already cover codepoints outside the BMP, so it never reports only_ucs2, and
+// it reports the newest emoji version.
 bool get_color_emoji();
 bool get_only_ucs2();
+uint32 get_emoji_version();
+
+// Returns the supported emoji versions, newest first, as major * 10 + minor
+// (such as 140 for 14.0).
+const uint32* get_emoji_versions(uint32& count);
+
+// Parses "major.minor" or "major" into version.  Returns false if the text
+// isn't a supported emoji version.
+bool parse_emoji_version(const char* text, uint32& version);
+
+// Returns a number that changes whenever initialize_wcwidth() changes the
+// modes, so that callers can tell when cached widths are stale.
+uint32 get_wcwidth_generation();
 
 bool is_combining(char32_t ucs);
 bool is_east_asian_ambiguous(char32_t ucs);
@@ -42,15 +72,53 @@ private:
 };
 
 //------------------------------------------------------------------------------
-uint32 wcswidth(const char* s, uint32 len);
+// The active profile can be swapped at any time by another thread.  While a
+// reader scope exists on a thread, any profile the thread obtained from
+// get_wcwidth_profile() stays valid, even if it's deactivated and unloaded.
+// Reader scopes are lock-free, can nest, and must be destroyed on the thread
+// that created them, so they can't be copied.  wcswidth() and wcwidth_iter use
+// one automatically.
+class wcwidth_reader_scope
+{
+public:
+                    wcwidth_reader_scope();
+                    wcwidth_reader_scope(const wcwidth_reader_scope&) = delete;
+                    ~wcwidth_reader_scope();
+    wcwidth_reader_scope& operator=(const wcwidth_reader_scope&) = delete;
+private:
+    wcwidth_reader_slot* const m_slot;
+};
+
+//------------------------------------------------------------------------------
+// When profile is nullptr, the active profile is used.
+uint32 wcswidth(const char* s, uint32 len, const wcwidth_profile* profile=nullptr);
+
+// Same result as wcswidth(), but large strings are split into chunks which
+// are measured on multiple threads.
+uint32 wcswidth_parallel(const char* s, uint32 len, const wcwidth_profile* profile=nullptr);
+
+// Same as wcswidth_parallel(), but always splits s into about num_chunks
+// chunks, however short it is.  This is for testing the splitting.
+uint32 wcswidth_chunked(const char* s, uint32 len, uint32 num_chunks, const wcwidth_profile* profile=nullptr);
+
+// Returns true if a cluster begins at p no matter what precedes it:  p must
+// begin a UTF-8 sequence, and the codepoint there must not be able to join a
+// preceding cluster.  This is conservative and can return false at some
+// cluster boundaries.  Bytes before s and at or after end are never read.
+bool is_safe_cluster_boundary(const char* s, const char* p, const char* end, const wcwidth_profile& profile);
+
+// Returns the width of s if it exactly matches one of the known emoji form
+// sequences, otherwise returns -1.
+int32 known_sequence_width(const char* s, uint32 len);
 
 //------------------------------------------------------------------------------
 class wcwidth_iter
 {
 public:
-    explicit        wcwidth_iter(const char* s, int32 len=-1);
+    explicit        wcwidth_iter(const char* s, int32 len=-1, const wcwidth_profile* profile=nullptr);
                     wcwidth_iter(const wcwidth_iter& i);
     char32_t        next();
+    char32_t        prev();
     void            unnext();
     const char*     character_pointer() const { return m_chr_ptr; }
     uint32          character_length() const { return uint32(m_chr_end - m_chr_ptr); }
@@ -65,10 +133,17 @@ public:
     uint32          length() const;
 
 private:
-    void            consume_emoji_sequence();
+    // For collect_cluster() and consume_emoji_sequence().
+    char32_t        peek() const { return m_next; }
+    void            advance();
+    template <class S, class P> friend constexpr int32 collect_cluster(S& s, const P& p, char32_t c, bool& emoji);
+    template <class S, class P> friend constexpr int32 consume_emoji_sequence(S& s, const P& p, int32 width);
 
 private:
     str_iter        m_iter;
+    const char*     m_begin;
+    wcwidth_reader_scope m_reader;
+    const wcwidth_profile* m_profile;
     char32_t        m_next;
     const char*     m_chr_ptr;
     const char*     m_chr_end;
@@ -0,0 +1,149 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "wcwidth_profile.h"
+
+//------------------------------------------------------------------------------
+// The rules for collecting a cluster, shared by wcwidth_iter at runtime and
+// by wcswidth_literal() at compile time, so that both always agree.
+//
+// A scanner has peek(), which returns the next codepoint (0 at the end), and
+// advance(), which consumes it.  A profile has color_emoji and
+// combining_mark_width, and width() and flags() like wcwidth_profile.
+
+//------------------------------------------------------------------------------
+// Consumes variant selectors, and zero width joiners followed by emoji.
+// Returns the width of the emoji sequence.
+template <class Scanner, class Profile>
+constexpr int32 consume_emoji_sequence(Scanner& s, const Profile& p, int32 width)
+{
+    while (const char32_t next = s.peek())
+    {
+        if (p.flags(next, wcwp_variant_selector))
+        {
+            s.advance();
+            // Variant selector implies full width emoji (2 cells).
+            assert(width >= 0 && width <= 2);
+            width = max<int32>(width, 2);
+        }
+        else if (next == 0x200d)
+        {
+            s.advance();
+            // ZWJ implies full width emoji (2 cells).
+            assert(width == 1 || width == 2);
+            width = max<int32>(width, 2);
+            // Stop parsing if the next character is not an emoji.
+            if (!p.flags(s.peek(), wcwp_emoji|wcwp_unqualified_half_width|wcwp_zwj_target))
+                break;
+            // Accept the next emoji, and advance to continue with the next
+            // character, to handle joiners and variants.
+            s.advance();
+        }
+        else
+            break;
+    }
+    return width;
+}
+
+//------------------------------------------------------------------------------
+// This collects the rest of a run that begins with c, which has already been
+// consumed, according to the following rules:
+//
+//  - A control character or DEL is a run by itself.
+//  - An emoji codepoint starts a run that includes the codepoint and
+//    following codepoints for certain variant selectors, or zero width joiner
+//    followed by another emoji codepoint.
+//  - Otherwise a run includes a Unicode codepoint and any following
+//    codepoints whose wcwidth is 0.
+//
+// Returns the width of the run (negative for a control character), and sets
+// emoji when the run is an emoji sequence.
+template <class Scanner, class Profile>
+constexpr int32 collect_cluster(Scanner& s, const Profile& p, char32_t c, bool& emoji)
+{
+    // The profile says what width combining marks have outside of emoji
+    // sequences.  In the Windows console subsystem, combining marks actually
+    // have a column width of 1, not 0 as the original wcwidth implementation
+    // expected.
+    const int32 cmwidth = p.combining_mark_width;
+
+    int32 width = p.width(c, cmwidth);
+    if (width < 0)
+        return width;
+
+    // Try to parse emoji sequences.
+    const bool c_color_emoji = p.color_emoji;
+    if (c_color_emoji && width)
+    {
+        const uint32 flags = p.flags(c, wcwp_regional_indicator|wcwp_emoji|wcwp_unqualified_half_width|
+                                        wcwp_variant_selector|wcwp_always_qualified);
+
+        // Check for a country flag sequence.
+        if ((flags & wcwp_regional_indicator) && p.flags(s.peek(), wcwp_regional_indicator))
+        {
+            s.advance();
+            emoji = true;
+            return 2;
+        }
+
+        // If it's an emoji character, then try to parse an emoji sequence.
+        const bool unq = !!(flags & wcwp_unqualified_half_width);
+        const bool starts_emoji = unq || (flags & wcwp_emoji);
+        if (starts_emoji || (flags & wcwp_variant_selector))
+        {
+            bool fully_qualified = !starts_emoji;
+            if (starts_emoji)
+            {
+                // A variant selector after an unqualified form makes it
+                // fully-qualified and be full width (2 cells).
+                if (unq && p.flags(s.peek(), wcwp_variant_selector))
+                {
+                    s.advance();
+                    fully_qualified = true;
+                }
+                else if (flags & wcwp_always_qualified)
+                {
+                    // Special cases:  Windows Terminal renders some
+                    // unqualified emoji the same as their fully-qualified
+                    // forms.
+                    assert(width > 0);
+                    fully_qualified = true;
+                }
+            }
+
+            if (fully_qualified)
+            {
+                assert(width == 1 || width == 2);
+                width = max<int32>(width, 2);
+            }
+
+            // Consume the emoji sequence.
+            emoji = true;
+            return consume_emoji_sequence(s, p, width);
+        }
+    }
+
+    // Collect a run until the next non-zero width character.
+    while (const char32_t next = s.peek())
+    {
+        const int32 w = p.width(next, cmwidth);
+        if (w != 0)
+        {
+            // Variant selectors affect non-emoji as well, so treat them as
+            // zero width for continuation purposes, but make the width 2.
+            if (c_color_emoji && p.flags(next, wcwp_variant_selector))
+            {
+                assert(width == 1 || width == 2);
+                width = max<int32>(width, 2);
+                emoji = true; // These essentially make it an emoji, even if the base character isn't an emoji.
+            }
+            else
+                break;
+        }
+        s.advance();
+    }
+
+    return width;
+}
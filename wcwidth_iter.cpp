@@ -3,13 +3,15 @@
 
 #include "main.h"
 #include "wcwidth.h"
+#include "wcwidth_profile.h"
+#include "wcwidth_cluster.h"
 
 //------------------------------------------------------------------------------
-uint32 wcswidth(const char* s, uint32 len)
+uint32 wcswidth(const char* s, uint32 len, const wcwidth_profile* profile)
 {
     uint32 count = 0;
 
-    wcwidth_iter iter(s, len);
+    wcwidth_iter iter(s, len, profile);
     while (iter.next())
         count += iter.character_wcwidth_onectrl();
 
@@ -17,18 +19,116 @@ uint32 wcswidth(const char* s, uint32 len)
 }
 
 
+//------------------------------------------------------------------------------
+// str_iter treats any byte after a lead byte as a continuation byte, so p
+// only begins a UTF-8 sequence if no lead byte in the preceding 3 bytes
+// reaches it.  A lead byte could itself have been consumed as a continuation
+// byte, in which case this returns false even though p begins a sequence.
+static bool is_sequence_start(const char* s, const char* p)
+{
+    for (uint32 k = 1; k <= 3 && p - k >= s; ++k)
+    {
+        const uint8 c = uint8(p[-int32(k)]);
+        const uint32 len = (c < 0xc0) ? 1 : (c < 0xe0) ? 2 : (c < 0xf0) ? 3 : 4;
+        if (len > k)
+            return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Moves p back to the beginning of the codepoint that ends at p, and sets c to
+// the codepoint.  Returns false if that isn't certain (see is_sequence_start).
+static bool prev_codepoint(const char* s, const char*& p, char32_t& c)
+{
+    for (uint32 k = 1; k <= 4 && p - k >= s; ++k)
+    {
+        if (!is_sequence_start(s, p - k))
+            continue;
+        str_iter iter(p - k, int32(k));
+        c = iter.next();
+        if (iter.get_pointer() != p)
+            return false;
+        p -= k;
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool is_safe_cluster_boundary(const char* s, const char* p, const char* end, const wcwidth_profile& profile)
+{
+    if (p <= s)
+        return true;
+    if (p >= end || !is_sequence_start(s, p))
+        return false;
+
+    // A codepoint joins the preceding cluster if it has zero width, or if it
+    // can continue an emoji sequence.  See wcwidth_iter::next() and
+    // consume_emoji_sequence().
+    str_iter iter(p, int32(end - p));
+    const char32_t c = iter.next();
+    if (profile.width(c, profile.combining_mark_width) == 0)
+        return false;
+    if (!profile.color_emoji)
+        return true;
+
+    // Variant selectors and zero width joiners always continue a sequence.
+    if (c == 0x200d || profile.flags(c, wcwp_variant_selector))
+        return false;
+
+    // Emoji only continue a sequence after a zero width joiner.  After a
+    // variant selector is treated the same way, to be conservative.
+    const uint32 flags = profile.flags(c, wcwp_regional_indicator|wcwp_emoji|wcwp_unqualified_half_width|wcwp_zwj_target);
+    if (!flags)
+        return true;
+
+    const char* q = p;
+    char32_t before;
+    if (!prev_codepoint(s, q, before))
+        return false;
+    if (before == 0x200d || profile.flags(before, wcwp_variant_selector))
+        return false;
+    if (!(flags & wcwp_regional_indicator))
+        return true;
+
+    // Regional indicators pair up from the beginning of a run of them, so
+    // this is a boundary if an even number of them come before it.  A zero
+    // width joiner before the run takes the first one only if the joiner
+    // continues an emoji sequence (after a non-emoji base it's just a zero
+    // width mark), so then this is conservatively not a boundary.
+    uint32 count = 0;
+    while (profile.flags(before, wcwp_regional_indicator))
+    {
+        ++count;
+        before = 0;
+        if (q > s && !prev_codepoint(s, q, before))
+            return false;
+    }
+    if (before == 0x200d && (flags & (wcwp_emoji|wcwp_unqualified_half_width|wcwp_zwj_target)))
+        return false;
+    return !(count & 1);
+}
+
+
 
 //------------------------------------------------------------------------------
-wcwidth_iter::wcwidth_iter(const char* s, int32 len)
+wcwidth_iter::wcwidth_iter(const char* s, int32 len, const wcwidth_profile* profile)
 : m_iter(s, len)
+, m_begin(s)
+, m_profile(profile ? profile : get_wcwidth_profile())
 {
     m_chr_ptr = m_chr_end = m_iter.get_pointer();
     m_next = m_iter.next();
 }
 
 //------------------------------------------------------------------------------
+// The copy opens its own reader scope on the current thread.  The profile
+// stays valid meanwhile because the original's scope is still open.
 wcwidth_iter::wcwidth_iter(const wcwidth_iter& i)
 : m_iter(i.m_iter)
+, m_begin(i.m_begin)
+, m_profile(i.m_profile)
 , m_next(i.m_next)
 , m_chr_ptr(i.m_chr_ptr)
 , m_chr_end(i.m_chr_end)
@@ -38,15 +138,15 @@ wcwidth_iter::wcwidth_iter(const wcwidth_iter& i)
 }
 
 //------------------------------------------------------------------------------
-// This collects a char run according to the following rules:
-//
-//  - NUL ends a run without being part of the run.
-//  - A control character or DEL is a run by itself.
-//  - An emoji codepoint starts a run that includes the codepoint and
-//    following codepoints for certain variant selectors, or zero width joiner
-//    followed by another emoji codepoint.
-//  - Otherwise a run includes a Unicode codepoint and any following
-//    codepoints whose wcwidth is 0.
+inline void wcwidth_iter::advance()
+{
+    m_chr_end = m_iter.get_pointer();
+    m_next = m_iter.next();
+}
+
+//------------------------------------------------------------------------------
+// This collects a char run (see collect_cluster()).  NUL ends a run without
+// being part of the run.
 //
 // This returns the first codepoint in the run.
 char32_t wcwidth_iter::next()
@@ -62,129 +162,58 @@ char32_t wcwidth_iter::next()
         return c;
     }
 
-    m_chr_end = m_iter.get_pointer();
-    m_next = m_iter.next();
-
-    // In the Windows console subsystem, combining marks actually have a
-    // column width of 1, not 0 as the original wcwidth implementation
-    // expected.
-    combining_mark_width_scope cmwidth(1);
+    advance();
+    m_chr_wcwidth = collect_cluster(*this, *m_profile, c, m_emoji);
+    return c;
+}
 
-    m_chr_wcwidth = wcwidth(c);
-    if (m_chr_wcwidth < 0)
-        return c;
+//------------------------------------------------------------------------------
+// This makes the cluster before the current one (or before the pointer, after
+// reset_pointer()) be the current one, and returns its first codepoint.  If
+// the pointer is inside a cluster, that cluster is the one before it.  At
+// the beginning of the string this returns 0.
+//
+// It looks back for a position where a cluster must begin (see
+// is_safe_cluster_boundary()), and then scans forward from there, so it finds
+// the same clusters and widths as next().  That's usually only one codepoint
+// back, or back to the first emoji of a sequence joined by ZWJ.
+char32_t wcwidth_iter::prev()
+{
+    const char* const pos = m_chr_ptr;
+    const char* const end = m_iter.get_pointer() + m_iter.length();
 
-    // Try to parse emoji sequences.
-    const bool c_color_emoji = get_color_emoji();
-    if (c_color_emoji && m_chr_wcwidth)
+    const char* start = pos;
+    while (start > m_begin)
     {
-        // Check for a country flag sequence.
-        if (c >= 0x1f1e6 && c <= 0x1f1ff && m_next >= 0x1f1e6 && m_next <= 0x1f1ff)
-        {
-            m_emoji = true;
-            m_chr_wcwidth = 2;
-            m_chr_end = m_iter.get_pointer();
-            m_next = m_iter.next();
-            return c;
-        }
-
-        // If it's an emoji character, then try to parse an emoji sequence.
-        const bool unq = is_possible_unqualified_half_width(c);
-        if (unq || is_emoji(c))
-        {
-            // A variant selector after an unqualified form makes it
-            // fully-qualified and be full width (2 cells).
-            if (unq && is_variant_selector(m_next))
-            {
-                m_chr_end = m_iter.get_pointer();
-                m_next = m_iter.next();
-fully_qualified:
-                assert(m_chr_wcwidth == 1 || m_chr_wcwidth == 2);
-                m_chr_wcwidth = max<char32_t>(m_chr_wcwidth, 2);
-            }
-            else if (c == 0x3030 || c == 0x303d || c == 0x3297 || c == 0x3299)
-            {
-                // Special cases:  Windows Terminal renders some unqualified
-                // emoji the same as their fully-qualified forms.
-                assert(m_chr_wcwidth > 0);
-                goto fully_qualified;
-            }
-
-            // Consume the emoji sequence.
-emoji_sequence:
-            consume_emoji_sequence();
-            m_emoji = true;
-            return c;
-        }
-        else if (is_variant_selector(c))
-        {
-            assert(m_chr_wcwidth == 1 || m_chr_wcwidth == 2);
-            m_chr_wcwidth = max<char32_t>(m_chr_wcwidth, 2);
-            goto emoji_sequence;
-        }
+        --start;
+        if (is_safe_cluster_boundary(m_begin, start, end, *m_profile))
+            break;
     }
 
-    // Collect a run until the next non-zero width character.
-    while (m_next)
+    while (start < pos)
     {
-        const int32 w = wcwidth(m_next);
-        if (w != 0)
+        wcwidth_iter iter(start, int32(end - start), m_profile);
+        while (const char32_t c = iter.next())
         {
-            // Variant selectors affect non-emoji as well, so treat them as
-            // zero width for continuation purposes, but make the width 2.
-            if (c_color_emoji && is_variant_selector(m_next))
+            if (iter.m_chr_end >= pos)
             {
-                assert(m_chr_wcwidth == 1 || m_chr_wcwidth == 2);
-                m_chr_wcwidth = max<char32_t>(m_chr_wcwidth, 2);
-                m_emoji = true; // These essentially make it an emoji, even if the base character isn't an emoji.
+                m_iter = iter.m_iter;
+                m_next = iter.m_next;
+                m_chr_ptr = iter.m_chr_ptr;
+                m_chr_end = iter.m_chr_end;
+                m_chr_wcwidth = iter.m_chr_wcwidth;
+                m_emoji = iter.m_emoji;
+                return c;
             }
-            else
-                break;
         }
-        m_chr_end = m_iter.get_pointer();
-        m_next = m_iter.next();
-    }
 
-    return c;
-}
-
-//------------------------------------------------------------------------------
-void wcwidth_iter::consume_emoji_sequence()
-{
-    // Within emoji sequences, combining marks have zero width.
-    combining_mark_width_scope cmwidth(0);
-
-    while (m_next)
-    {
-        if (is_variant_selector(m_next))
-        {
-            m_chr_end = m_iter.get_pointer();
-            m_next = m_iter.next();
-            // Variant selector implies full width emoji (2 cells).
-            assert(m_chr_wcwidth >= 0 && m_chr_wcwidth <= 2);
-            m_chr_wcwidth = max<char32_t>(m_chr_wcwidth, 2);
-        }
-        else if (m_next == 0x200d)
-        {
-            m_chr_end = m_iter.get_pointer();
-            m_next = m_iter.next();
-            // ZWJ implies full width emoji (2 cells).
-            assert(m_chr_wcwidth == 1 || m_chr_wcwidth == 2);
-            m_chr_wcwidth = max<char32_t>(m_chr_wcwidth, 2);
-            // Stop parsing if the next character is not an emoji.
-            if (!is_emoji(m_next) &&
-                !is_possible_unqualified_half_width(m_next) &&
-                m_next != 0x2640 &&                     // woman
-                m_next != 0x2642)                       // man
-                break;
-            // Accept the next emoji, and advance to continue with the next
-            // character, to handle joiners and variants.
-            m_chr_end = m_iter.get_pointer();
-            m_next = m_iter.next();
-        }
-        else
-            break;
+        // A NUL or a byte that decodes as NUL ended the scan before reaching
+        // pos, so continue scanning after it.
+        start = iter.m_chr_end + 1;
     }
+
+    reset_pointer(pos);
+    return 0;
 }
 
 //------------------------------------------------------------------------------
@@ -203,7 +232,12 @@ const char* wcwidth_iter::get_pointer() const
 //------------------------------------------------------------------------------
 void wcwidth_iter::reset_pointer(const char* s)
 {
-    m_iter.reset_pointer(s);
+    // str_iter can only move back, so moving forward starts a new one with
+    // the same end.
+    if (s <= m_iter.get_pointer())
+        m_iter.reset_pointer(s);
+    else
+        m_iter = str_iter(s, int32(m_iter.length() - (s - m_iter.get_pointer())));
     m_chr_end = m_chr_ptr = s;
     m_chr_wcwidth = 0;
     m_emoji = false;
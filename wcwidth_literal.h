@@ -0,0 +1,111 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "wcwidth_builtin.h"
+#include "wcwidth_cluster.h"
+
+//------------------------------------------------------------------------------
+// The modes of the built-in profile that a literal is measured with.  These
+// are the same modes initialize_wcwidth() detects at runtime, so a label
+// whose width differs between modes needs one constant per mode.
+struct literal_modes
+{
+    bool            color_emoji = false;
+    bool            only_ucs2 = false;
+    bool            cjk = false;
+    bool            win10 = true;
+    bool            win11 = true;
+    uint32          emoji_version = 0;      // 0 is the newest.
+};
+
+//------------------------------------------------------------------------------
+// A built-in profile for measuring literals at compile time.
+class literal_profile
+{
+public:
+    constexpr       literal_profile(const literal_modes& modes);
+    constexpr int32 width(char32_t ucs, int32 combining_mark_width) const { return builtin_width(m_builtin, ucs, combining_mark_width); }
+    constexpr uint32 flags(char32_t ucs, uint32 mask) const { return builtin_flags(m_builtin, ucs, mask); }
+
+    bool            color_emoji;
+    int8            combining_mark_width;
+
+private:
+    wcwidth_profile m_builtin = {};
+};
+
+//------------------------------------------------------------------------------
+constexpr literal_profile::literal_profile(const literal_modes& modes)
+: color_emoji(modes.color_emoji)
+, combining_mark_width(1)
+{
+    // The same as get_builtin_wcwidth_profile().
+    m_builtin.color_emoji = modes.color_emoji;
+    m_builtin.combining_mark_width = 1;
+    m_builtin.builtin_only_ucs2 = modes.only_ucs2;
+    m_builtin.builtin_cjk = modes.cjk;
+    m_builtin.builtin_win10 = modes.win10;
+    m_builtin.builtin_win11 = modes.win11;
+    m_builtin.builtin_emoji_index = uint8(emoji_version_index(modes.emoji_version));
+}
+
+//------------------------------------------------------------------------------
+// Decodes UTF-8 for collect_cluster().  The text is a string literal, so it's
+// assumed to be well formed.
+class literal_scanner
+{
+public:
+    constexpr       literal_scanner(const char8_t* s, uint32 len) : m_ptr(s), m_end(s + len) { advance(); }
+    constexpr char32_t peek() const { return m_next; }
+    constexpr void  advance();
+
+private:
+    const char8_t*  m_ptr;
+    const char8_t*  m_end;
+    char32_t        m_next = 0;
+};
+
+//------------------------------------------------------------------------------
+constexpr void literal_scanner::advance()
+{
+    if (m_ptr >= m_end)
+    {
+        m_next = 0;
+        return;
+    }
+
+    const uint8 lead = uint8(*m_ptr++);
+    const uint32 trail = (lead < 0xc0) ? 0 : (lead < 0xe0) ? 1 : (lead < 0xf0) ? 2 : 3;
+    char32_t c = char32_t(lead & (trail ? 0x3f >> trail : 0x7f));
+    for (uint32 i = 0; i < trail && m_ptr < m_end; ++i)
+        c = (c << 6) | char32_t(uint8(*m_ptr++) & 0x3f);
+    m_next = c;
+}
+
+//------------------------------------------------------------------------------
+// Returns the same width as wcswidth() with the built-in profile for the
+// modes, but at compile time, so that fixed labels and icons cost nothing to
+// measure at runtime:
+//
+//      constexpr uint32 c_label_width = wcswidth_literal(u8"│ Name");
+//
+// Like wcswidth(), control characters count as width 1, and the text ends at
+// the first NUL.
+template <size_t N>
+consteval uint32 wcswidth_literal(const char8_t (&s)[N], literal_modes modes={})
+{
+    const literal_profile profile(modes);
+    literal_scanner scanner(s, uint32(N - 1));
+
+    uint32 count = 0;
+    while (const char32_t c = scanner.peek())
+    {
+        scanner.advance();
+        bool emoji = false;
+        const int32 width = collect_cluster(scanner, profile, c, emoji);
+        count += (width < 0) ? 1 : uint32(width);
+    }
+    return count;
+}
@@ -0,0 +1,317 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "wcwidth_profile.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+//------------------------------------------------------------------------------
+// Profile files are little-endian and start with this header.  The offsets
+// are from the start of the file.
+//
+// The width table has two stages:  stage1 has one uint16 per block of 256
+// codepoints (0x1100 blocks), which is the index of a block of 256 uint16
+// entries in stage2.  Identical blocks are shared.  Each entry is a width
+// plus wcwp_* flags.
+struct profile_file_header
+{
+    char            magic[4];
+    uint32          version;
+    char            name[32];
+    uint8           color_emoji;
+    int8            combining_mark_width;
+    int8            ambiguous_width;
+    uint8           reserved;
+    uint32          stage1_offset;
+    uint32          stage2_offset;
+    uint32          stage2_blocks;
+};
+
+static const char c_profile_magic[4] = { 'W', 'C', 'W', 'P' };
+static const uint32 c_profile_version = 1;
+static const uint32 c_stage1_count = 0x110000 >> 8;
+
+//------------------------------------------------------------------------------
+// Reader scopes record the epoch they started in, in a per-thread slot.  A
+// retired profile (or other retired data) is tagged with the epoch after it
+// was deactivated, and can be reclaimed once every slot is idle (0) or started
+// in that epoch or later, because such readers can only have seen the
+// replacement.
+//
+// Slots are never freed; when a thread exits its slot becomes available for
+// reuse by another thread.
+struct wcwidth_reader_slot
+{
+    std::atomic<uint32> epoch;
+    std::atomic<bool>   in_use;
+    wcwidth_reader_slot* next;
+    uint32              depth;              // Only used by the owning thread.
+};
+
+struct retired_data
+{
+    const void*     data;
+    void            (*free)(const void* data);
+    uint32          epoch;
+};
+
+static std::atomic<uint32> s_epoch = 1;
+static std::atomic<wcwidth_reader_slot*> s_slots = nullptr;
+static std::mutex s_retired_mutex;
+static std::vector<retired_data> s_retired;
+
+//------------------------------------------------------------------------------
+static wcwidth_reader_slot* acquire_reader_slot()
+{
+    for (wcwidth_reader_slot* slot = s_slots.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        bool expected = false;
+        if (!slot->in_use.load(std::memory_order_relaxed) &&
+            slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return slot;
+    }
+
+    wcwidth_reader_slot* slot = new wcwidth_reader_slot;
+    slot->epoch.store(0, std::memory_order_relaxed);
+    slot->in_use.store(true, std::memory_order_relaxed);
+    slot->depth = 0;
+    slot->next = s_slots.load(std::memory_order_relaxed);
+    while (!s_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+    return slot;
+}
+
+//------------------------------------------------------------------------------
+class thread_reader_slot
+{
+public:
+                    ~thread_reader_slot() { if (m_slot) m_slot->in_use.store(false, std::memory_order_release); }
+    wcwidth_reader_slot* get() { if (!m_slot) m_slot = acquire_reader_slot(); return m_slot; }
+private:
+    wcwidth_reader_slot* m_slot = nullptr;
+};
+
+static thread_local thread_reader_slot t_reader_slot;
+
+//------------------------------------------------------------------------------
+static wcwidth_reader_slot* enter_reader(wcwidth_reader_slot* slot)
+{
+    if (!slot->depth++)
+    {
+        // The fence orders the epoch store before any later load of the
+        // active profile, pairing with the fence in reclaim_wcwidth_profiles.
+        slot->epoch.store(s_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return slot;
+}
+
+//------------------------------------------------------------------------------
+wcwidth_reader_scope::wcwidth_reader_scope()
+: m_slot(enter_reader(t_reader_slot.get()))
+{
+}
+
+//------------------------------------------------------------------------------
+wcwidth_reader_scope::~wcwidth_reader_scope()
+{
+    assert(m_slot->depth);
+    if (!--m_slot->depth)
+        m_slot->epoch.store(0, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+static void free_profile(const void* data)
+{
+    const wcwidth_profile* profile = static_cast<const wcwidth_profile*>(data);
+    UnmapViewOfFile(profile->view);
+    delete profile;
+}
+
+//------------------------------------------------------------------------------
+uint32 reclaim_wcwidth_profiles()
+{
+    std::lock_guard<std::mutex> lock(s_retired_mutex);
+    if (s_retired.empty())
+        return 0;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint32 oldest = s_epoch.load(std::memory_order_relaxed);
+    for (wcwidth_reader_slot* slot = s_slots.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        const uint32 epoch = slot->epoch.load(std::memory_order_acquire);
+        if (epoch && epoch < oldest)
+            oldest = epoch;
+    }
+
+    uint32 kept = 0;
+    for (const auto& retired : s_retired)
+    {
+        if (retired.epoch <= oldest)
+            retired.free(retired.data);
+        else
+            s_retired[kept++] = retired;
+    }
+    s_retired.resize(kept);
+    return kept;
+}
+
+//------------------------------------------------------------------------------
+static uint16 make_entry(const wcwidth_profile& p, char32_t ucs)
+{
+    // A codepoint whose width depends on the combining mark width is a
+    // combining mark, whatever table it came from.
+    const int32 w1 = p.width(ucs, 1);
+    const int32 w0 = p.width(ucs, 0);
+
+    uint32 e;
+    if (w0 != w1)
+        e = wcwp_combining;
+    else if (w1 < 0)
+        e = 3;
+    else
+        e = min<int32>(w1, 2);
+
+    e |= p.flags(ucs, wcwp_all_flags & ~wcwp_combining);
+    return uint16(e);
+}
+
+//------------------------------------------------------------------------------
+bool save_wcwidth_profile(const char* path, const wcwidth_profile* profile, int32 ambiguous_width)
+{
+    if (!profile)
+        profile = get_wcwidth_profile();
+
+    std::vector<uint16> stage1;
+    std::vector<uint16> stage2;
+    std::map<std::vector<uint16>, uint16> blocks;
+
+    std::vector<uint16> block(256);
+    for (uint32 i = 0; i < c_stage1_count; ++i)
+    {
+        for (uint32 j = 0; j < 256; ++j)
+            block[j] = make_entry(*profile, char32_t((i << 8) | j));
+
+        auto it = blocks.find(block);
+        if (it == blocks.end())
+        {
+            const uint16 index = uint16(blocks.size());
+            it = blocks.emplace(block, index).first;
+            stage2.insert(stage2.end(), block.begin(), block.end());
+        }
+        stage1.push_back(it->second);
+    }
+
+    profile_file_header header = {};
+    memcpy(header.magic, c_profile_magic, sizeof(header.magic));
+    header.version = c_profile_version;
+    strncpy(header.name, profile->name, sizeof(header.name) - 1);
+    header.color_emoji = profile->color_emoji;
+    header.combining_mark_width = profile->combining_mark_width;
+    header.ambiguous_width = int8(ambiguous_width);
+    header.stage1_offset = sizeof(header);
+    header.stage2_offset = header.stage1_offset + uint32(stage1.size() * sizeof(uint16));
+    header.stage2_blocks = uint32(blocks.size());
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(stage1.data(), sizeof(uint16), stage1.size(), file);
+    fwrite(stage2.data(), sizeof(uint16), stage2.size(), file);
+
+    const bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+const wcwidth_profile* load_wcwidth_profile(const char* path)
+{
+    HANDLE h = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h, &size) || size.QuadPart < LONGLONG(sizeof(profile_file_header)) || size.QuadPart > 0x10000000)
+    {
+        CloseHandle(h);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(h);
+    if (!view)
+        return nullptr;
+
+    // Validate the header and tables before using them.
+    const uint32 view_size = uint32(size.QuadPart);
+    const profile_file_header* header = static_cast<const profile_file_header*>(view);
+    bool ok = (memcmp(header->magic, c_profile_magic, sizeof(header->magic)) == 0 &&
+               header->version == c_profile_version &&
+               header->stage1_offset % sizeof(uint16) == 0 &&
+               header->stage2_offset % sizeof(uint16) == 0 &&
+               header->stage1_offset <= view_size &&
+               view_size - header->stage1_offset >= c_stage1_count * sizeof(uint16) &&
+               header->stage2_offset <= view_size &&
+               header->stage2_blocks <= (view_size - header->stage2_offset) / (256 * sizeof(uint16)) &&
+               header->combining_mark_width >= 0 && header->combining_mark_width <= 2 &&
+               header->ambiguous_width >= 0 && header->ambiguous_width <= 2);
+
+    const uint8* base = static_cast<const uint8*>(view);
+    const uint16* stage1 = reinterpret_cast<const uint16*>(base + header->stage1_offset);
+    for (uint32 i = 0; ok && i < c_stage1_count; ++i)
+        ok = (stage1[i] < header->stage2_blocks);
+
+    if (!ok)
+    {
+        UnmapViewOfFile(view);
+        return nullptr;
+    }
+
+    wcwidth_profile* profile = new wcwidth_profile {};
+    memcpy(profile->name, header->name, sizeof(profile->name));
+    profile->name[sizeof(profile->name) - 1] = '\0';
+    profile->color_emoji = !!header->color_emoji;
+    profile->combining_mark_width = header->combining_mark_width;
+    profile->ambiguous_width = header->ambiguous_width;
+    profile->stage1 = stage1;
+    profile->stage2 = reinterpret_cast<const uint16*>(base + header->stage2_offset);
+    profile->view = view;
+    profile->view_size = view_size;
+    return profile;
+}
+
+//------------------------------------------------------------------------------
+void unload_wcwidth_profile(const wcwidth_profile* profile)
+{
+    if (!profile || !profile->view)
+        return;
+
+    if (get_wcwidth_profile() == profile)
+        activate_wcwidth_profile(nullptr);
+
+    retire_wcwidth_data(profile, free_profile);
+}
+
+//------------------------------------------------------------------------------
+void retire_wcwidth_data(const void* data, void (*free)(const void* data))
+{
+    // Readers that started before this epoch may still be using the data.
+    {
+        std::lock_guard<std::mutex> lock(s_retired_mutex);
+        s_retired.push_back({ data, free, s_epoch.fetch_add(1) + 1 });
+    }
+
+    reclaim_wcwidth_profiles();
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// Each codepoint in a width profile has a width and some flags.
+enum : uint32
+{
+    wcwp_width_mask             = 0x0003,   // 0, 1, 2, or 3 for control characters (width -1).
+    wcwp_combining              = 0x0004,   // Width depends on context (combining mark policy).
+    wcwp_ambiguous              = 0x0008,   // East Asian Ambiguous (ambiguous width policy).
+    wcwp_emoji                  = 0x0010,   // Starts an emoji sequence.
+    wcwp_unqualified_half_width = 0x0020,   // Half width unless followed by a variant selector.
+    wcwp_variant_selector       = 0x0040,   // Emoji variant selector or skin tone modifier.
+    wcwp_regional_indicator     = 0x0080,   // Pairs form a country flag.
+    wcwp_zwj_target             = 0x0100,   // Can follow ZWJ even though it isn't an emoji.
+    wcwp_always_qualified       = 0x0200,   // Unqualified form is full width anyway.
+
+    wcwp_all_flags              = 0x03fc,
+};
+
+//------------------------------------------------------------------------------
+// A width profile describes how a terminal renders codepoints:  widths,
+// emoji sequence rules, and the combining mark and ambiguous width policies.
+//
+// Built-in profiles use the compiled-in tables and the same rules as
+// initialize_wcwidth().  Loaded profiles use a two-stage lookup table that is
+// memory-mapped from a profile file.
+struct wcwidth_profile
+{
+    int32           width(char32_t ucs, int32 combining_mark_width) const;
+    uint32          flags(char32_t ucs, uint32 mask) const;
+
+    char            name[32];
+    bool            color_emoji;            // Enables emoji sequence rules.
+    int8            combining_mark_width;   // Width of combining marks outside emoji sequences.
+    int8            ambiguous_width;        // 0 uses the table widths, else 1 or 2.
+
+    bool            builtin_only_ucs2;
+    bool            builtin_cjk;
+    bool            builtin_win10;
+    bool            builtin_win11;
+    uint8           builtin_emoji_index;    // Index of the emoji version, newest first.
+
+    const uint16*   stage1;                 // Indexed by ucs >> 8.
+    const uint16*   stage2;                 // Blocks of 256 entries.
+    const void*     view;
+    uint32          view_size;
+
+private:
+    uint32          entry(char32_t ucs) const;
+};
+
+//------------------------------------------------------------------------------
+// Fills in a built-in profile for the specified modes.  This is what
+// initialize_wcwidth() uses, but the profile can be used independently.
+// An emoji_version of 0 uses the newest emoji version.
+void get_builtin_wcwidth_profile(wcwidth_profile& profile, bool color_emoji, bool only_ucs2, bool cjk, uint32 emoji_version=0);
+
+// Memory-maps a profile file.  Returns nullptr on failure.  Any number of
+// profiles can be loaded at once, and each can be passed to wcswidth() or
+// wcwidth_iter independently of which profile is active.
+const wcwidth_profile* load_wcwidth_profile(const char* path);
+
+// Deactivates the profile if it's active, and frees it once no reader scope
+// can still be using it (see wcwidth_reader_scope).  Until then it waits in
+// a retired list; reclaim_wcwidth_profiles() frees what it can and returns
+// how many are still waiting.
+void unload_wcwidth_profile(const wcwidth_profile* profile);
+uint32 reclaim_wcwidth_profiles();
+
+// Retires other data that readers find while in a reader scope, such as data
+// derived from a profile.  The data must already be unreachable for new
+// readers; free is called once no reader scope can still be using it.
+void retire_wcwidth_data(const void* data, void (*free)(const void* data));
+
+// Writes a profile file that reproduces the widths and flags of a profile.
+// When ambiguous_width is 1 or 2, it overrides the width of East Asian
+// Ambiguous codepoints when the profile file is loaded.
+bool save_wcwidth_profile(const char* path, const wcwidth_profile* profile, int32 ambiguous_width=0);
+
+// Makes the profile the default for wcwidth, wcswidth(), and wcwidth_iter.
+// Passing nullptr reverts to the built-in profile for the current modes.
+// This is safe while other threads are reading; readers that already hold
+// the previous profile keep using it until their reader scopes end.
+void activate_wcwidth_profile(const wcwidth_profile* profile);
+const wcwidth_profile* get_wcwidth_profile();
+
+//------------------------------------------------------------------------------
+int32 builtin_profile_width(const wcwidth_profile& p, char32_t ucs, int32 combining_mark_width);
+uint32 builtin_profile_flags(const wcwidth_profile& p, char32_t ucs, uint32 mask);
+
+//------------------------------------------------------------------------------
+inline uint32 wcwidth_profile::entry(char32_t ucs) const
+{
+    if (ucs > 0x10ffff)
+        return 1;
+    return stage2[(uint32(stage1[ucs >> 8]) << 8) | (ucs & 0xff)];
+}
+
+//------------------------------------------------------------------------------
+inline int32 wcwidth_profile::width(char32_t ucs, int32 combining_mark_width) const
+{
+    if (!stage1)
+        return builtin_profile_width(*this, ucs, combining_mark_width);
+
+    const uint32 e = entry(ucs);
+    if (e & wcwp_combining)
+        return combining_mark_width;
+    const int32 w = int32(e & wcwp_width_mask);
+    if (w == 3)
+        return -1;
+    if ((e & wcwp_ambiguous) && ambiguous_width)
+        return ambiguous_width;
+    return w;
+}
+
+//------------------------------------------------------------------------------
+inline uint32 wcwidth_profile::flags(char32_t ucs, uint32 mask) const
+{
+    if (!stage1)
+        return builtin_profile_flags(*this, ucs, mask);
+    return entry(ucs) & mask;
+}
@@ -0,0 +1,275 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#include "main.h"
+#include "wcwidth.h"
+#include "width_diff.h"
+#include "emoji_forms.h"
+#include "column_format.h"
+#include "parallel.h"
+
+//------------------------------------------------------------------------------
+struct builtin_config
+{
+    const char*     name;
+    bool            only_ucs2;
+    bool            cjk;
+};
+
+static const builtin_config c_builtin_configs[] =
+{
+    { "mk_wcwidth",             false,  false },
+    { "mk_wcwidth_ucs2",        true,   false },
+    { "mk_wcwidth_cjk",         false,  true },
+    { "mk_wcwidth_cjk_ucs2",    true,   true },
+};
+
+//------------------------------------------------------------------------------
+width_config::~width_config()
+{
+    unload_wcwidth_profile(m_loaded);
+}
+
+//------------------------------------------------------------------------------
+bool width_config::load(const char* spec)
+{
+    assert(!m_profile && !m_is_measured);
+
+    strncpy(m_name, spec, _countof(m_name) - 1);
+
+    const char* const plus = strchr(spec, '+');
+    const size_t len = plus ? size_t(plus - spec) : strlen(spec);
+    for (const auto& builtin : c_builtin_configs)
+    {
+        if (strlen(builtin.name) == len && strncmp(builtin.name, spec, len) == 0)
+        {
+            // Optionally followed by +color, and then by an emoji version
+            // such as +e13.0.
+            const char* suffix = plus ? plus : "";
+            const bool color = (strncmp(suffix, "+color", 6) == 0);
+            if (color)
+                suffix += 6;
+            uint32 emoji_version = 0;
+            if (*suffix && (strncmp(suffix, "+e", 2) != 0 || !parse_emoji_version(suffix + 2, emoji_version)))
+                return false;
+            get_builtin_wcwidth_profile(m_builtin, color, builtin.only_ucs2, builtin.cjk, emoji_version);
+            m_profile = &m_builtin;
+            return true;
+        }
+    }
+
+    m_loaded = load_wcwidth_profile(spec);
+    if (m_loaded)
+    {
+        m_profile = m_loaded;
+        return true;
+    }
+
+    m_is_measured = m_measured.open(spec);
+    return m_is_measured;
+}
+
+//------------------------------------------------------------------------------
+void width_config::evaluate(std::vector<int8>& codepoints, std::vector<int8>& sequences) const
+{
+    uint32 count;
+    const emoji_form_sequence* const forms = get_emoji_form_sequences(count);
+    codepoints.assign(0x110000, c_unknown_width);
+    sequences.assign(count, c_unknown_width);
+
+    if (m_is_measured)
+    {
+        for (const result_record& record : m_measured.records())
+        {
+            if (!record.seq)
+            {
+                if (record.ucs < 0x110000)
+                    codepoints[record.ucs] = int8(record.actual);
+            }
+            else if (const emoji_form_sequence* form = get_emoji_form_sequence(record.seq, uint32(strlen(record.seq))))
+            {
+                sequences[form - forms] = int8(record.actual);
+            }
+        }
+        return;
+    }
+
+    assert(m_profile);
+    const wcwidth_profile* const profile = m_profile;
+
+    parallel_chunks(0x110000, 0x1000, [&](uint32 begin, uint32 end)
+    {
+        char utf8[8];
+        for (uint32 ucs = begin; ucs < end; ++ucs)
+        {
+            const uint32 len = to_utf8(char32_t(ucs), utf8);
+            codepoints[ucs] = int8(wcswidth(utf8, len, profile));
+        }
+    });
+
+    parallel_chunks(count, 0x100, [&](uint32 begin, uint32 end)
+    {
+        for (uint32 i = begin; i < end; ++i)
+            sequences[i] = int8(wcswidth(forms[i].seq, uint32(strlen(forms[i].seq)), profile));
+    });
+}
+
+//------------------------------------------------------------------------------
+static void print_width_change(FILE* out, const char* what, int8 a, int8 b)
+{
+    column_fprintf(out, "%-24s %2d -> %d", what, a, b);
+}
+
+//------------------------------------------------------------------------------
+uint32 diff_widths(const width_config& a, const width_config& b, FILE* out)
+{
+    std::vector<int8> a_codepoints, a_sequences;
+    std::vector<int8> b_codepoints, b_sequences;
+
+    // Each evaluation already uses every CPU, so run them one at a time.
+    a.evaluate(a_codepoints, a_sequences);
+    b.evaluate(b_codepoints, b_sequences);
+
+    fprintf(out, "--- %s\n+++ %s\n\n", a.name(), b.name());
+
+    uint32 ranges = 0;
+    uint32 codepoints = 0;
+    uint32 unknown_codepoints = 0;
+    for (uint32 ucs = 0; ucs < 0x110000;)
+    {
+        const int8 wa = a_codepoints[ucs];
+        const int8 wb = b_codepoints[ucs];
+        if (wa == c_unknown_width || wb == c_unknown_width)
+        {
+            ++unknown_codepoints;
+            ++ucs;
+            continue;
+        }
+        if (wa == wb)
+        {
+            ++ucs;
+            continue;
+        }
+
+        uint32 last = ucs;
+        while (last + 1 < 0x110000 && a_codepoints[last + 1] == wa && b_codepoints[last + 1] == wb)
+            ++last;
+
+        char what[32];
+        if (last == ucs)
+            sprintf(what, "%04X", ucs);
+        else
+            sprintf(what, "%04X..%04X", ucs, last);
+        print_width_change(out, what, wa, wb);
+        if (last > ucs)
+            fprintf(out, "  (%u codepoints)", last + 1 - ucs);
+        fputs("\n", out);
+
+        ++ranges;
+        codepoints += last + 1 - ucs;
+        ucs = last + 1;
+    }
+
+    uint32 count;
+    const emoji_form_sequence* const forms = get_emoji_form_sequences(count);
+
+    uint32 sequences = 0;
+    uint32 unknown_sequences = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const int8 wa = a_sequences[i];
+        const int8 wb = b_sequences[i];
+        if (wa == c_unknown_width || wb == c_unknown_width)
+        {
+            ++unknown_sequences;
+            continue;
+        }
+        if (wa == wb)
+            continue;
+
+        if (!sequences && ranges)
+            fputs("\n", out);
+
+        char what[128];
+        char* p = what;
+        str_iter iter(forms[i].seq);
+        while (iter.more() && p < what + sizeof(what) - 12)
+        {
+            if (p > what)
+                *(p++) = ' ';
+            p += sprintf(p, "%04X", iter.next());
+        }
+        print_width_change(out, what, wa, wb);
+        if (forms[i].desc && *forms[i].desc)
+            fprintf(out, "  %s", forms[i].desc);
+        fputs("\n", out);
+
+        ++sequences;
+    }
+
+    if (ranges || sequences)
+        fputs("\n", out);
+    fprintf(out, "%u codepoints differ in %u ranges; %u of %u sequences differ.\n", codepoints, ranges, sequences, count);
+    if (unknown_codepoints || unknown_sequences)
+        fprintf(out, "%u codepoints and %u sequences were not compared because their widths are unknown.\n", unknown_codepoints, unknown_sequences);
+
+    return codepoints + sequences;
+}
+
+//------------------------------------------------------------------------------
+struct os_mode
+{
+    const char*     name;
+    bool            win10;
+    bool            win11;
+};
+
+static const os_mode c_os_modes[] =
+{
+    { "win8",   false,  false },
+    { "win10",  true,   false },
+    { "win11",  true,   true },
+};
+
+//------------------------------------------------------------------------------
+static void add_combinations(std::vector<builtin_combination>& combinations, const char* spec)
+{
+    width_config config;
+    if (!config.load(spec) || !config.profile())
+    {
+        assert(false);
+        return;
+    }
+
+    for (const auto& os : c_os_modes)
+    {
+        builtin_combination combination;
+        sprintf(combination.name, "%s %s", spec, os.name);
+        combination.profile = *config.profile();
+        combination.profile.builtin_win10 = os.win10;
+        combination.profile.builtin_win11 = os.win11;
+        combinations.push_back(combination);
+    }
+}
+
+//------------------------------------------------------------------------------
+void get_builtin_combinations(std::vector<builtin_combination>& combinations)
+{
+    uint32 count;
+    const uint32* versions = get_emoji_versions(count);
+
+    char spec[64];
+    for (const auto& builtin : c_builtin_configs)
+    {
+        add_combinations(combinations, builtin.name);
+
+        // Emoji versions only matter with color emoji.
+        for (uint32 v = 0; v < count; ++v)
+        {
+            sprintf(spec, "%s+color", builtin.name);
+            if (v)
+                sprintf(spec + strlen(spec), "+e%u.%u", versions[v] / 10, versions[v] % 10);
+            add_combinations(combinations, spec);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2024 Christopher Antos
+// License: http://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "wcwidth_profile.h"
+#include "result_writer.h"
+
+//------------------------------------------------------------------------------
+// Width used for codepoints and sequences whose width is unknown (such as
+// ones a measurement database didn't measure).
+static const int8 c_unknown_width = -128;
+
+//------------------------------------------------------------------------------
+// A set of widths that can be compared:  one of the built-in wcwidth
+// functions, a profile file, or a measurement database written by
+// --format=bin (which only knows the widths that were measured).
+//
+// The built-in functions are named mk_wcwidth, mk_wcwidth_ucs2,
+// mk_wcwidth_cjk, or mk_wcwidth_cjk_ucs2, optionally followed by +color to
+// enable color emoji, and then optionally by an emoji version such as +e13.0.
+// Any other spec is the name of a profile file or a measurement database.
+class width_config
+{
+public:
+                    width_config() = default;
+                    ~width_config();
+    bool            load(const char* spec);
+    const char*     name() const { return m_name; }
+    // Returns nullptr for a measurement database.
+    const wcwidth_profile* profile() const { return m_profile; }
+
+    // Fills codepoints with the width of each codepoint 0..0x10FFFF, and
+    // sequences with the width of each known emoji form (in the order from
+    // get_emoji_form_sequences()).  The work is spread across all CPUs.
+    void            evaluate(std::vector<int8>& codepoints, std::vector<int8>& sequences) const;
+
+private:
+                    width_config(const width_config&) = delete;
+    width_config&   operator=(const width_config&) = delete;
+
+    char            m_name[MAX_PATH] = {};
+    wcwidth_profile m_builtin = {};
+    const wcwidth_profile* m_profile = nullptr;
+    const wcwidth_profile* m_loaded = nullptr;
+    result_reader   m_measured;
+    bool            m_is_measured = false;
+};
+
+//------------------------------------------------------------------------------
+// A built-in profile for one combination of the modes.
+struct builtin_combination
+{
+    char            name[64];               // Such as "mk_wcwidth+color+e13.0 win10".
+    wcwidth_profile profile;
+};
+
+// Gets every combination of the built-in modes:  each built-in function, with
+// and without color emoji, each emoji version (with color emoji), and each
+// Windows version the tables distinguish.  The Windows version is part of the
+// combination instead of being detected, so the results don't depend on the
+// OS.
+void get_builtin_combinations(std::vector<builtin_combination>& combinations);
+
+//------------------------------------------------------------------------------
+// Compares two configs over every codepoint and every known emoji form, and
+// prints the differences to out, with consecutive codepoints that changed
+// the same way coalesced into ranges.  Returns the number of differences.
+uint32 diff_widths(const width_config& a, const width_config& b, FILE* out);